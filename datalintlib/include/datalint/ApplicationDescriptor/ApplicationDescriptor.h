@@ -22,6 +22,9 @@ class ApplicationDescriptor {
   ApplicationDescriptor(const std::string& name, datalint::Version version)
       : Name_(name), Version_(version) {}
 
+  /// @brief Equality operator: same name and version.
+  bool operator==(const ApplicationDescriptor&) const = default;
+
  private:
   /// @brief The name of the application.
   std::string Name_;
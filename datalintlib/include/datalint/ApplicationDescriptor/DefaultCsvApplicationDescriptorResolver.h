@@ -1,6 +1,10 @@
 #pragma once
 
 #include <datalint/ApplicationDescriptor/IApplicationDescriptorResolver.h>
+
+#include <cstddef>
+#include <filesystem>
+
 namespace datalint {
 
 // Forward declarations
@@ -16,6 +20,23 @@ class DefaultCsvApplicationDescriptorResolver final : public IApplicationDescrip
   /// @param rawData The raw data from which to resolve the application descriptor.
   /// @return The resolved ApplicationDescriptor.
   ResolveResult Resolve(const RawData& rawData) override;
+
+  /// @brief The default number of bytes read from the start of a file by ResolveFromPrefix
+  static constexpr std::size_t kDefaultPrefixByteLimit = 64 * 1024;
+
+  /// @brief Resolve the application descriptor from the beginning of the given CSV file only,
+  /// without parsing the whole file. Growing prefixes of the file are read until both the
+  /// ApplicationName and ApplicationVersion fields have been seen or the byte limit is reached.
+  /// This lets the caller start building the specifications for the resolved version while the
+  /// full file is still being parsed. Duplicates beyond the prefix are not detected, so the result
+  /// is provisional: confirm it with Resolve on the complete raw data.
+  /// @param file The path to the CSV file.
+  /// @param maxBytes The maximum number of bytes to read from the start of the file.
+  /// @return The resolved ApplicationDescriptor, or MissingRequiredField if a field is not found
+  /// within the byte limit.
+  /// @throws std::runtime_error if the file cannot be opened.
+  ResolveResult ResolveFromPrefix(const std::filesystem::path& file,
+                                  std::size_t maxBytes = kDefaultPrefixByteLimit);
 };
 
 }  // namespace datalint
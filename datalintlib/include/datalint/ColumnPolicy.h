@@ -0,0 +1,13 @@
+#pragma once
+
+namespace datalint {
+
+/// @brief Enumeration of the columns that can be built over raw data
+enum class ColumnPolicy {
+  /// @brief Key columns only: the key table and the key id of every field. Values and locations
+  /// stay in the fields alone
+  KeysOnly,
+  /// @brief Key, value and location columns: every field is also copied into the columns
+  All
+};
+}  // namespace datalint
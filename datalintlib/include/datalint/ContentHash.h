@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace datalint {
+
+/// @brief Incremental 64-bit FNV-1a hash of a sequence of values. Unlike std::hash, the result
+/// only depends on the values added, so it is stable across runs, builds and platforms and can be
+/// stored alongside the content it describes.
+class ContentHasher {
+ public:
+  /// @brief Add an integer, as its eight little-endian bytes
+  /// @param value the integer
+  /// @return this hasher
+  ContentHasher& Add(std::uint64_t value) noexcept {
+    for (int i = 0; i < 8; ++i) {
+      AddByte(static_cast<unsigned char>(value >> (8 * i)));
+    }
+    return *this;
+  }
+
+  /// @brief Add a string, preceded by its length so that consecutive strings cannot run together
+  /// @param text the string
+  /// @return this hasher
+  ContentHasher& Add(std::string_view text) noexcept {
+    Add(static_cast<std::uint64_t>(text.size()));
+    for (const char c : text) {
+      AddByte(static_cast<unsigned char>(c));
+    }
+    return *this;
+  }
+
+  /// @brief Add an optional integer, distinguishing an absent value from every present one
+  /// @param value the optional integer
+  /// @return this hasher
+  ContentHasher& Add(const std::optional<std::size_t>& value) noexcept {
+    Add(std::uint64_t{value.has_value()});
+    return value ? Add(static_cast<std::uint64_t>(*value)) : *this;
+  }
+
+  /// @brief The hash of the values added so far
+  /// @return the hash value
+  std::uint64_t Value() const noexcept { return Hash_; }
+
+ private:
+  /// @brief Fold one byte into the hash
+  void AddByte(unsigned char byte) noexcept { Hash_ = (Hash_ ^ byte) * 0x100000001B3ull; }
+
+  /// @brief The hash of the bytes added so far, starting from the FNV offset basis
+  std::uint64_t Hash_ = 0xCBF29CE484222325ull;
+};
+}  // namespace datalint
@@ -2,6 +2,7 @@
 
 #include <datalint/Error/ErrorLog.h>
 
+#include <memory_resource>
 #include <vector>
 
 namespace datalint::error {
@@ -12,13 +13,17 @@ class ErrorCollector {
   /// @brief Default constructor
   ErrorCollector() : Logs_() {}
 
+  /// @brief Constructor: collect the error logs into the given memory resource
+  /// @param resource the memory resource backing the collected error logs
+  explicit ErrorCollector(std::pmr::memory_resource* resource) : Logs_(resource) {}
+
   /// @brief Method to add an error log
   /// @param errorLog the error log to add
   void AddErrorLog(const ErrorLog& errorLog) { Logs_.push_back(errorLog); }
 
   /// @brief Method to retrieve all error logs
   /// @return A vector of ErrorLog instances
-  const std::vector<ErrorLog>& GetErrorLogs() const { return Logs_; }
+  const std::pmr::vector<ErrorLog>& GetErrorLogs() const { return Logs_; }
 
   /// @brief Method to retrieve whether any errors have been collected
   /// @return true if there are any collected errors, false otherwise
@@ -30,7 +35,7 @@ class ErrorCollector {
 
  private:
   /// @brief The collection of error logs
-  std::vector<ErrorLog> Logs_;
+  std::pmr::vector<ErrorLog> Logs_;
 };
 
 }  // namespace datalint::error
@@ -16,7 +16,7 @@ class FileOutputErrorProcessor : public IErrorProcessor {
   /// @brief Process the incoming errors
   /// @param errors the errors
   /// @throws runtime error if something goes wrong writing to the file
-  void Process(const std::vector<datalint::error::ErrorLog>& errors) const override;
+  void Process(std::span<const datalint::error::ErrorLog> errors) const override;
 
  private:
   /// @brief The path to which we output to
@@ -2,7 +2,7 @@
 
 #include <datalint/Error/ErrorLog.h>
 
-#include <vector>
+#include <span>
 
 namespace datalint::error_processor {
 /// @brief Error processor that writes validation errors to a file
@@ -13,6 +13,6 @@ class IErrorProcessor {
 
   /// @brief Process the incoming errors
   /// @param errors the errors
-  virtual void Process(const std::vector<datalint::error::ErrorLog>& errors) const = 0;
+  virtual void Process(std::span<const datalint::error::ErrorLog> errors) const = 0;
 };
 }  // namespace datalint::error_processor
@@ -2,23 +2,31 @@
 
 #include <datalint/FieldParser/ParsedField.h>
 
+#include <memory_resource>
 #include <vector>
 
 namespace datalint::fieldparser {
 /// @brief Class to contain all fields parsed from raw data
 class ParsedData {
  public:
-  /// @brief Constructor that initializes ParsedData with a vector of ParsedField.
+  /// @brief Constructor that initializes ParsedData with a vector of ParsedField. The fields keep
+  /// using the memory resource they were allocated from.
   /// @param fields The vector of ParsedField to initialize with.
-  explicit ParsedData(std::vector<ParsedField> fields) : Fields_(std::move(fields)) {}
+  explicit ParsedData(std::pmr::vector<ParsedField> fields) : Fields_(std::move(fields)) {}
 
   /// @brief Returns a reference to the vector of parsed fields.
   /// @return A const reference to the vector of parsed fields.
-  const std::vector<ParsedField>& Fields() const noexcept { return Fields_; }
+  const std::pmr::vector<ParsedField>& Fields() const noexcept { return Fields_; }
+
+  /// @brief The memory resource backing the parsed fields.
+  /// @return The memory resource
+  std::pmr::memory_resource* Resource() const noexcept {
+    return Fields_.get_allocator().resource();
+  }
 
  private:
   /// @brief The collection of parsed fields.
-  std::vector<ParsedField> Fields_;
+  std::pmr::vector<ParsedField> Fields_;
 };
 
 }  // namespace datalint::fieldparser
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <datalint/FieldParser/RawValue.h>
+#include <datalint/SmallKey.h>
 
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -9,8 +11,8 @@ namespace datalint::fieldparser {
 /// @brief Represents a parsed field with its key and associated raw values.
 struct ParsedField {
   /// @brief The key of the parsed field.
-  std::string Key;
+  datalint::SmallKey Key;
   /// @brief The collection of raw values associated with the field.
-  std::vector<RawValue> Values;
+  std::pmr::vector<RawValue> Values;
 };
 }  // namespace datalint::fieldparser
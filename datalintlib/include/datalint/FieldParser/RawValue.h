@@ -2,13 +2,14 @@
 
 #include <datalint/SourceLocation.h>
 
+#include <memory_resource>
 #include <string>
 
 namespace datalint::fieldparser {
 /// @brief Represents a raw value read from a raw field
 struct RawValue {
   /// @brief The individual value associated to the raw field.
-  std::string Value;
+  std::pmr::string Value;
   /// @brief The source location of the value in the input file.
   SourceLocation Location;
 };
@@ -1,8 +1,13 @@
 #pragma once
 
 #include <datalint/FileParser/IFileParser.h>
+#include <datalint/KeyFilterPolicy.h>
 
+#include <cstddef>
 #include <filesystem>
+#include <functional>
+#include <memory_resource>
+#include <string_view>
 
 namespace datalint {
 // Forward declaration
@@ -14,11 +19,42 @@ namespace datalint::input {
 /// @brief Concrete implementation of IFileParser for CSV files.
 class CsvFileParser : public IFileParser {
  public:
+  /// @brief Constructor
+  /// @param resource the memory resource from which the parsed raw data is allocated, e.g. a
+  /// per-file std::pmr::monotonic_buffer_resource that is released once the file is processed
+  /// @param keyFilterPolicy the filter to build over the keys of the parsed raw data
+  explicit CsvFileParser(std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+                         KeyFilterPolicy keyFilterPolicy = KeyFilterPolicy::None)
+      : Resource_(resource), KeyFilterPolicy_(keyFilterPolicy) {}
   /// @brief Virtual destructor.
   virtual ~CsvFileParser() = default;
   /// @brief Parse the given CSV file and return the extracted RawData.
   /// @param file The path to the input file to parse.
   /// @return The parsed RawData.
   datalint::RawData Parse(const std::filesystem::path& file) override;
+  /// @brief Parse only the beginning of the given CSV file: the complete lines within its first
+  /// maxBytes bytes. A line cut off by the byte limit is dropped, so every returned field is
+  /// exactly as Parse would return it.
+  /// @param file The path to the input file to parse.
+  /// @param maxBytes The maximum number of bytes to read from the start of the file.
+  /// @return The parsed RawData of the file prefix.
+  /// @throws std::runtime_error if the file cannot be opened.
+  datalint::RawData ParsePrefix(const std::filesystem::path& file, std::size_t maxBytes);
+  /// @brief Scan the keys of the given CSV file without building raw data: each row's key is
+  /// passed to the visitor as soon as it is read, and the values are skipped. Memory use does not
+  /// grow with the file, so a layout-only check can feed a CompiledLayout scan from here.
+  /// @param file The path to the input file to scan.
+  /// @param visitor The function called with the key of each row, in order; the key is only valid
+  /// during the call.
+  /// @return The number of keys scanned.
+  /// @throws std::runtime_error if the file cannot be opened.
+  std::size_t ScanKeys(const std::filesystem::path& file,
+                       const std::function<void(std::string_view key)>& visitor);
+
+ private:
+  /// @brief The memory resource backing the parsed raw data
+  std::pmr::memory_resource* Resource_;
+  /// @brief The filter to build over the keys of the parsed raw data
+  KeyFilterPolicy KeyFilterPolicy_;
 };
 }  // namespace datalint::input
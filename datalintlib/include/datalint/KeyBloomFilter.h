@@ -0,0 +1,57 @@
+#pragma once
+
+#include <datalint/SmallKey.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace datalint {
+
+/// @brief Blocked Bloom filter over keys. Each key maps to a single 256-bit block and sets one bit
+/// in each of its eight 32-bit words, so a lookup touches one cache line. A negative answer is
+/// exact; a positive answer may be a false positive.
+class KeyBloomFilter {
+ public:
+  /// @brief Constructor: sizes the filter for the given number of keys
+  /// @param expectedKeys the number of keys that will be inserted
+  /// @param resource the memory resource backing the filter
+  explicit KeyBloomFilter(std::size_t expectedKeys,
+                          std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  /// @brief Insert a key into the filter
+  /// @param key the key to insert
+  void Insert(const SmallKey& key);
+
+  /// @brief Whether the key may have been inserted
+  /// @param key the key to look up
+  /// @return false for the key was definitely never inserted, true otherwise
+  bool MayContain(const SmallKey& key) const;
+
+  /// @brief Return the number of 256-bit blocks of the filter
+  /// @return the number of blocks
+  std::size_t BlockCount() const noexcept { return Blocks_.size(); }
+
+ private:
+  /// @brief A 256-bit block, aligned so that it never straddles a cache line
+  struct alignas(32) Block {
+    /// @brief The words of the block
+    std::array<std::uint32_t, 8> Words;
+  };
+
+  /// @brief Return the block a hash maps to
+  /// @param hash the hash of the key
+  /// @return the block index
+  std::size_t BlockIndex(std::uint64_t hash) const noexcept;
+
+  /// @brief Return the bit mask to apply to each word of a block for the given hash
+  /// @param hash the hash of the key
+  /// @return one single-bit mask per word
+  static std::array<std::uint32_t, 8> Mask(std::uint64_t hash) noexcept;
+
+  /// @brief The blocks of the filter
+  std::pmr::vector<Block> Blocks_;
+};
+}  // namespace datalint
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace datalint {
+
+/// @brief Enumeration of the filters that can be built over the keys of raw data
+enum class KeyFilterPolicy {
+  /// @brief No filter: key lookups always go to the key index
+  None,
+  /// @brief Blocked Bloom filter: lookups of absent keys are mostly rejected before touching the
+  /// key index
+  BloomFilter
+};
+}  // namespace datalint
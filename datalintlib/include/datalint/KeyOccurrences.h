@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace datalint {
+
+// Forward declaration
+struct RawField;
+
+/// @brief Where and how often a key occurs in raw data, as returned by RawData::FindKeys.
+struct KeyOccurrences {
+  /// @brief The number of fields with the key.
+  std::size_t Count = 0;
+  /// @brief The index of the first field with the key, or std::nullopt for no occurrence.
+  std::optional<std::size_t> FirstIndex;
+  /// @brief The index of the last field with the key, or std::nullopt for no occurrence.
+  std::optional<std::size_t> LastIndex;
+  /// @brief The fields with the key, in order of occurrence.
+  std::vector<const RawField*> Fields;
+};
+}  // namespace datalint
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace datalint {
+
+/// @brief Matcher of keys against a set of wildcard patterns at once, compiled into a single
+/// deterministic automaton over the bytes of the key. Bytes every pattern treats alike share an
+/// input class, so the transition table has one row per state and one column per class. Matching
+/// a key is one table step per byte, whatever the number of patterns, and gives every pattern
+/// matching the whole key.
+///
+/// Pattern syntax: a character matches itself; `?` matches any one character; `*` matches any run
+/// of characters, possibly empty; `[...]` matches one character of a class, with ranges such as
+/// `a-z`, negated by a leading `!` or `^`; `+` after a character, `?` or class matches one or more
+/// of it; `\` makes the next character literal. For example `sensor_*` or `channel_[0-9]+`.
+class KeyPatternMatcher {
+ public:
+  /// @brief The maximum number of states, beyond which compiling patterns fails. Patterns that
+  /// can match anywhere in a key multiply the states of one another: 14 patterns such as `*a*`,
+  /// `*b*`, ... exceed it, as does `*a` followed by 15 `?`
+  static constexpr std::size_t kMaxStates = 1u << 16;
+
+  /// @brief Default constructor: the matcher of no pattern
+  KeyPatternMatcher() = default;
+
+  /// @brief Constructor
+  /// @param patterns the patterns, identified by their position
+  /// @throws std::invalid_argument if a pattern is malformed, or the automaton would have more
+  /// than kMaxStates states
+  explicit KeyPatternMatcher(std::span<const std::string_view> patterns);
+
+  /// @brief Check the syntax of a pattern
+  /// @param pattern the pattern
+  /// @throws std::invalid_argument if the pattern is malformed
+  static void CheckSyntax(std::string_view pattern);
+
+  /// @brief The number of patterns
+  /// @return the number of patterns
+  std::size_t Size() const noexcept { return PatternCount_; }
+
+  /// @brief The number of states of the automaton, including the rejecting one
+  /// @return the number of states
+  std::size_t StateCount() const noexcept { return MatchOffsets_.size() - 1; }
+
+  /// @brief Match a key against every pattern
+  /// @param key the key
+  /// @return the positions of the patterns matching the whole key, in increasing order, valid as
+  /// long as the matcher
+  std::span<const std::uint32_t> Match(std::string_view key) const noexcept;
+
+ private:
+  /// @brief The input class of each byte
+  std::array<std::uint8_t, 256> ByteClasses_{};
+  /// @brief The number of input classes
+  std::size_t ClassCount_ = 1;
+  /// @brief The next state of each state and class, ClassCount_ entries per state; state 0
+  /// rejects, state 1 starts
+  std::vector<std::uint32_t> Transitions_;
+  /// @brief Where the matched patterns of each state start in Matches_, plus the end
+  std::vector<std::uint32_t> MatchOffsets_{0};
+  /// @brief The matched patterns of every state, state after state
+  std::vector<std::uint32_t> Matches_;
+  /// @brief The number of patterns
+  std::size_t PatternCount_ = 0;
+};
+}  // namespace datalint
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <datalint/KeyTable.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace datalint {
+
+// Forward declaration
+class RawDataColumns;
+
+/// @brief Index over the distinct keys of some raw data, answering "keys under prefix" queries,
+/// e.g. for flattened paths or dotted keys such as sensor.42.temp. The key ids are kept sorted by
+/// key, so the keys sharing a prefix form a contiguous range found by binary search: existence and
+/// counting are logarithmic, and enumeration is proportional to the number of matches. The index
+/// keeps its own copy of the sorted keys, so it stays valid when the raw data is moved or
+/// destroyed.
+class KeyPrefixIndex {
+ public:
+  /// @brief Constructor: builds the index from the interned keys of the given columns
+  /// @param columns the columns whose keys to index
+  /// @param resource the memory resource backing the index
+  explicit KeyPrefixIndex(const RawDataColumns& columns,
+                          std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  /// @brief Whether any key starts with the given prefix
+  /// @param prefix the prefix
+  /// @return true for at least one key starts with the prefix
+  bool HasPrefix(std::string_view prefix) const;
+
+  /// @brief Return the number of distinct keys starting with the given prefix
+  /// @param prefix the prefix
+  /// @return the number of distinct keys
+  std::size_t CountKeys(std::string_view prefix) const;
+
+  /// @brief Return the number of fields whose key starts with the given prefix
+  /// @param prefix the prefix
+  /// @return the number of fields
+  std::size_t CountFields(std::string_view prefix) const;
+
+  /// @brief Return the ids of the keys starting with the given prefix, sorted by key. The ids
+  /// refer to the key table of the indexed columns
+  /// @param prefix the prefix
+  /// @return the matching key ids
+  std::span<const KeyId> KeysWithPrefix(std::string_view prefix) const;
+
+ private:
+  /// @brief Return the range [first, last) of sorted positions whose key starts with the prefix
+  /// @param prefix the prefix
+  /// @return the first and one-past-last positions
+  std::pair<std::size_t, std::size_t> Range(std::string_view prefix) const;
+
+  /// @brief Return the key at the given sorted position
+  /// @param position the sorted position
+  /// @return the key
+  std::string_view SortedKey(std::size_t position) const {
+    return std::string_view(KeyBuffer_)
+        .substr(KeyOffsets_[position], KeyOffsets_[position + 1] - KeyOffsets_[position]);
+  }
+
+  /// @brief The key ids, sorted by key
+  std::pmr::vector<KeyId> SortedIds_;
+  /// @brief The concatenated keys, in sorted order
+  std::pmr::string KeyBuffer_;
+  /// @brief The offset of every sorted key in the key buffer, followed by the buffer size
+  std::pmr::vector<std::uint64_t> KeyOffsets_;
+  /// @brief Running total of field occurrences in sorted key order; entry i counts the fields of
+  /// the first i sorted keys
+  std::pmr::vector<std::size_t> CumulativeCounts_;
+};
+}  // namespace datalint
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <datalint/SmallKey.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace datalint {
+
+/// @brief Dense identifier of an interned key. Ids are assigned in order of first appearance,
+/// starting at 0.
+using KeyId = std::uint32_t;
+
+/// @brief Table interning the distinct keys of some raw data, so that each key can be referred to
+/// by a dense KeyId rather than by its string
+class KeyTable {
+ public:
+  /// @brief Constructor
+  /// @param resource the memory resource backing the table
+  explicit KeyTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  /// @brief Intern the given key, assigning it the next id if it was not interned yet
+  /// @param key the key to intern
+  /// @return the id of the key
+  KeyId Intern(const SmallKey& key);
+
+  /// @brief Find the id of the given key
+  /// @param key the key to look up
+  /// @return the id of the key, or std::nullopt for the key was never interned
+  std::optional<KeyId> Find(const SmallKey& key) const;
+
+  /// @brief Return the key associated to the given id
+  /// @param id the id of the key
+  /// @return the key
+  std::string_view Key(KeyId id) const { return Keys_[id].View(); }
+
+  /// @brief Return the number of distinct keys in the table
+  /// @return the number of keys
+  std::size_t Size() const noexcept { return Keys_.size(); }
+
+ private:
+  /// @brief Marker for an unused slot of the hash index
+  static constexpr KeyId kEmptySlot = static_cast<KeyId>(-1);
+
+  /// @brief Return the slot at which the given key is, or should be inserted
+  /// @param key the key to look up
+  /// @param hash the hash of the key
+  /// @return the slot index
+  std::size_t FindSlot(const SmallKey& key, std::size_t hash) const;
+
+  /// @brief Double the number of slots of the hash index and reinsert all keys
+  void Grow();
+
+  /// @brief The interned keys, indexed by KeyId
+  std::pmr::vector<SmallKey> Keys_;
+  /// @brief The hash of each interned key, indexed by KeyId
+  std::pmr::vector<std::size_t> Hashes_;
+  /// @brief Open-addressing hash index from key to KeyId (kEmptySlot for unused slots)
+  std::pmr::vector<KeyId> Slots_;
+};
+}  // namespace datalint
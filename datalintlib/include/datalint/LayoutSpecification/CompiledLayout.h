@@ -0,0 +1,209 @@
+#pragma once
+
+#include <datalint/Error/ErrorCollector.h>
+#include <datalint/KeyPatternMatcher.h>
+#include <datalint/LayoutSpecification/LayoutSpecification.h>
+#include <datalint/LayoutSpecification/OrderingGraph.h>
+#include <datalint/LayoutSpecification/UnexpectedFieldStrictness.h>
+#include <datalint/MinimalPerfectHash.h>
+#include <datalint/RawData.h>
+#include <datalint/SmallKey.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace datalint::layout {
+
+/// @brief Immutable form of a layout specification, laid out for validation. One instance can be
+/// shared between threads, each validating or scanning keys with its own workspace.
+class CompiledLayout {
+ public:
+  /// @brief Id of a key of the layout
+  using Id = std::uint32_t;
+
+  /// @brief The maximum count of a field without a maximum
+  static constexpr std::size_t kUnlimited = std::numeric_limits<std::size_t>::max();
+
+  /// @brief An ordering constraint between the fields of two ids
+  using OrderingConstraint = OrderingGraph::Edge;
+
+  /// @brief Scratch space of a validation, reused across validations to avoid allocations. A
+  /// workspace must not be used by two validations at the same time.
+  class Workspace {
+   public:
+    /// @brief The number of distinct keys no field or field pattern expects, kept by the current
+    /// scan to be reported; always 0 for a permissive scan
+    /// @return the number of distinct unexpected keys
+    std::size_t UnexpectedKeyCount() const noexcept { return UnexpectedKeys_.size(); }
+
+   private:
+    friend class CompiledLayout;
+
+    /// @brief Occurrences of one key of the layout
+    struct KeyStatistics {
+      /// @brief The number of occurrences
+      std::size_t Count;
+      /// @brief The index of the first occurrence, or the maximum for none
+      std::size_t FirstIndex;
+      /// @brief The index of the last occurrence
+      std::size_t LastIndex;
+    };
+
+    /// @brief The statistics entry of each key id of the raw data: its layout id, KeyCount() for
+    /// keys not in the layout, or an entry after it for such a key matching a field pattern
+    std::vector<Id> LayoutIds_;
+    /// @brief The occurrences of each layout id, then of the keys not in the layout, then of each
+    /// key not in the layout matching a field pattern
+    std::vector<KeyStatistics> Statistics_;
+    /// @brief The field patterns matching each key id of the raw data, when there are patterns
+    std::vector<std::span<const std::uint32_t>> PatternMatches_;
+    /// @brief The occurrences of the fields matching each field pattern
+    std::vector<std::size_t> PatternCounts_;
+    /// @brief For each layout id, one more than the last index of the present keys that must come
+    /// before it through absent keys, or 0 for none
+    std::vector<std::size_t> Bounds_;
+    /// @brief The number of keys scanned since BeginScan
+    std::size_t ScannedCount_ = 0;
+    /// @brief Whether the scan keeps the keys no field or field pattern expects
+    bool KeepsUnexpected_ = false;
+    /// @brief The distinct scanned keys no field or field pattern expects
+    std::set<std::string, std::less<>> UnexpectedKeys_;
+    /// @brief Each scanned occurrence of a key no field or field pattern expects, in order
+    std::vector<std::set<std::string, std::less<>>::const_iterator> UnexpectedOccurrences_;
+  };
+
+  /// @brief Constructor: compiles the given specification
+  /// @param specification the built layout specification
+  /// @throws std::logic_error if the ordering constraints form a cycle
+  explicit CompiledLayout(const LayoutSpecification& specification);
+
+  /// @brief The number of expected fields, whose ids are 0 to FieldCount() - 1
+  /// @return the number of expected fields
+  std::size_t FieldCount() const noexcept { return FieldCount_; }
+
+  /// @brief The number of keys, expected fields and keys only named by ordering constraints
+  /// @return the number of keys
+  std::size_t KeyCount() const noexcept { return Keys_.size(); }
+
+  /// @brief Find the id of a key
+  /// @param key the key
+  /// @return the id of the key, or std::nullopt for a key the layout does not name
+  std::optional<Id> FindKey(std::string_view key) const noexcept;
+
+  /// @brief The key of an id
+  /// @param id the id, less than KeyCount()
+  /// @return the key
+  std::string_view Key(Id id) const noexcept { return Keys_[id].View(); }
+
+  /// @brief The minimum number of occurrences of a field
+  /// @param id the id of the field, less than FieldCount()
+  /// @return the minimum number of occurrences
+  std::size_t MinCount(Id id) const noexcept { return MinCounts_[id]; }
+
+  /// @brief The maximum number of occurrences of a field
+  /// @param id the id of the field, less than FieldCount()
+  /// @return the maximum number of occurrences, or kUnlimited
+  std::size_t MaxCount(Id id) const noexcept { return MaxCounts_[id]; }
+
+  /// @brief The number of field patterns
+  /// @return the number of field patterns
+  std::size_t PatternCount() const noexcept { return Patterns_.size(); }
+
+  /// @brief The ordering constraints, in the order of the specification
+  /// @return the ordering constraints
+  std::span<const OrderingConstraint> OrderingConstraints() const noexcept {
+    return OrderingConstraints_;
+  }
+
+  /// @brief The graph of the ordering constraints
+  /// @return the ordering graph, over the ids of the keys
+  const OrderingGraph& Ordering() const noexcept { return Ordering_; }
+
+  /// @brief Validate raw data against the layout
+  /// @param rawData the raw data to validate
+  /// @param strictness whether fields the layout does not expect are errors
+  /// @param workspace the scratch space of the validation
+  /// @param errorCollector the error collector to collect validation errors
+  /// @return true if the raw data conforms to the layout, false otherwise
+  bool Validate(const datalint::RawData& rawData, UnexpectedFieldStrictness strictness,
+                Workspace& workspace, datalint::error::ErrorCollector& errorCollector) const;
+
+  /// @brief Start scanning keys one at a time into a workspace, forgetting any previous scan
+  /// @param strictness whether fields the layout does not expect are errors; only a strict scan
+  /// keeps their keys, so a permissive scan uses memory bounded by the layout, whatever the file
+  /// @param workspace the scratch space of the scan
+  void BeginScan(UnexpectedFieldStrictness strictness, Workspace& workspace) const;
+
+  /// @brief Scan the next key: update the counters and positions of the layout. In a strict scan,
+  /// keys no field or field pattern expects are also kept, to be reported.
+  /// @param key the key of the next field
+  /// @param workspace the scratch space of the scan, started by BeginScan
+  void ScanKey(std::string_view key, Workspace& workspace) const;
+
+  /// @brief Report the errors of the keys scanned since BeginScan, the same errors Validate reports
+  /// for raw data with these keys
+  /// @param strictness whether fields the layout does not expect are errors
+  /// @param workspace the scratch space of the scan
+  /// @param errorCollector the error collector to collect validation errors
+  /// @return true if the scanned keys conform to the layout, false otherwise
+  /// @throws std::invalid_argument if the strictness is strict but the scan was begun permissive,
+  /// so it did not keep the unexpected keys
+  bool ReportScan(UnexpectedFieldStrictness strictness, Workspace& workspace,
+                  datalint::error::ErrorCollector& errorCollector) const;
+
+ private:
+  /// @brief Report the count errors of the expected fields and of the field patterns
+  /// @param statistics the occurrences of each id
+  /// @param patternCounts the occurrences of the fields matching each pattern
+  /// @param errorCollector the error collector to collect validation errors
+  void ReportCounts(const std::vector<Workspace::KeyStatistics>& statistics,
+                    std::span<const std::size_t> patternCounts,
+                    datalint::error::ErrorCollector& errorCollector) const;
+
+  /// @brief Report the violated ordering constraints
+  /// @param statistics the occurrences of each id
+  /// @param bounds scratch space, one entry per id
+  /// @param errorCollector the error collector to collect validation errors
+  void ReportOrdering(const std::vector<Workspace::KeyStatistics>& statistics,
+                      std::vector<std::size_t>& bounds,
+                      datalint::error::ErrorCollector& errorCollector) const;
+
+  /// @brief Check the ordering over the reduced graph: true guarantees every constraint holds,
+  /// false means some constraint may not, an order through absent keys being checked too
+  /// @param statistics the occurrences of each id
+  /// @param bounds scratch space, one entry per id
+  /// @return true if no present key is preceded by a key it must precede
+  bool HoldsOrdering(const std::vector<Workspace::KeyStatistics>& statistics,
+                     std::vector<std::size_t>& bounds) const;
+
+  /// @brief The keys, indexed by id
+  std::vector<datalint::SmallKey> Keys_;
+  /// @brief The number of expected fields
+  std::size_t FieldCount_ = 0;
+  /// @brief The minimum count of each expected field
+  std::vector<std::size_t> MinCounts_;
+  /// @brief The maximum count of each expected field, or kUnlimited
+  std::vector<std::size_t> MaxCounts_;
+  /// @brief The field patterns, in pattern order
+  std::vector<datalint::SmallKey> Patterns_;
+  /// @brief The minimum count of the fields matching each pattern
+  std::vector<std::size_t> PatternMinCounts_;
+  /// @brief The maximum count of the fields matching each pattern, or kUnlimited
+  std::vector<std::size_t> PatternMaxCounts_;
+  /// @brief Matcher of all the field patterns
+  datalint::KeyPatternMatcher PatternMatcher_;
+  /// @brief The ordering constraints
+  std::vector<OrderingConstraint> OrderingConstraints_;
+  /// @brief The transitive reduction of the ordering constraints
+  OrderingGraph Ordering_;
+  /// @brief Perfect hash from key to id
+  datalint::MinimalPerfectHash KeyHash_;
+};
+}  // namespace datalint::layout
@@ -1,14 +1,18 @@
 #pragma once
 
+#include <datalint/SmallKey.h>
+
+#include <compare>
+#include <span>
 #include <string>
 
 namespace datalint::layout {
 /// @brief Represent a field ordering constraint between two fields
 struct FieldOrderingConstraint {
   /// @brief The key of the field that must come before
-  std::string BeforeKey;
+  datalint::SmallKey BeforeKey;
   /// @brief The key of the field that must come after
-  std::string AfterKey;
+  datalint::SmallKey AfterKey;
 
   /// @brief Equality operator for comparing constraints
   /// @param other The other constraint to compare with
@@ -16,5 +20,25 @@ struct FieldOrderingConstraint {
   bool operator==(const FieldOrderingConstraint& other) const {
     return BeforeKey == other.BeforeKey && AfterKey == other.AfterKey;
   }
+
+  /// @brief Ordering of constraints, by before key then after key
+  /// @param other The other constraint to compare with
+  /// @return the ordering of this constraint relative to the other
+  std::strong_ordering operator<=>(const FieldOrderingConstraint& other) const = default;
 };
+
+/// @brief Describe a cycle of ordering constraints, for error messages
+/// @param cycle the keys along the cycle, the first repeated at the end, as found by
+/// LayoutSpecification::FindOrderingCycle
+/// @return the keys joined by arrows, e.g. "a -> b -> a"
+inline std::string DescribeOrderingCycle(std::span<const datalint::SmallKey> cycle) {
+  std::string path;
+  for (const auto& key : cycle) {
+    if (!path.empty()) {
+      path += " -> ";
+    }
+    path += key.View();
+  }
+  return path;
+}
 }  // namespace datalint::layout
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <datalint/Error/ErrorCollector.h>
+#include <datalint/LayoutSpecification/LayoutGrammar.h>
+#include <datalint/MinimalPerfectHash.h>
+#include <datalint/RawData.h>
+#include <datalint/SmallKey.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace datalint::layout {
+
+/// @brief Deterministic finite automaton compiled from a layout grammar. The alphabet is the keys
+/// the grammar names, each with a dense id, plus one symbol for every other key; the grammar is
+/// turned into a nondeterministic automaton, then into a table of transitions by state and symbol.
+/// Validation maps each distinct key of the raw data to its symbol once, then takes one table step
+/// per field: one linear pass, without backtracking. Like CompiledLayout, the automaton is
+/// immutable and can be shared between threads each validating with its own workspace.
+class LayoutAutomaton {
+ public:
+  /// @brief Id of a state
+  using State = std::uint32_t;
+  /// @brief Id of a symbol: the id of a key of the grammar, or KeyCount() for any other key
+  using Symbol = std::uint32_t;
+
+  /// @brief The state no sequence leads out of: a sequence reaching it does not fit the grammar
+  static constexpr State kRejected = 0;
+  /// @brief The state before the first field
+  static constexpr State kStart = 1;
+  /// @brief The maximum number of states, beyond which compiling a grammar fails
+  static constexpr std::size_t kMaxStates = 1u << 16;
+  /// @brief The maximum number of states of the nondeterministic automaton built first, which
+  /// also bounds the repetition counts of a grammar
+  static constexpr std::size_t kMaxNfaStates = 1u << 20;
+
+  /// @brief Scratch space of a validation, reused across validations to avoid allocations. A
+  /// workspace must not be used by two validations at the same time.
+  class Workspace {
+   private:
+    friend class LayoutAutomaton;
+
+    /// @brief The symbol of each key id of the raw data
+    std::vector<Symbol> Symbols_;
+  };
+
+  /// @brief Constructor: compiles the given grammar
+  /// @param grammar the layout grammar
+  /// @throws std::invalid_argument if the automaton would have more than kMaxStates states, or the
+  /// nondeterministic one more than kMaxNfaStates
+  explicit LayoutAutomaton(const LayoutGrammar& grammar);
+
+  /// @brief The number of keys the grammar names, whose symbols are 0 to KeyCount() - 1
+  /// @return the number of keys
+  std::size_t KeyCount() const noexcept { return Keys_.size(); }
+
+  /// @brief The number of states, including kRejected
+  /// @return the number of states
+  std::size_t StateCount() const noexcept { return Accepting_.size(); }
+
+  /// @brief Find the symbol of a key
+  /// @param key the key
+  /// @return the symbol of the key, KeyCount() for a key the grammar does not name
+  Symbol FindSymbol(std::string_view key) const noexcept;
+
+  /// @brief The state reached from a state on a symbol
+  /// @param state the state
+  /// @param symbol the symbol, at most KeyCount()
+  /// @return the next state
+  State Next(State state, Symbol symbol) const noexcept {
+    return Transitions_[state * (Keys_.size() + 1) + symbol];
+  }
+
+  /// @brief Whether the sequence of keys leading to a state fits the grammar
+  /// @param state the state
+  /// @return true for an accepting state
+  bool IsAccepting(State state) const noexcept { return Accepting_[state] != 0; }
+
+  /// @brief Validate the sequence of keys of raw data against the grammar, reporting the first
+  /// field that does not fit, or the end of the data if it comes too early
+  /// @param rawData the raw data to validate
+  /// @param workspace the scratch space of the validation
+  /// @param errorCollector the error collector to collect validation errors
+  /// @return true if the keys of the raw data fit the grammar, false otherwise
+  bool Validate(const datalint::RawData& rawData, Workspace& workspace,
+                datalint::error::ErrorCollector& errorCollector) const;
+
+ private:
+  /// @brief Describe the keys that can follow a state
+  /// @param state the state
+  /// @return the description, for an error message
+  std::string DescribeExpected(State state) const;
+
+  /// @brief The keys the grammar names, indexed by symbol
+  std::vector<datalint::SmallKey> Keys_;
+  /// @brief Perfect hash from key to symbol
+  datalint::MinimalPerfectHash KeyHash_;
+  /// @brief The next state of each state and symbol, KeyCount() + 1 entries per state
+  std::vector<State> Transitions_;
+  /// @brief Whether each state is accepting
+  std::vector<std::uint8_t> Accepting_;
+};
+}  // namespace datalint::layout
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <datalint/SmallKey.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace datalint::layout {
+
+/// @brief Grammar of the sequence of keys of the raw data: a regular expression over keys, built
+/// from the factories below. Where ordering constraints only say that all of one field precede
+/// any of another, a grammar describes the whole arrangement: fields immediately following each
+/// other, contiguous blocks, sections of fields in any order and repeating groups. Grammars are
+/// immutable values sharing their sub-grammars; LayoutAutomaton compiles one for validation.
+///
+/// A grammar matches the whole sequence of keys, including keys it does not name: use AnyKey()
+/// where other fields may appear.
+class LayoutGrammar {
+ public:
+  /// @brief The kind of a grammar
+  enum class Kind {
+    /// @brief One occurrence of a given key
+    Key,
+    /// @brief One occurrence of any key
+    AnyKey,
+    /// @brief Each item in turn, one immediately after the other
+    Sequence,
+    /// @brief Any one of the items
+    Choice,
+    /// @brief The item repeated between a minimum and a maximum number of times
+    Repeat,
+  };
+
+  /// @brief Grammar matching one occurrence of a key
+  /// @param key the key
+  /// @return the grammar
+  static LayoutGrammar Key(datalint::SmallKey key);
+
+  /// @brief Grammar matching one occurrence of any key
+  /// @return the grammar
+  static LayoutGrammar AnyKey();
+
+  /// @brief Grammar matching the items one immediately after the other; with no item, it matches
+  /// no key
+  /// @param items the items, in order
+  /// @return the grammar
+  static LayoutGrammar Sequence(std::vector<LayoutGrammar> items);
+
+  /// @brief Grammar matching any one of the alternatives
+  /// @param alternatives the alternatives
+  /// @return the grammar
+  /// @throws std::invalid_argument if there is no alternative
+  static LayoutGrammar Choice(std::vector<LayoutGrammar> alternatives);
+
+  /// @brief Grammar matching an item repeated a number of times, e.g. a repeating group of fields
+  /// @param item the repeated item
+  /// @param minCount the minimum number of repetitions
+  /// @param maxCount the maximum number of repetitions (or std::nullopt for unlimited)
+  /// @return the grammar
+  /// @throws std::invalid_argument if the maximum is less than the minimum
+  static LayoutGrammar Repeat(LayoutGrammar item, std::size_t minCount,
+                              std::optional<std::size_t> maxCount);
+
+  /// @brief Grammar matching an item or nothing
+  /// @param item the item
+  /// @return the grammar
+  static LayoutGrammar Optional(LayoutGrammar item);
+
+  /// @brief Grammar matching a contiguous block of one or more occurrences of a key
+  /// @param key the key
+  /// @return the grammar
+  static LayoutGrammar Block(datalint::SmallKey key);
+
+  /// @brief Grammar matching a section of any number of occurrences of the given keys, in any
+  /// order; how many of each is left to the expected fields
+  /// @param keys the keys of the section
+  /// @return the grammar
+  /// @throws std::invalid_argument if there is no key
+  static LayoutGrammar AnyOrder(std::vector<datalint::SmallKey> keys);
+
+  /// @brief The kind of the grammar
+  /// @return the kind
+  Kind GetKind() const noexcept;
+
+  /// @brief The key of a Key grammar
+  /// @return the key
+  const datalint::SmallKey& MatchedKey() const noexcept;
+
+  /// @brief The items of a Sequence, the alternatives of a Choice, or the item of a Repeat
+  /// @return the sub-grammars
+  std::span<const LayoutGrammar> Items() const noexcept;
+
+  /// @brief The minimum number of repetitions of a Repeat grammar
+  /// @return the minimum
+  std::size_t MinCount() const noexcept;
+
+  /// @brief The maximum number of repetitions of a Repeat grammar
+  /// @return the maximum, or std::nullopt for unlimited
+  std::optional<std::size_t> MaxCount() const noexcept;
+
+ private:
+  // The node of a grammar, defined with the implementation
+  struct Node;
+
+  /// @brief Constructor from a node
+  /// @param node the node
+  explicit LayoutGrammar(std::shared_ptr<const Node> node);
+
+  /// @brief The node, shared by the copies of the grammar and the grammars containing it
+  std::shared_ptr<const Node> Node_;
+};
+}  // namespace datalint::layout
@@ -1,16 +1,18 @@
 #pragma once
 
 #include <datalint/LayoutSpecification/ExpectedField.h>
+#include <datalint/SmallKey.h>
 
+#include <cstddef>
 #include <functional>
-#include <string>
+#include <optional>
 #include <variant>
 
 namespace datalint::layout {
 /// @brief Struct to represent an operation used to add a field to an existing layout specification
 struct AddField {
   /// @brief The key associated to the field
-  std::string Key;
+  datalint::SmallKey Key;
   /// @brief The field to add
   ExpectedField Field;
 };
@@ -19,36 +21,102 @@ struct AddField {
 /// specification
 struct RemoveField {
   /// @brief The key associated to the field
-  std::string Key;
+  datalint::SmallKey Key;
+};
+
+/// @brief Operation to add a field pattern to a layout specification: all the fields whose key
+/// matches the pattern share its count bounds
+struct AddFieldPattern {
+  /// @brief The key pattern, in the syntax of KeyPatternMatcher
+  datalint::SmallKey Pattern;
+  /// @brief The count bounds of the matching fields
+  ExpectedField Field;
+};
+
+/// @brief Operation to remove a field pattern from a layout specification
+struct RemoveFieldPattern {
+  /// @brief The key pattern
+  datalint::SmallKey Pattern;
 };
 
 /// @brief Struct to represent an operation used to modify a field in an existing layout
-/// specification
+/// specification. The mutator is opaque, so a patch holding this operation cannot be hashed or
+/// compared; prefer the declarative SetFieldMinCount, SetFieldMaxCount and SetFieldCountBounds.
 struct ModifyField {
   /// @brief The key associated to the field
-  std::string Key;
+  datalint::SmallKey Key;
   /// @brief The mutator function to apply to the field
   std::function<void(ExpectedField&)> Mutator;
+
+  /// @brief Apply the modification to a field
+  /// @param field the field to modify
+  void ApplyTo(ExpectedField& field) const { Mutator(field); }
+};
+
+/// @brief Operation to set the minimum number of occurrences of a field in an existing layout
+/// specification
+struct SetFieldMinCount {
+  /// @brief The key associated to the field
+  datalint::SmallKey Key;
+  /// @brief The new minimum number of occurrences
+  std::size_t MinCount;
+
+  /// @brief Apply the modification to a field
+  /// @param field the field to modify
+  /// @throws std::invalid_argument if the new min count is greater than the field's max count
+  void ApplyTo(ExpectedField& field) const { field.SetMinCount(MinCount); }
+};
+
+/// @brief Operation to set the maximum number of occurrences of a field in an existing layout
+/// specification
+struct SetFieldMaxCount {
+  /// @brief The key associated to the field
+  datalint::SmallKey Key;
+  /// @brief The new maximum number of occurrences (or std::nullopt for unlimited)
+  std::optional<std::size_t> MaxCount;
+
+  /// @brief Apply the modification to a field
+  /// @param field the field to modify
+  /// @throws std::invalid_argument if the new max count is less than the field's min count
+  void ApplyTo(ExpectedField& field) const { field.SetMaxCount(MaxCount); }
+};
+
+/// @brief Operation to set both occurrence bounds of a field in an existing layout specification
+/// at once, so that moving a range past its current bounds needs no intermediate state
+struct SetFieldCountBounds {
+  /// @brief The key associated to the field
+  datalint::SmallKey Key;
+  /// @brief The new minimum number of occurrences
+  std::size_t MinCount;
+  /// @brief The new maximum number of occurrences (or std::nullopt for unlimited)
+  std::optional<std::size_t> MaxCount;
+
+  /// @brief Apply the modification to a field
+  /// @param field the field to modify
+  /// @throws std::invalid_argument if the max count is less than the min count
+  void ApplyTo(ExpectedField& field) const { field = ExpectedField(MinCount, MaxCount); }
 };
 
 /// @brief Operation to add a field ordering constraint to a layout specification
 struct AddFieldOrdering {
   /// @brief The key of the field that must come before
-  std::string BeforeKey;
+  datalint::SmallKey BeforeKey;
   /// @brief The key of the field that must come after
-  std::string AfterKey;
+  datalint::SmallKey AfterKey;
 };
 
 /// @brief Operation to remove a field ordering constraint from a layout specification
 struct RemoveFieldOrdering {
   /// @brief The key of the field that must come before
-  std::string BeforeKey;
+  datalint::SmallKey BeforeKey;
   /// @brief The key of the field that must come after
-  std::string AfterKey;
+  datalint::SmallKey AfterKey;
 };
 
 /// @brief Variant to represent any layout patch operation
 using LayoutPatchOperation =
-    std::variant<AddField, RemoveField, ModifyField, AddFieldOrdering, RemoveFieldOrdering>;
+    std::variant<AddField, RemoveField, ModifyField, SetFieldMinCount, SetFieldMaxCount,
+                 SetFieldCountBounds, AddFieldPattern, RemoveFieldPattern, AddFieldOrdering,
+                 RemoveFieldOrdering>;
 
 }  // namespace datalint::layout
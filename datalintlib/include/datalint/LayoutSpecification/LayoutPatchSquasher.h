@@ -0,0 +1,32 @@
+#pragma once
+
+#include <datalint/LayoutSpecification/LayoutPatch.h>
+#include <datalint/Version/VersionRange.h>
+
+#include <span>
+#include <string>
+
+namespace datalint::layout {
+
+/// @brief Class reducing a sequence of layout patches to a single equivalent patch, so that
+/// building a specification costs the size of the net change rather than the length of the patch
+/// history. Operations cancel or fold per key: adding then removing a field leaves nothing,
+/// modifications of a field added in the sequence are folded into the added field, successive
+/// modifications of an existing field become one operation, and ordering constraints added then
+/// removed disappear. Applying the squashed patch to a specification gives the same
+/// result as applying the patches in order, whenever the latter succeeds.
+class LayoutPatchSquasher {
+ public:
+  /// @brief Squash the given patches for a version interval
+  /// @param name the name of the squashed patch
+  /// @param interval the version interval of the squashed patch
+  /// @param patches the patches, in application order
+  /// @return a patch applying to the interval with the net effect of the patches applying to it
+  /// @throws std::invalid_argument if a patch applies to only part of the interval
+  /// @throws std::logic_error if the patches conflict among themselves, e.g. a field is added twice
+  /// or modified after being removed
+  /// @throws std::invalid_argument if a modification is invalid for bounds the patches set
+  LayoutPatch Squash(std::string name, const VersionRange& interval,
+                     std::span<const LayoutPatch> patches) const;
+};
+}  // namespace datalint::layout
@@ -1,18 +1,26 @@
 #pragma once
 
+#include <datalint/KeyPatternMatcher.h>
 #include <datalint/LayoutSpecification/ExpectedField.h>
 #include <datalint/LayoutSpecification/FieldOrderingConstraint.h>
+#include <datalint/PersistentMap.h>
+#include <datalint/PersistentSequence.h>
+#include <datalint/SmallKey.h>
 
+#include <cstdint>
 #include <functional>
-#include <map>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace datalint::layout {
 
 /// @brief Class to contain the definition for a layout specification in which we specify the data
-/// we expect to find in our input file raw data
+/// we expect to find in our input file raw data. Copies are O(1) and share storage; concurrent
+/// lookups on a specification that is no longer modified are safe. Field patterns are checked
+/// when added or removed, never during validation.
 class LayoutSpecification {
  public:
   /// @brief Default constructor for the layout specification
@@ -21,35 +29,75 @@ class LayoutSpecification {
   /// @brief Return the given expected field, if any
   /// @param key the key associated to the field
   /// @return the match
-  const std::optional<ExpectedField> GetField(const std::string& key) const;
+  const std::optional<ExpectedField> GetField(std::string_view key) const;
+
+  /// @brief Find the given expected field without copying it
+  /// @param key the key associated to the field
+  /// @return the match, valid until the specification is modified or destroyed, or nullptr
+  const ExpectedField* FindField(std::string_view key) const;
 
   /// @brief Return true for the field exists in the layout specification
   /// @param key the key associated to the field
   /// @return true for field exists
-  bool HasField(const std::string& key) const;
+  bool HasField(std::string_view key) const;
 
-  /// @brief Return the fields making up the layout specification
+  /// @brief Return the fields making up the layout specification, in key order
   /// @return the fields
-  const std::map<std::string, ExpectedField>& Fields() const;
+  const datalint::PersistentMap<datalint::SmallKey, ExpectedField>& Fields() const;
+
+  /// @brief Return the field patterns of the layout specification, in pattern order
+  /// @return the field patterns and their count bounds
+  const datalint::PersistentMap<datalint::SmallKey, ExpectedField>& FieldPatterns() const;
+
+  /// @brief Return the matcher of the field patterns, compiled when they were last modified
+  /// @return the matcher, whose pattern i is the i-th of FieldPatterns(), valid until the
+  /// specification is modified or destroyed
+  const datalint::KeyPatternMatcher& FieldPatternMatcher() const;
 
   /// @brief Return the fields making up the ordering constraints of the layout specification
   /// @return the ordering constraints
-  const std::vector<FieldOrderingConstraint>& OrderingConstraints() const;
+  const datalint::PersistentSequence<FieldOrderingConstraint>& OrderingConstraints() const;
+
+  /// @brief Stable hash of the fields, in key order, and of the ordering constraints, in order:
+  /// two specifications with the same hash validate alike, whichever patches they were built from
+  /// @return the content hash
+  std::uint64_t ContentHash() const;
 
   /// @brief Adds an expected field to the layout specification
   /// @param key the key associated to the field
   /// @param field the field to add
-  void AddExpectedField(const std::string& key, const ExpectedField& field);
+  void AddExpectedField(const datalint::SmallKey& key, const ExpectedField& field);
 
   /// @brief Modifies an expected field in the layout specification
   /// @param key the key associated to the field
   /// @param mutator the mutator function to apply to the field
-  void ModifyExpectedField(const std::string& key,
+  void ModifyExpectedField(const datalint::SmallKey& key,
                            const std::function<void(ExpectedField&)> mutator);
 
   /// @brief Removes an expected field from the layout specification
   /// @param key the key associated to the field
-  void RemoveExpectedField(const std::string& key);
+  void RemoveExpectedField(const datalint::SmallKey& key);
+
+  /// @brief Adds a field pattern to the layout specification: the occurrences of all the fields
+  /// whose key matches the pattern count toward the bounds of the field
+  /// @param pattern the key pattern
+  /// @param field the count bounds shared by the matching fields
+  /// @throws std::invalid_argument if the pattern is malformed, or if compiling it with the other
+  /// patterns would need more than KeyPatternMatcher::kMaxStates states; the specification is then
+  /// left unchanged. Patterns with a leading `*` multiply the states: 14 patterns such as `*a*`,
+  /// `*b*`, ..., or a single `*a` followed by 15 `?`, reach the limit.
+  /// @throws std::logic_error if the pattern already exists
+  void AddExpectedFieldPattern(const datalint::SmallKey& pattern, const ExpectedField& field);
+
+  /// @brief Removes a field pattern from the layout specification
+  /// @param pattern the key pattern
+  /// @throws std::logic_error if the pattern does not exist
+  void RemoveExpectedFieldPattern(const datalint::SmallKey& pattern);
+
+  /// @brief Find a cycle among the ordering constraints: no data holding all the keys of a cycle
+  /// can satisfy them
+  /// @return the keys along a cycle, the first repeated at the end, or empty for no cycle
+  std::vector<datalint::SmallKey> FindOrderingCycle() const;
 
   /// @brief Adds an ordering constraint between two fields
   /// @param constraint the ordering constraint to add
@@ -58,12 +106,37 @@ class LayoutSpecification {
   /// @brief Removes an ordering constraint between two fields
   /// @param beforeKey the key of the field that should come before
   /// @param afterKey the key of the field that should come after
-  void RemoveOrderingConstraint(const std::string& beforeKey, const std::string& afterKey);
+  void RemoveOrderingConstraint(const datalint::SmallKey& beforeKey,
+                                const datalint::SmallKey& afterKey);
 
  private:
+  // Hash index over the fields, defined with the implementation
+  struct FieldIndex;
+
+  /// @brief Return the index over the fields, building it if needed
+  /// @return the index, or nullptr for a moved-from specification
+  const FieldIndex* Index() const;
+
+  /// @brief Drop the index after a modification of the fields; copies keep theirs
+  void InvalidateIndex();
+
+  /// @brief Replace the field patterns, compiling their matcher first; copies keep theirs
+  /// @param patterns the new field patterns
+  /// @throws std::invalid_argument if the matcher would need more than
+  /// KeyPatternMatcher::kMaxStates states; the specification is then left unchanged
+  void SetFieldPatterns(datalint::PersistentMap<datalint::SmallKey, ExpectedField> patterns);
+
   /// @brief the map of all expected fields that make up the layout specification
-  std::map<std::string, ExpectedField> ExpectedFields_;
-  /// @brief the list of ordering constraints between fields
-  std::vector<FieldOrderingConstraint> OrderingConstraints_;
+  datalint::PersistentMap<datalint::SmallKey, ExpectedField> ExpectedFields_;
+  /// @brief the map of all field patterns, with the count bounds of their matching fields
+  datalint::PersistentMap<datalint::SmallKey, ExpectedField> FieldPatterns_;
+  /// @brief The matcher over FieldPatterns_, shared with the copies that have the same patterns
+  std::shared_ptr<const datalint::KeyPatternMatcher> PatternMatcher_;
+  /// @brief the list of ordering constraints between fields, in the order they were added
+  datalint::PersistentSequence<FieldOrderingConstraint> OrderingConstraints_;
+  /// @brief the same ordering constraints, sorted, to find duplicates in O(log n)
+  datalint::PersistentMap<FieldOrderingConstraint, bool> SortedOrderingConstraints_;
+  /// @brief The hash index over ExpectedFields_, shared with the copies that have the same fields
+  std::shared_ptr<FieldIndex> Index_;
 };
 }  // namespace datalint::layout
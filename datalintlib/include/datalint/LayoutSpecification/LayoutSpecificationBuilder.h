@@ -4,6 +4,7 @@
 #include <datalint/LayoutSpecification/LayoutPatch.h>
 #include <datalint/LayoutSpecification/LayoutSpecification.h>
 #include <datalint/Version/Version.h>
+#include <datalint/Version/VersionRangeIndex.h>
 
 #include <map>
 #include <optional>
@@ -20,14 +21,34 @@ class LayoutSpecificationBuilder {
   /// @param version the application version
   /// @param patches the patches to apply
   /// @return build LayoutSpecification
+  /// @throws std::logic_error if the ordering constraints of the result form a cycle
   LayoutSpecification Build(Version version, std::span<const LayoutPatch> patches) const;
 
- private:
-  /// @brief Helper function to apply a patch to the given layout specification
+  /// @brief Function to build a layout specification for the given version using an index over
+  /// the patch version ranges, visiting only the applicable patches rather than testing every patch
+  /// @param version the application version
+  /// @param patches the patches to apply
+  /// @param index the index over the version ranges of the patches, built by
+  /// VersionRangeIndex::ForPatches(patches)
+  /// @return build LayoutSpecification
+  /// @throws std::invalid_argument if the index does not cover as many ranges as there are patches
+  /// @throws std::logic_error if the ordering constraints of the result form a cycle
+  LayoutSpecification Build(Version version, std::span<const LayoutPatch> patches,
+                            const VersionRangeIndex& index) const;
+
+  /// @brief Apply a patch to the given layout specification, regardless of its version range.
+  /// Applying the patches one at a time to copies of a specification gives every intermediate
+  /// specification, all sharing their storage.
   /// @param specification the layout specification to modify
   /// @param patch the patch to apply
   void ApplyPatch(LayoutSpecification& specification, const LayoutPatch& patch) const;
 
+  /// @brief Check a specification built with ApplyPatch the way Build checks its result
+  /// @param specification the built layout specification
+  /// @throws std::logic_error if the ordering constraints form a cycle
+  void RejectOrderingCycle(const LayoutSpecification& specification) const;
+
+ private:
   /// @brief Helper function to apply an AddField operation to the given layout specification
   /// @param specification the layout specification to modify
   /// @param op the add field operation to apply
@@ -38,11 +59,36 @@ class LayoutSpecificationBuilder {
   /// @param op the modify field operation to apply
   void ApplyOperation(LayoutSpecification& specification, const ModifyField& op) const;
 
+  /// @brief Helper function to apply a SetFieldMinCount operation to the layout specification
+  /// @param specification the layout specification to modify
+  /// @param op the set min count operation to apply
+  void ApplyOperation(LayoutSpecification& specification, const SetFieldMinCount& op) const;
+
+  /// @brief Helper function to apply a SetFieldMaxCount operation to the layout specification
+  /// @param specification the layout specification to modify
+  /// @param op the set max count operation to apply
+  void ApplyOperation(LayoutSpecification& specification, const SetFieldMaxCount& op) const;
+
+  /// @brief Helper function to apply a SetFieldCountBounds operation to the layout specification
+  /// @param specification the layout specification to modify
+  /// @param op the set count bounds operation to apply
+  void ApplyOperation(LayoutSpecification& specification, const SetFieldCountBounds& op) const;
+
   /// @brief Helper function to apply a RemoveField operation to the given layout specification
   /// @param specification the layout specification to modify
   /// @param op the remove field operation to apply
   void ApplyOperation(LayoutSpecification& specification, const RemoveField& op) const;
 
+  /// @brief Helper function to apply an AddFieldPattern operation to the layout specification
+  /// @param specification the layout specification to modify
+  /// @param op the add field pattern operation to apply
+  void ApplyOperation(LayoutSpecification& specification, const AddFieldPattern& op) const;
+
+  /// @brief Helper function to apply a RemoveFieldPattern operation to the layout specification
+  /// @param specification the layout specification to modify
+  /// @param op the remove field pattern operation to apply
+  void ApplyOperation(LayoutSpecification& specification, const RemoveFieldPattern& op) const;
+
   /// @brief Helper function to apply a AddFieldOrdering operation to the layout specification
   /// @param specification the layout specification to modify
   /// @param op the add field ordering operation to apply
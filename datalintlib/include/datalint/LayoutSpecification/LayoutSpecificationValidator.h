@@ -1,10 +1,14 @@
 #pragma once
 
 #include <datalint/Error/ErrorCollector.h>
+#include <datalint/LayoutSpecification/CompiledLayout.h>
 #include <datalint/LayoutSpecification/LayoutSpecification.h>
 #include <datalint/LayoutSpecification/UnexpectedFieldStrictness.h>
 #include <datalint/RawData.h>
 
+#include <cstdint>
+#include <optional>
+
 namespace datalint::layout {
 
 /// @brief Class to validate a layout specification against raw data
@@ -18,17 +22,37 @@ class LayoutSpecificationValidator {
   /// @return the strictness level
   UnexpectedFieldStrictness Strictness() const;
 
-  /// @brief Validate the layout specification against the raw data
+  /// @brief Validate the layout specification against the raw data. The specification is compiled
+  /// into a CompiledLayout, which holds the checks, and the compiled layout is kept until a
+  /// specification with another ContentHash() is validated.
   /// @param layoutSpec The layout specification to validate against
   /// @param rawData The raw data to validate
   /// @param errorCollector The error collector to collect validation errors
   /// @return true if the raw data conforms to the layout specification, false otherwise
+  /// @throws std::logic_error if the ordering constraints of the specification form a cycle, which
+  /// a specification built by LayoutSpecificationBuilder never does
   bool Validate(const LayoutSpecification& layoutSpec, const datalint::RawData& rawData,
                 datalint::error::ErrorCollector& errorCollector);
 
+  /// @brief Validate the keys scanned into a workspace against a compiled layout, e.g. fed straight
+  /// from CsvFileParser::ScanKeys so that no raw data is built
+  /// @param layout The compiled layout the keys were scanned with
+  /// @param scan The workspace of the scan, filled by CompiledLayout::BeginScan and ScanKey
+  /// @param errorCollector The error collector to collect validation errors
+  /// @return true if the scanned keys conform to the layout, false otherwise
+  /// @throws std::invalid_argument if this validator is strict but the scan was begun permissive
+  bool Validate(const CompiledLayout& layout, CompiledLayout::Workspace& scan,
+                datalint::error::ErrorCollector& errorCollector);
+
  private:
   /// @brief The strictness level for unexpected fields
   UnexpectedFieldStrictness Strictness_;
+  /// @brief The scratch space of the validations, reused across them
+  CompiledLayout::Workspace Workspace_;
+  /// @brief The last specification validated, compiled
+  std::optional<CompiledLayout> Compiled_;
+  /// @brief The content hash of the compiled specification
+  std::uint64_t CompiledHash_ = 0;
 };
 
 }  // namespace datalint::layout
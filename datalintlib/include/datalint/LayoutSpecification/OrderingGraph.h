@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace datalint::layout {
+
+/// @brief Directed acyclic graph of the ordering constraints of a layout, over dense key ids. The
+/// graph keeps only the edges no other path implies (its transitive reduction), so a chain of n
+/// keys constrained pairwise keeps n - 1 edges, and gives each key a rank: the length of the
+/// longest chain of constraints leading to it. Nodes are listed in rank order, which is a
+/// topological order.
+class OrderingGraph {
+ public:
+  /// @brief Id of a node
+  using Id = std::uint32_t;
+
+  /// @brief An edge: the key of Before must come before the key of After
+  struct Edge {
+    /// @brief The id of the key that must come before
+    Id Before;
+    /// @brief The id of the key that must come after
+    Id After;
+  };
+
+  /// @brief Default constructor: the graph with no node
+  OrderingGraph() = default;
+
+  /// @brief Constructor, building the reduction and the ranks; duplicate edges are ignored
+  /// @param nodeCount the number of nodes, greater than every id of the edges
+  /// @param edges the edges
+  /// @throws std::invalid_argument if the edges form a cycle
+  OrderingGraph(std::size_t nodeCount, std::span<const Edge> edges);
+
+  /// @brief Find a cycle among the given edges
+  /// @param nodeCount the number of nodes, greater than every id of the edges
+  /// @param edges the edges
+  /// @return the ids along a cycle, the first repeated at the end, or empty for no cycle
+  static std::vector<Id> FindCycle(std::size_t nodeCount, std::span<const Edge> edges);
+
+  /// @brief The number of nodes
+  /// @return the number of nodes
+  std::size_t NodeCount() const noexcept { return Ranks_.size(); }
+
+  /// @brief The number of edges kept by the reduction
+  /// @return the number of edges
+  std::size_t EdgeCount() const noexcept { return Successors_.size(); }
+
+  /// @brief The nodes by increasing rank, then id
+  /// @return the nodes in topological order
+  std::span<const Id> Order() const noexcept { return Order_; }
+
+  /// @brief The rank of a node: 0 for a node no edge leads to, else one more than the largest
+  /// rank of the nodes before it
+  /// @param id the node
+  /// @return the rank
+  std::size_t Rank(Id id) const noexcept { return Ranks_[id]; }
+
+  /// @brief The nodes a node has a kept edge to, in topological order
+  /// @param id the node
+  /// @return the successors
+  std::span<const Id> Successors(Id id) const noexcept {
+    return std::span<const Id>(Successors_).subspan(Offsets_[id], Offsets_[id + 1] - Offsets_[id]);
+  }
+
+ private:
+  /// @brief The rank of each node
+  std::vector<std::size_t> Ranks_;
+  /// @brief The nodes in topological order
+  std::vector<Id> Order_;
+  /// @brief Where the successors of each node start in Successors_, plus the end
+  std::vector<std::size_t> Offsets_{0};
+  /// @brief The successors of every node, node after node
+  std::vector<Id> Successors_;
+};
+}  // namespace datalint::layout
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace datalint {
+
+/// @brief Minimal perfect hash over a fixed set of distinct keys, mapping each key of the set to
+/// its own index. Any other key maps to some index of the set too, so callers compare the key
+/// stored at that index when the key may be foreign.
+class MinimalPerfectHash {
+ public:
+  /// @brief Default constructor: the hash over no keys
+  MinimalPerfectHash() = default;
+
+  /// @brief Constructor
+  /// @param keys the distinct keys to hash
+  /// @throws std::invalid_argument if a key appears more than once
+  explicit MinimalPerfectHash(std::span<const std::string_view> keys);
+
+  /// @brief The number of keys
+  /// @return the number of keys
+  std::size_t Size() const noexcept { return KeyCount_; }
+
+  /// @brief The number of slots of the table, at least Size()
+  /// @return the number of slots
+  std::size_t SlotCount() const noexcept { return Indices_.size(); }
+
+  /// @brief Return the index of a key of the set; the set must not be empty
+  /// @param key the key
+  /// @return the position of the key in the constructor's keys, or an arbitrary index below
+  /// Size() for a key outside the set
+  std::uint32_t Index(std::string_view key) const noexcept;
+
+ private:
+  /// @brief Hash of a key under the current seed
+  std::uint64_t Hash(std::string_view key) const noexcept;
+
+  /// @brief The slot of a key of hash hash, under the given displacement
+  std::size_t Slot(std::uint64_t hash, std::uint32_t displacement) const noexcept;
+
+  /// @brief The seed of the key hash, changed until every bucket could be placed
+  std::uint64_t Seed_ = 0;
+  /// @brief The displacement of each bucket
+  std::vector<std::uint32_t> Displacements_;
+  /// @brief The number of keys
+  std::size_t KeyCount_ = 0;
+  /// @brief The index of the key of each slot; free slots hold index 0
+  std::vector<std::uint32_t> Indices_;
+};
+}  // namespace datalint
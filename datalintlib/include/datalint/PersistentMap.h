@@ -0,0 +1,289 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace datalint {
+
+/// @brief Ordered map with structural sharing: a balanced (AVL) binary tree whose nodes are never
+/// modified once built. Copying a map is O(1) and the copy shares every node with the original;
+/// an insertion or removal copies only the O(log n) nodes on the path to the changed entry. Keeping
+/// many versions of a map that differ by a few entries therefore costs roughly the size of the
+/// differences. Follows the standard container naming so it can stand in for a std::map that is
+/// only read and updated through insert_or_assign/insert/erase.
+/// @tparam Key the key type
+/// @tparam Value the mapped type
+/// @tparam Compare the key ordering; transparent comparators enable heterogeneous lookup
+template <typename Key, typename Value, typename Compare = std::less<>>
+class PersistentMap {
+ public:
+  /// @brief The type of the entries
+  using value_type = std::pair<const Key, Value>;
+
+ private:
+  /// @brief An immutable tree node
+  struct Node {
+    /// @brief The entry of the node
+    value_type Entry;
+    /// @brief The subtree of smaller keys
+    std::shared_ptr<const Node> Left;
+    /// @brief The subtree of larger keys
+    std::shared_ptr<const Node> Right;
+    /// @brief The height of the subtree rooted at this node
+    int Height;
+    /// @brief The number of entries of the subtree rooted at this node
+    std::size_t Size;
+  };
+  /// @brief Shared pointer to an immutable node
+  using NodePtr = std::shared_ptr<const Node>;
+
+ public:
+  /// @brief In-order iterator over the entries
+  class const_iterator {
+   public:
+    /// @brief Iterator category
+    using iterator_category = std::forward_iterator_tag;
+    /// @brief Value type
+    using value_type = PersistentMap::value_type;
+    /// @brief Difference type
+    using difference_type = std::ptrdiff_t;
+    /// @brief Pointer type
+    using pointer = const value_type*;
+    /// @brief Reference type
+    using reference = const value_type&;
+
+    /// @brief Default constructor: the end iterator
+    const_iterator() = default;
+
+    /// @brief Dereference
+    reference operator*() const { return Path_.back()->Entry; }
+    /// @brief Member access
+    pointer operator->() const { return &Path_.back()->Entry; }
+
+    /// @brief Advance to the next entry in key order
+    const_iterator& operator++() {
+      const Node* node = Path_.back();
+      Path_.pop_back();
+      PushLeftmost(node->Right.get());
+      return *this;
+    }
+    /// @brief Advance to the next entry in key order
+    const_iterator operator++(int) {
+      const_iterator copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    /// @brief Equality: same position
+    friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+      if (lhs.Path_.empty() || rhs.Path_.empty()) {
+        return lhs.Path_.empty() == rhs.Path_.empty();
+      }
+      return lhs.Path_.back() == rhs.Path_.back();
+    }
+
+   private:
+    friend class PersistentMap;
+
+    /// @brief Push the given node and its chain of left children
+    void PushLeftmost(const Node* node) {
+      for (; node != nullptr; node = node->Left.get()) {
+        Path_.push_back(node);
+      }
+    }
+
+    /// @brief The current node on top, below it the ancestors still to visit
+    std::vector<const Node*> Path_;
+  };
+
+  /// @brief Iterator type
+  using iterator = const_iterator;
+
+  /// @brief Default constructor: the empty map
+  PersistentMap() = default;
+
+  /// @brief The number of entries
+  /// @return the number of entries
+  std::size_t size() const noexcept { return Root_ ? Root_->Size : 0; }
+  /// @brief Whether the map has no entries
+  /// @return true for no entries
+  bool empty() const noexcept { return !Root_; }
+
+  /// @brief Iterator to the entry with the smallest key
+  const_iterator begin() const {
+    const_iterator it;
+    it.PushLeftmost(Root_.get());
+    return it;
+  }
+  /// @brief Iterator past the entry with the largest key
+  const_iterator end() const { return const_iterator(); }
+
+  /// @brief Find the entry with the given key
+  /// @param key the key, or anything comparable with keys through Compare
+  /// @return iterator to the entry, or end()
+  template <typename K>
+  const_iterator find(const K& key) const {
+    const_iterator it;
+    const Node* node = Root_.get();
+    while (node != nullptr) {
+      if (Compare{}(key, node->Entry.first)) {
+        // The node follows every entry of its left subtree
+        it.Path_.push_back(node);
+        node = node->Left.get();
+      } else if (Compare{}(node->Entry.first, key)) {
+        node = node->Right.get();
+      } else {
+        it.Path_.push_back(node);
+        return it;
+      }
+    }
+    return end();
+  }
+
+  /// @brief Whether an entry has the given key
+  /// @param key the key, or anything comparable with keys through Compare
+  /// @return true for an entry with the key exists
+  template <typename K>
+  bool contains(const K& key) const {
+    return find(key) != end();
+  }
+
+  /// @brief Insert an entry unless its key is already present
+  /// @param key the key of the entry
+  /// @param value the mapped value
+  /// @return true for inserted, false for the key already present (the map is then unchanged)
+  bool insert(const Key& key, Value value) {
+    bool changed = false;
+    Root_ = Insert(Root_, key, value, false, changed);
+    return changed;
+  }
+
+  /// @brief Insert an entry, or replace the value of the entry with the same key
+  /// @param key the key of the entry
+  /// @param value the mapped value
+  void insert_or_assign(const Key& key, Value value) {
+    bool changed = false;
+    Root_ = Insert(Root_, key, value, true, changed);
+  }
+
+  /// @brief Remove the entry with the given key, if any
+  /// @param key the key, or anything comparable with keys through Compare
+  /// @return the number of entries removed, 0 or 1
+  template <typename K>
+  std::size_t erase(const K& key) {
+    bool erased = false;
+    Root_ = Erase(Root_, key, erased);
+    return erased ? 1 : 0;
+  }
+
+  /// @brief Whether the two maps are the same tree, i.e. one is an unmodified copy of the other
+  /// @param other the other map
+  /// @return true for the maps share their root
+  bool SharesRootWith(const PersistentMap& other) const noexcept { return Root_ == other.Root_; }
+
+ private:
+  /// @brief Height of a possibly empty subtree
+  static int Height(const NodePtr& node) { return node ? node->Height : 0; }
+  /// @brief Size of a possibly empty subtree
+  static std::size_t Size(const NodePtr& node) { return node ? node->Size : 0; }
+
+  /// @brief Build a node over two subtrees whose heights differ by at most one
+  static NodePtr Make(value_type entry, NodePtr left, NodePtr right) {
+    const int height = 1 + std::max(Height(left), Height(right));
+    const std::size_t size = 1 + Size(left) + Size(right);
+    return std::make_shared<const Node>(
+        Node{std::move(entry), std::move(left), std::move(right), height, size});
+  }
+
+  /// @brief Build a node over two subtrees whose heights differ by at most two, rotating to
+  /// restore the AVL balance
+  static NodePtr Balance(value_type entry, NodePtr left, NodePtr right) {
+    const int leftHeight = Height(left);
+    const int rightHeight = Height(right);
+    if (leftHeight > rightHeight + 1) {
+      if (Height(left->Left) >= Height(left->Right)) {
+        return Make(left->Entry, left->Left, Make(std::move(entry), left->Right, std::move(right)));
+      }
+      const NodePtr& pivot = left->Right;
+      return Make(pivot->Entry, Make(left->Entry, left->Left, pivot->Left),
+                  Make(std::move(entry), pivot->Right, std::move(right)));
+    }
+    if (rightHeight > leftHeight + 1) {
+      if (Height(right->Right) >= Height(right->Left)) {
+        return Make(right->Entry, Make(std::move(entry), std::move(left), right->Left),
+                    right->Right);
+      }
+      const NodePtr& pivot = right->Left;
+      return Make(pivot->Entry, Make(std::move(entry), std::move(left), pivot->Left),
+                  Make(right->Entry, pivot->Right, right->Right));
+    }
+    return Make(std::move(entry), std::move(left), std::move(right));
+  }
+
+  /// @brief Insert into a subtree, copying the path to the new entry
+  static NodePtr Insert(const NodePtr& node, const Key& key, Value& value, bool assign,
+                        bool& changed) {
+    if (!node) {
+      changed = true;
+      return Make(value_type(key, std::move(value)), nullptr, nullptr);
+    }
+    if (Compare{}(key, node->Entry.first)) {
+      NodePtr left = Insert(node->Left, key, value, assign, changed);
+      return changed ? Balance(node->Entry, std::move(left), node->Right) : node;
+    }
+    if (Compare{}(node->Entry.first, key)) {
+      NodePtr right = Insert(node->Right, key, value, assign, changed);
+      return changed ? Balance(node->Entry, node->Left, std::move(right)) : node;
+    }
+    if (!assign) {
+      return node;
+    }
+    changed = true;
+    return Make(value_type(node->Entry.first, std::move(value)), node->Left, node->Right);
+  }
+
+  /// @brief Remove the smallest entry of a non-empty subtree
+  static NodePtr EraseMin(const NodePtr& node) {
+    if (!node->Left) {
+      return node->Right;
+    }
+    return Balance(node->Entry, EraseMin(node->Left), node->Right);
+  }
+
+  /// @brief Remove from a subtree, copying the path to the removed entry
+  template <typename K>
+  static NodePtr Erase(const NodePtr& node, const K& key, bool& erased) {
+    if (!node) {
+      return node;
+    }
+    if (Compare{}(key, node->Entry.first)) {
+      NodePtr left = Erase(node->Left, key, erased);
+      return erased ? Balance(node->Entry, std::move(left), node->Right) : node;
+    }
+    if (Compare{}(node->Entry.first, key)) {
+      NodePtr right = Erase(node->Right, key, erased);
+      return erased ? Balance(node->Entry, node->Left, std::move(right)) : node;
+    }
+    erased = true;
+    if (!node->Left) {
+      return node->Right;
+    }
+    if (!node->Right) {
+      return node->Left;
+    }
+    const Node* successor = node->Right.get();
+    while (successor->Left) {
+      successor = successor->Left.get();
+    }
+    return Balance(successor->Entry, node->Left, EraseMin(node->Right));
+  }
+
+  /// @brief The root of the tree, shared with copies of the map
+  NodePtr Root_;
+};
+}  // namespace datalint
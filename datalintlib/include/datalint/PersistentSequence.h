@@ -0,0 +1,108 @@
+#pragma once
+
+#include <datalint/PersistentMap.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace datalint {
+
+/// @brief Sequence with structural sharing, kept in insertion order: a PersistentMap keyed by an
+/// increasing insertion number. Copying is O(1) and appending or removing an element copies
+/// O(log n) nodes, leaving copies of the sequence unchanged.
+/// @tparam T the element type
+template <typename T>
+class PersistentSequence {
+  /// @brief The underlying map from insertion number to element
+  using Map = PersistentMap<std::uint64_t, T>;
+
+ public:
+  /// @brief The type of the elements
+  using value_type = T;
+
+  /// @brief Iterator over the elements in insertion order
+  class const_iterator {
+   public:
+    /// @brief Iterator category
+    using iterator_category = std::forward_iterator_tag;
+    /// @brief Value type
+    using value_type = T;
+    /// @brief Difference type
+    using difference_type = std::ptrdiff_t;
+    /// @brief Pointer type
+    using pointer = const T*;
+    /// @brief Reference type
+    using reference = const T&;
+
+    /// @brief Default constructor: the end iterator
+    const_iterator() = default;
+
+    /// @brief Dereference
+    reference operator*() const { return It_->second; }
+    /// @brief Member access
+    pointer operator->() const { return &It_->second; }
+    /// @brief Advance to the next element
+    const_iterator& operator++() {
+      ++It_;
+      return *this;
+    }
+    /// @brief Advance to the next element
+    const_iterator operator++(int) {
+      const_iterator copy = *this;
+      ++It_;
+      return copy;
+    }
+    /// @brief Equality: same position
+    friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+      return lhs.It_ == rhs.It_;
+    }
+
+   private:
+    friend class PersistentSequence;
+
+    /// @brief Constructor from an iterator of the underlying map
+    explicit const_iterator(typename Map::const_iterator it) : It_(std::move(it)) {}
+
+    /// @brief The position in the underlying map
+    typename Map::const_iterator It_;
+  };
+
+  /// @brief Iterator type
+  using iterator = const_iterator;
+
+  /// @brief The number of elements
+  /// @return the number of elements
+  std::size_t size() const noexcept { return Elements_.size(); }
+  /// @brief Whether the sequence has no elements
+  /// @return true for no elements
+  bool empty() const noexcept { return Elements_.empty(); }
+
+  /// @brief Iterator to the first element
+  const_iterator begin() const { return const_iterator(Elements_.begin()); }
+  /// @brief Iterator past the last element
+  const_iterator end() const { return const_iterator(Elements_.end()); }
+
+  /// @brief Append an element
+  /// @param value the element
+  void push_back(T value) { Elements_.insert(NextIndex_++, std::move(value)); }
+
+  /// @brief Remove the element at the given position
+  /// @param position iterator to the element to remove, from this sequence
+  void erase(const const_iterator& position) { Elements_.erase(position.It_->first); }
+
+  /// @brief Whether the two sequences are the same tree, i.e. one is an unmodified copy of the
+  /// other
+  /// @param other the other sequence
+  /// @return true for the sequences share their root
+  bool SharesRootWith(const PersistentSequence& other) const noexcept {
+    return Elements_.SharesRootWith(other.Elements_);
+  }
+
+ private:
+  /// @brief The elements by insertion number
+  Map Elements_;
+  /// @brief The insertion number of the next appended element
+  std::uint64_t NextIndex_ = 0;
+};
+}  // namespace datalint
@@ -1,5 +1,15 @@
 #pragma once
 
+#include <datalint/ColumnPolicy.h>
+#include <datalint/KeyBloomFilter.h>
+#include <datalint/KeyFilterPolicy.h>
+#include <datalint/KeyOccurrences.h>
+#include <datalint/RawDataColumns.h>
+#include <datalint/SmallKey.h>
+
+#include <memory_resource>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -12,22 +22,63 @@ struct RawField;
 class RawData {
  private:
   /// @brief The collection of raw fields.
-  std::vector<RawField> fields;
+  std::pmr::vector<RawField> fields;
+  /// @brief The same fields, as dense columns over interned keys; values and locations are only
+  /// copied into the columns on request.
+  RawDataColumns columns;
+  /// @brief Optional filter over the keys, rejecting most absent keys before the key index.
+  std::optional<KeyBloomFilter> keyFilter;
+
+  /// @brief Build the key filter requested by the given policy.
+  /// @param keyFilterPolicy The filter to build.
+  void BuildKeyFilter(KeyFilterPolicy keyFilterPolicy);
 
  public:
-  /// @brief Constructor that initializes RawData with a vector of RawField.
+  /// @brief Constructor that takes ownership of the given fields. The fields keep using the memory
+  /// resource they were allocated from, so a parser can place a whole file in a per-file arena.
   /// @param fields The vector of RawField to initialize with.
-  RawData(std::vector<RawField> fields);
+  /// @param keyFilterPolicy The filter to build over the keys.
+  /// @param columnPolicy The columns to build over the fields.
+  RawData(std::pmr::vector<RawField> fields,
+          KeyFilterPolicy keyFilterPolicy = KeyFilterPolicy::None,
+          ColumnPolicy columnPolicy = ColumnPolicy::KeysOnly);
+
+  /// @brief Constructor that copies the given fields into the given memory resource.
+  /// @param fields The fields to copy.
+  /// @param resource The memory resource backing the copied fields.
+  /// @param keyFilterPolicy The filter to build over the keys.
+  /// @param columnPolicy The columns to build over the fields.
+  RawData(std::span<const RawField> fields,
+          std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+          KeyFilterPolicy keyFilterPolicy = KeyFilterPolicy::None,
+          ColumnPolicy columnPolicy = ColumnPolicy::KeysOnly);
 
   /// @brief Returns a reference to the vector of raw fields.
   /// @return A const reference to the vector of raw fields.
-  const std::vector<RawField>& Fields() const noexcept;
+  const std::pmr::vector<RawField>& Fields() const noexcept;
+  /// @brief Returns the structure-of-arrays view of the raw fields.
+  /// @return A const reference to the columns.
+  const RawDataColumns& Columns() const noexcept;
+  /// @brief The memory resource backing the raw fields.
+  /// @return The memory resource
+  std::pmr::memory_resource* Resource() const noexcept;
+  /// @brief Returns the key filter, if one was built.
+  /// @return The key filter, or std::nullopt
+  const std::optional<KeyBloomFilter>& KeyFilter() const noexcept;
+  /// @brief Find the id of the given key in the columns, consulting the key filter first.
+  /// @param key The key to search for.
+  /// @return The id of the key, or std::nullopt for no field has this key
+  std::optional<KeyId> FindKeyId(const SmallKey& key) const;
   /// @brief Whether a field with the given key exists.
   /// @param key The key to search for.
-  bool HasKey(const std::string& key) const;
+  bool HasKey(const SmallKey& key) const;
   /// @brief Get all fields matching the given key.
   /// @param key the key by which we search for the fields
   /// @return a vector of pointers to the matching fields
-  std::vector<const RawField*> GetFieldsByKey(const std::string& key) const;
+  std::vector<const RawField*> GetFieldsByKey(const SmallKey& key) const;
+  /// @brief Look several keys up in a single sweep over the fields, instead of one sweep per key.
+  /// @param keys The keys to search for; a key may appear more than once.
+  /// @return The occurrences of each key, in the order of the given keys
+  std::vector<KeyOccurrences> FindKeys(std::span<const SmallKey> keys) const;
 };
 }  // namespace datalint
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <datalint/ColumnPolicy.h>
+#include <datalint/KeyTable.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace datalint {
+
+// Forward declaration
+struct RawField;
+
+/// @brief Structure-of-arrays representation of raw data. Each field is split over dense columns:
+/// its key id, the offset and length of its value in a single shared byte buffer, and its source
+/// location. Passes that only look at keys stream through the key id column alone. The value and
+/// location columns copy every field, so they are only built when requested.
+class RawDataColumns {
+ public:
+  /// @brief Constructor: builds the columns from the given fields
+  /// @param fields the fields, in order of occurrence
+  /// @param resource the memory resource backing the columns
+  /// @param policy the columns to build; the key columns are always built
+  explicit RawDataColumns(std::span<const RawField> fields,
+                          std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+                          ColumnPolicy policy = ColumnPolicy::All);
+
+  /// @brief Return the number of fields (rows)
+  /// @return the number of fields
+  std::size_t Size() const noexcept { return KeyIds_.size(); }
+
+  /// @brief Return the table of distinct keys
+  /// @return the key table
+  const KeyTable& Keys() const noexcept { return Keys_; }
+
+  /// @brief Return the key id of every field, in order of occurrence
+  /// @return the key id column
+  std::span<const KeyId> KeyIds() const noexcept { return KeyIds_; }
+
+  /// @brief Return the key of the field at the given index
+  /// @param index the index of the field
+  /// @return the key
+  std::string_view Key(std::size_t index) const { return Keys_.Key(KeyIds_[index]); }
+
+  /// @brief Whether the value and location columns were built
+  /// @return true for the columns were built with ColumnPolicy::All
+  bool HasValues() const noexcept { return ValueOffsets_.size() == KeyIds_.size(); }
+
+  /// @brief Return the value of the field at the given index. Requires HasValues()
+  /// @param index the index of the field
+  /// @return the value, viewing into the shared value buffer
+  std::string_view Value(std::size_t index) const {
+    return std::string_view(ValueBuffer_).substr(ValueOffsets_[index], ValueLengths_[index]);
+  }
+
+  /// @brief Return the line of the field at the given index. Requires HasValues()
+  /// @param index the index of the field
+  /// @return the line number in the source file
+  int Line(std::size_t index) const { return Lines_[index]; }
+
+  /// @brief Return the filename of the field at the given index. Requires HasValues()
+  /// @param index the index of the field
+  /// @return the filename of the source file
+  std::string_view Filename(std::size_t index) const { return Filenames_[FilenameIds_[index]]; }
+
+ private:
+  /// @brief The distinct keys
+  KeyTable Keys_;
+  /// @brief The key id of every field
+  std::pmr::vector<KeyId> KeyIds_;
+  /// @brief The offset of every field's value in the value buffer
+  std::pmr::vector<std::uint64_t> ValueOffsets_;
+  /// @brief The length of every field's value in the value buffer
+  std::pmr::vector<std::uint32_t> ValueLengths_;
+  /// @brief The concatenated values of all fields
+  std::pmr::string ValueBuffer_;
+  /// @brief The line of every field
+  std::pmr::vector<int> Lines_;
+  /// @brief The index of every field's filename in the filename list
+  std::pmr::vector<std::uint32_t> FilenameIds_;
+  /// @brief The distinct filenames
+  std::pmr::vector<std::pmr::string> Filenames_;
+};
+}  // namespace datalint
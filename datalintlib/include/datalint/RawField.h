@@ -1,7 +1,9 @@
 #pragma once
 
+#include <datalint/SmallKey.h>
 #include <datalint/SourceLocation.h>
 
+#include <memory_resource>
 #include <string>
 
 namespace datalint {
@@ -9,10 +11,22 @@ namespace datalint {
 /// @brief A key-value pair representing a raw field read from input data.
 struct RawField {
   /// @brief The key of the field.
-  std::string Key;
+  SmallKey Key;
   /// @brief The value of the field.
-  std::string Value;
+  std::pmr::string Value;
   /// @brief The source location of the field in the input file.
   SourceLocation Location;
 };
+
+/// @brief Copy a raw field, allocating its key, value and location from the given memory resource
+/// @param field the field to copy
+/// @param resource the memory resource backing the copy
+/// @return the copied field
+inline RawField CopyRawField(const RawField& field, std::pmr::memory_resource* resource) {
+  return RawField{
+      SmallKey(field.Key, resource),
+      std::pmr::string(field.Value, resource),
+      SourceLocation{std::pmr::string(field.Location.Filename, resource), field.Location.Line},
+  };
+}
 }  // namespace datalint
@@ -17,6 +17,10 @@ class AddFieldRulePatchOperation final : public IRulePatchOperation {
   /// @param rules the rules to modify
   void Apply(std::vector<FieldRule>& rules) const override { rules.push_back(CloneRule(Rule_)); }
 
+  /// @brief Getter for the rule to add
+  /// @return the rule added by this operation
+  const FieldRule& Rule() const { return Rule_; }
+
  private:
   /// @brief The rule to add
   FieldRule Rule_;
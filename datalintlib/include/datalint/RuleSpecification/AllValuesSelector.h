@@ -1,5 +1,6 @@
 #pragma once
 
+#include <datalint/ContentHash.h>
 #include <datalint/FieldParser/ParsedField.h>
 #include <datalint/FieldParser/RawValue.h>
 #include <datalint/RuleSpecification/IValueSelector.h>
@@ -19,10 +20,18 @@ class AllValuesSelector final : public IValueSelector {
       const datalint::fieldparser::ParsedField& field) const override {
     std::vector<const datalint::fieldparser::RawValue*> result;
     result.reserve(field.Values.size());
+    SelectInto(field, result);
+    return result;
+  }
+
+  /// @brief Append all the values of a parsed field to caller-provided scratch space
+  /// @param field the field from which we select the raw values
+  /// @param selected where the selected raw values are appended
+  void SelectInto(const datalint::fieldparser::ParsedField& field,
+                  std::vector<const datalint::fieldparser::RawValue*>& selected) const override {
     for (const auto& value : field.Values) {
-      result.push_back(&value);
+      selected.push_back(&value);
     }
-    return result;
   }
 
   /// @brief Clone function to create a deep copy of the selector
@@ -30,5 +39,10 @@ class AllValuesSelector final : public IValueSelector {
     // Simply allocate a new AllValuesSelector since it has no internal state
     return std::make_unique<AllValuesSelector>(*this);
   }
+
+  /// @brief Content hash over the selector type, its only content
+  std::optional<std::uint64_t> ContentHash() const override {
+    return datalint::ContentHasher().Add("AllValuesSelector").Value();
+  }
 };
 }  // namespace datalint::rules
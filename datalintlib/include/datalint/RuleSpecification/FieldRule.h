@@ -2,6 +2,7 @@
 
 #include <datalint/RuleSpecification/IValueRule.h>
 #include <datalint/RuleSpecification/IValueSelector.h>
+#include <datalint/SmallKey.h>
 
 #include <string>
 
@@ -10,7 +11,7 @@ namespace datalint::rules {
 /// rules make up all rules contained in our rule specification
 struct FieldRule {
   /// @brief The key of the parsed field
-  std::string FieldKey;
+  datalint::SmallKey FieldKey;
   /// @brief The rule to apply to the field
   std::unique_ptr<IValueRule> ValueRule;
   /// @brief the accessor to determine which values of the field the rule should be applied to
@@ -3,7 +3,11 @@
 #include <datalint/Error/ErrorCollector.h>
 #include <datalint/RuleSpecification/RuleContext.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 
 namespace datalint::rules {
 /// @brief Interface responsible for specifying a rule to apply to a value
@@ -18,8 +22,26 @@ class IValueRule {
   virtual void Evaluate(const RuleContext& ctx,
                         datalint::error::ErrorCollector& errorCollector) const = 0;
 
+  /// @brief Evaluate the rule on many values at once, reporting the same errors in the same order
+  /// as calling Evaluate on each value in turn, which the default does. Rules override it to run
+  /// one loop over the values, without a virtual call or a context per value.
+  /// @param values the values to evaluate
+  /// @param fields the field of each value, as many as values
+  /// @param errorCollector the error collector
+  virtual void EvaluateBatch(std::span<const datalint::fieldparser::RawValue* const> values,
+                             std::span<const datalint::fieldparser::ParsedField* const> fields,
+                             datalint::error::ErrorCollector& errorCollector) const {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      Evaluate(RuleContext{*fields[i], *values[i]}, errorCollector);
+    }
+  }
+
   /// @brief Clone function
   /// @return a clone of the rule
   virtual std::unique_ptr<IValueRule> Clone() const = 0;
+
+  /// @brief Stable hash of the rule's type and parameters, equal for rules that evaluate alike
+  /// @return the content hash, or std::nullopt for a rule that cannot be hashed (the default)
+  virtual std::optional<std::uint64_t> ContentHash() const { return std::nullopt; }
 };
 }  // namespace datalint::rules
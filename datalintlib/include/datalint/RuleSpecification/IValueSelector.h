@@ -3,7 +3,9 @@
 #include <datalint/FieldParser/ParsedField.h>
 #include <datalint/FieldParser/RawValue.h>
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace datalint::rules {
@@ -18,8 +20,24 @@ class IValueSelector {
   virtual std::vector<const datalint::fieldparser::RawValue*> Select(
       const datalint::fieldparser::ParsedField& field) const = 0;
 
+  /// @brief Select raw values from a parsed field into caller-provided scratch space: reusing the
+  /// same vector across fields, selection makes no allocation once it has grown. The default
+  /// appends the result of Select; selectors override it to append in place.
+  /// @param field the field from which we select the raw values
+  /// @param selected where the selected raw values are appended, in order
+  virtual void SelectInto(const datalint::fieldparser::ParsedField& field,
+                          std::vector<const datalint::fieldparser::RawValue*>& selected) const {
+    const auto values = Select(field);
+    selected.insert(selected.end(), values.begin(), values.end());
+  }
+
   /// @brief Clone function
   /// @return a clone of the value selector
   virtual std::unique_ptr<IValueSelector> Clone() const = 0;
+
+  /// @brief Stable hash of the selector's type and parameters, equal for selectors that select
+  /// alike
+  /// @return the content hash, or std::nullopt for a selector that cannot be hashed (the default)
+  virtual std::optional<std::uint64_t> ContentHash() const { return std::nullopt; }
 };
 }  // namespace datalint::rules
@@ -1,8 +1,13 @@
 #pragma once
+#include <datalint/ContentHash.h>
 #include <datalint/Error/ErrorLog.h>
 #include <datalint/RuleSpecification/IValueRule.h>
 #include <datalint/StringUtils.h>
 
+#include <optional>
+#include <string>
+#include <string_view>
+
 namespace datalint::rules {
 /// @brief Concrete implementation of the rule value applying an integer range rule on the selected
 /// values. With this, we can specify that an integer value should be contained to a given range
@@ -26,27 +31,70 @@ class IntegerInRangeRule final : public IValueRule {
   /// meeting expectations
   void Evaluate(const RuleContext& ctx,
                 datalint::error::ErrorCollector& errorCollector) const override {
-    int value;
-    if (!datalint::utils::TryParseInt(ctx.Value.Value, value)) {
-      errorCollector.AddErrorLog(
-          datalint::error::ErrorLog{"Incorrect value type", "Value must be an integer"});
-      return;
-    }
+    std::optional<std::string> rangeMessage;
+    Check(ctx.Value.Value, rangeMessage, errorCollector);
+  }
 
-    if (value < Min_ || value > Max_) {
-      errorCollector.AddErrorLog(datalint::error::ErrorLog{
-          "Incorrect value",
-          "Value must be between " + std::to_string(Min_) + " and " + std::to_string(Max_)});
+  /// @brief Evaluate the rule on many values in one loop, with the same errors as Evaluate on each
+  /// @param values the values to evaluate
+  /// @param fields the field of each value, unused
+  /// @param errorCollector where we should send errors to given there's a problem with a value
+  void EvaluateBatch(std::span<const datalint::fieldparser::RawValue* const> values,
+                     std::span<const datalint::fieldparser::ParsedField* const> /*fields*/,
+                     datalint::error::ErrorCollector& errorCollector) const override {
+    // The range message is built once per batch, on the first value out of range
+    std::optional<std::string> rangeMessage;
+    for (const auto* rawValue : values) {
+      Check(rawValue->Value, rangeMessage, errorCollector);
     }
   }
 
+  /// @brief The minimum part of the range (inclusive)
+  /// @return the minimum value
+  int Min() const { return Min_; }
+
+  /// @brief The maximum part of the range (inclusive)
+  /// @return the maximum value
+  int Max() const { return Max_; }
+
   /// @brief Clone function for use in patching / RuleSpecificationBuilder
   std::unique_ptr<IValueRule> Clone() const override {
     // Simply create a new instance with the same min and max
     return std::make_unique<IntegerInRangeRule>(Min_, Max_);
   }
 
+  /// @brief Content hash over the rule type and its range
+  std::optional<std::uint64_t> ContentHash() const override {
+    return datalint::ContentHasher()
+        .Add("IntegerInRangeRule")
+        .Add(static_cast<std::uint64_t>(static_cast<std::int64_t>(Min_)))
+        .Add(static_cast<std::uint64_t>(static_cast<std::int64_t>(Max_)))
+        .Value();
+  }
+
  private:
+  /// @brief Check that a value is an integer within the range, reporting the error otherwise
+  /// @param text the value
+  /// @param rangeMessage the message of the range error, built on the first value out of range
+  /// and reused for the next ones
+  /// @param errorCollector where we should send errors to given there's a problem with the value
+  void Check(std::string_view text, std::optional<std::string>& rangeMessage,
+             datalint::error::ErrorCollector& errorCollector) const {
+    int value;
+    if (!datalint::utils::TryParseInt(text, value)) {
+      errorCollector.AddErrorLog(
+          datalint::error::ErrorLog{"Incorrect value type", "Value must be an integer"});
+      return;
+    }
+    if (value < Min_ || value > Max_) {
+      if (!rangeMessage) {
+        rangeMessage =
+            "Value must be between " + std::to_string(Min_) + " and " + std::to_string(Max_);
+      }
+      errorCollector.AddErrorLog(datalint::error::ErrorLog{"Incorrect value", *rangeMessage});
+    }
+  }
+
   /// @brief The minimum value in our acceptable range (inclusive)
   int Min_;
   /// @brief the maximum value in our acceptable range (inclusive)
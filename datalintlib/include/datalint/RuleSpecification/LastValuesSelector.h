@@ -0,0 +1,59 @@
+#pragma once
+
+#include <datalint/ContentHash.h>
+#include <datalint/FieldParser/ParsedField.h>
+#include <datalint/FieldParser/RawValue.h>
+#include <datalint/RuleSpecification/IValueSelector.h>
+
+#include <algorithm>
+
+namespace datalint::rules {
+/// @brief Concrete implementation of IValueSelector that selects the last values of a field
+class LastValuesSelector final : public IValueSelector {
+ public:
+  /// @brief Constructor
+  /// @param count the number of values to select at the end of the field
+  explicit LastValuesSelector(std::size_t count) : Count_(count) {}
+  /// @brief Select function to select the last raw values from a parsed field
+  /// @param field the field from which we select the raw values
+  /// @return The selected raw values, in order, all of them for a field with fewer than the count
+  std::vector<const datalint::fieldparser::RawValue*> Select(
+      const datalint::fieldparser::ParsedField& field) const override {
+    std::vector<const datalint::fieldparser::RawValue*> result;
+    SelectInto(field, result);
+    return result;
+  }
+
+  /// @brief Append the last raw values of a parsed field to caller-provided scratch space
+  /// @param field the field from which we select the raw values
+  /// @param selected where the selected raw values are appended, in order
+  void SelectInto(const datalint::fieldparser::ParsedField& field,
+                  std::vector<const datalint::fieldparser::RawValue*>& selected) const override {
+    const std::size_t size = field.Values.size();
+    for (std::size_t i = size - std::min(Count_, size); i < size; ++i) {
+      selected.push_back(&field.Values[i]);
+    }
+  }
+
+  /// @brief The number of values to select
+  /// @return the count
+  std::size_t Count() const { return Count_; }
+
+  /// @brief Clone function to create a deep copy of the selector
+  std::unique_ptr<IValueSelector> Clone() const override {
+    return std::make_unique<LastValuesSelector>(Count_);
+  }
+
+  /// @brief Content hash over the selector type and its count
+  std::optional<std::uint64_t> ContentHash() const override {
+    return datalint::ContentHasher()
+        .Add("LastValuesSelector")
+        .Add(static_cast<std::uint64_t>(Count_))
+        .Value();
+  }
+
+ private:
+  /// @brief The number of values to select
+  std::size_t Count_;
+};
+}  // namespace datalint::rules
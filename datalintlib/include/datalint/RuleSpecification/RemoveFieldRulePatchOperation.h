@@ -21,6 +21,10 @@ class RemoveFieldRulePatchOperation final : public IRulePatchOperation {
   /// @param rules the rules to modify
   void Apply(std::vector<FieldRule>& rules) const override { std::erase_if(rules, Pred_); }
 
+  /// @brief Getter for the predicate selecting the rules to remove
+  /// @return the predicate
+  const Predicate& Pred() const { return Pred_; }
+
  private:
   /// @brief the predicate that determines whether certain field rules should be removed
   Predicate Pred_;
@@ -34,7 +34,7 @@ class RulePatch {
   const std::string& Name() const { return Name_; }
   /// @brief Getter for the version range the patch applies to
   /// @return the version range the patch applies to
-  VersionRange AppliesTo() const { return AppliesTo_; }
+  const VersionRange& AppliesTo() const { return AppliesTo_; }
   /// @brief Getter for the operations contained in the patch
   /// @return the operations contained in the patch
   const std::vector<std::unique_ptr<IRulePatchOperation>>& Operations() const {
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <datalint/RuleSpecification/RulePatch.h>
+#include <datalint/Version/VersionRange.h>
+
+#include <span>
+#include <string>
+
+namespace datalint::rules {
+
+/// @brief Class reducing a sequence of rule patches to a single equivalent patch, so that building
+/// a specification costs the size of the net change rather than the length of the patch history.
+/// Rules added by the sequence are filtered by the later removals right away, and the removals of
+/// rules of the base specification are merged into one operation. The squashed patch is made of at
+/// most one RemoveFieldRulePatchOperation followed by one AddFieldRulePatchOperation per rule that
+/// survives, and applying it to a specification gives the same result as applying the patches in
+/// order.
+class RulePatchSquasher {
+ public:
+  /// @brief Squash the given patches for a version interval
+  /// @param name the name of the squashed patch
+  /// @param interval the version interval of the squashed patch
+  /// @param patches the patches, in application order
+  /// @return a patch applying to the interval with the net effect of the patches applying to it
+  /// @throws std::invalid_argument if a patch applies to only part of the interval, or contains an
+  /// operation other than AddFieldRulePatchOperation and RemoveFieldRulePatchOperation
+  /// @throws std::logic_error if an added rule is not fully initialized
+  RulePatch Squash(std::string name, const VersionRange& interval,
+                   std::span<const RulePatch> patches) const;
+};
+}  // namespace datalint::rules
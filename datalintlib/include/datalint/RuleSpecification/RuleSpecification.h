@@ -1,23 +1,69 @@
 #pragma once
 
+#include <datalint/ContentHash.h>
+#include <datalint/MinimalPerfectHash.h>
 #include <datalint/RuleSpecification/FieldRule.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
 #include <vector>
 
 namespace datalint::rules {
-/// @brief Class to contain all the rules that should be applied given all our patches
+/// @brief Class to contain all the rules that should be applied given all our patches. On
+/// construction the distinct keys of the rules get dense ids, in order of first rule, and each rule
+/// records the id of its key, so that a field finds the key of its rules with one hash lookup.
 class RuleSpecification {
  public:
   /// @brief Constructor that takes ownership of the resolved rules
   /// @param rules The field rules that make up this specification
-  explicit RuleSpecification(std::vector<FieldRule> rules) : Rules_(std::move(rules)) {}
+  explicit RuleSpecification(std::vector<FieldRule> rules);
 
   /// @brief Access the resolved field rules
   /// @return const reference to the vector of rules
   const std::vector<FieldRule>& Rules() const noexcept { return Rules_; }
 
+  /// @brief The number of distinct keys of the rules
+  /// @return the number of keys
+  std::size_t KeyCount() const noexcept { return KeyFirstRules_.size(); }
+
+  /// @brief The id of the key of a rule
+  /// @param rule the position of the rule in Rules()
+  /// @return the id of its key
+  std::uint32_t RuleKey(std::size_t rule) const noexcept { return RuleKeys_[rule]; }
+
+  /// @brief Find the id of a key
+  /// @param key the key
+  /// @return the id of the key, below KeyCount(), or std::nullopt for a key no rule is on
+  std::optional<std::uint32_t> FindKey(std::string_view key) const noexcept;
+
+  /// @brief Stable hash of the rules, in order: two specifications with the same hash evaluate
+  /// alike, whichever patches they were built from
+  /// @return the content hash, or std::nullopt if a rule or selector cannot be hashed
+  std::optional<std::uint64_t> ContentHash() const {
+    datalint::ContentHasher hasher;
+    hasher.Add(static_cast<std::uint64_t>(Rules_.size()));
+    for (const auto& rule : Rules_) {
+      const auto ruleHash = rule.ValueRule ? rule.ValueRule->ContentHash() : std::nullopt;
+      const auto selectorHash =
+          rule.ValueSelector ? rule.ValueSelector->ContentHash() : std::nullopt;
+      if (!ruleHash || !selectorHash) {
+        return std::nullopt;
+      }
+      hasher.Add(rule.FieldKey.View()).Add(*ruleHash).Add(*selectorHash);
+    }
+    return hasher.Value();
+  }
+
  private:
   /// @brief The rules that make up the rule specification
   std::vector<FieldRule> Rules_;
+  /// @brief The position of the first rule on each key, by key id
+  std::vector<std::uint32_t> KeyFirstRules_;
+  /// @brief The id of the key of each rule
+  std::vector<std::uint32_t> RuleKeys_;
+  /// @brief Perfect hash from key to key id
+  datalint::MinimalPerfectHash KeyHash_;
 };
 }  // namespace datalint::rules
@@ -4,6 +4,12 @@
 #include <datalint/RuleSpecification/RuleSpecification.h>
 #include <datalint/Version/Version.h>
 #include <datalint/Version/VersionRange.h>
+#include <datalint/Version/VersionRangeIndex.h>
+
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace datalint::rules {
 /// @brief Class responsible for building rule specifications
@@ -15,7 +21,7 @@ class RuleSpecificationBuilder {
   /// @param patches the set of all patches to apply to our finalized rule specification
   /// @return the final built rule specification
   RuleSpecification Build(const datalint::Version& version,
-                          const std::vector<RulePatch>& patches) const {
+                          std::span<const RulePatch> patches) const {
     std::vector<FieldRule> rules;
 
     for (const auto& patch : patches) {
@@ -28,5 +34,28 @@ class RuleSpecificationBuilder {
 
     return RuleSpecification(std::move(rules));
   }
+
+  /// @brief Build function using an index over the patch version ranges, visiting only the
+  /// applicable patches rather than testing every patch
+  /// @param version the version for which we should build our rule specification
+  /// @param patches the set of all patches to apply to our finalized rule specification
+  /// @param index the index over the version ranges of the patches, built by
+  /// VersionRangeIndex::ForPatches(patches)
+  /// @return the final built rule specification
+  /// @throws std::invalid_argument if the index does not cover as many ranges as there are patches
+  RuleSpecification Build(const datalint::Version& version, std::span<const RulePatch> patches,
+                          const datalint::VersionRangeIndex& index) const {
+    if (index.Size() != patches.size()) {
+      throw std::invalid_argument("Build failed: the version range index was not built over the " +
+                                  std::to_string(patches.size()) + " patches");
+    }
+    std::vector<FieldRule> rules;
+
+    for (const std::size_t position : index.Find(version)) {
+      patches[position].Apply(rules);
+    }
+
+    return RuleSpecification(std::move(rules));
+  }
 };
 }  // namespace datalint::rules
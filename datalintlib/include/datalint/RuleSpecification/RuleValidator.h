@@ -5,9 +5,14 @@
 #include <datalint/RuleSpecification/FieldRule.h>
 #include <datalint/RuleSpecification/RuleSpecification.h>
 
+#include <span>
+#include <vector>
+
 namespace datalint::rules {
 /// @brief Class responsible for validating all rules in the rule specification given the parsed
-/// data
+/// data. One pass over the parsed data sorts the fields by the rule key they carry, through the
+/// key dispatch table of the specification; each rule then only visits the fields on its key, and
+/// evaluates all the values it selects from them with one IValueRule::EvaluateBatch call.
 class RuleValidator {
  public:
   /// @brief Validate raw data against a rule specification
@@ -20,13 +25,23 @@ class RuleValidator {
                               error::ErrorCollector& errorCollector) const;
 
  private:
+  /// @brief The values a rule selects, with the field of each, reused across rules
+  struct SelectedValues {
+    /// @brief The selected values
+    std::vector<const fieldparser::RawValue*> Values;
+    /// @brief The field of each selected value
+    std::vector<const fieldparser::ParsedField*> Fields;
+  };
+
   /// @brief Helper to validate an individual field rule
   /// @param rule the field rule
-  /// @param parsedData the parsed data
+  /// @param fields the parsed fields on the key of the rule, in order of occurrence
+  /// @param selected scratch space for the selected values
   /// @param errorCollector the error collector
   /// @return true for the field rule is valid
-  bool ValidateFieldRule(const FieldRule& rule, const fieldparser::ParsedData& parsedData,
-                         error::ErrorCollector& errorCollector) const;
+  bool ValidateFieldRule(const FieldRule& rule,
+                         std::span<const fieldparser::ParsedField* const> fields,
+                         SelectedValues& selected, error::ErrorCollector& errorCollector) const;
 };
 
 }  // namespace datalint::rules
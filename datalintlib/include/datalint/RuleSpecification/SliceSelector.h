@@ -0,0 +1,77 @@
+#pragma once
+
+#include <datalint/ContentHash.h>
+#include <datalint/FieldParser/ParsedField.h>
+#include <datalint/FieldParser/RawValue.h>
+#include <datalint/RuleSpecification/IValueSelector.h>
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+namespace datalint::rules {
+/// @brief Concrete implementation of IValueSelector that selects the values of a range of indices
+class SliceSelector final : public IValueSelector {
+ public:
+  /// @brief Constructor
+  /// @param begin the index of the first value to select
+  /// @param end one past the index of the last value to select, or std::nullopt for all the values
+  /// from begin
+  /// @throws invalid_argument for end less than begin
+  explicit SliceSelector(std::size_t begin, std::optional<std::size_t> end = std::nullopt)
+      : Begin_(begin), End_(end) {
+    if (end && *end < begin) {
+      throw std::invalid_argument("SliceSelector: end cannot be less than begin");
+    }
+  }
+  /// @brief Select function to select the raw values of the slice from a parsed field
+  /// @param field the field from which we select the raw values
+  /// @return The selected raw values, as many as the field has in the slice
+  std::vector<const datalint::fieldparser::RawValue*> Select(
+      const datalint::fieldparser::ParsedField& field) const override {
+    std::vector<const datalint::fieldparser::RawValue*> result;
+    SelectInto(field, result);
+    return result;
+  }
+
+  /// @brief Append the raw values of the slice to caller-provided scratch space
+  /// @param field the field from which we select the raw values
+  /// @param selected where the selected raw values are appended
+  void SelectInto(const datalint::fieldparser::ParsedField& field,
+                  std::vector<const datalint::fieldparser::RawValue*>& selected) const override {
+    const std::size_t end = std::min(End_.value_or(field.Values.size()), field.Values.size());
+    for (std::size_t i = Begin_; i < end; ++i) {
+      selected.push_back(&field.Values[i]);
+    }
+  }
+
+  /// @brief The index of the first value to select
+  /// @return the index
+  std::size_t Begin() const { return Begin_; }
+
+  /// @brief One past the index of the last value to select
+  /// @return the index, or std::nullopt for all the values from Begin()
+  std::optional<std::size_t> End() const { return End_; }
+
+  /// @brief Clone function to create a deep copy of the selector
+  std::unique_ptr<IValueSelector> Clone() const override {
+    return std::make_unique<SliceSelector>(Begin_, End_);
+  }
+
+  /// @brief Content hash over the selector type and its range
+  std::optional<std::uint64_t> ContentHash() const override {
+    return datalint::ContentHasher()
+        .Add("SliceSelector")
+        .Add(static_cast<std::uint64_t>(Begin_))
+        .Add(static_cast<std::uint64_t>(End_.value_or(std::numeric_limits<std::size_t>::max())))
+        .Value();
+  }
+
+ private:
+  /// @brief The index of the first value to select
+  std::size_t Begin_;
+  /// @brief One past the index of the last value to select, or std::nullopt for no end
+  std::optional<std::size_t> End_;
+};
+}  // namespace datalint::rules
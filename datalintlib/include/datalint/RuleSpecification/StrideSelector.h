@@ -0,0 +1,76 @@
+#pragma once
+
+#include <datalint/ContentHash.h>
+#include <datalint/FieldParser/ParsedField.h>
+#include <datalint/FieldParser/RawValue.h>
+#include <datalint/RuleSpecification/IValueSelector.h>
+
+#include <stdexcept>
+
+namespace datalint::rules {
+/// @brief Concrete implementation of IValueSelector that selects every step-th value from a start
+/// index, e.g. one column of values laid out row after row
+class StrideSelector final : public IValueSelector {
+ public:
+  /// @brief Constructor
+  /// @param start the index of the first value to select
+  /// @param step the distance between the indices of two selected values
+  /// @throws invalid_argument for a step of zero
+  StrideSelector(std::size_t start, std::size_t step) : Start_(start), Step_(step) {
+    if (step == 0) {
+      throw std::invalid_argument("StrideSelector: step cannot be zero");
+    }
+  }
+  /// @brief Select function to select the strided raw values from a parsed field
+  /// @param field the field from which we select the raw values
+  /// @return The selected raw values
+  std::vector<const datalint::fieldparser::RawValue*> Select(
+      const datalint::fieldparser::ParsedField& field) const override {
+    std::vector<const datalint::fieldparser::RawValue*> result;
+    SelectInto(field, result);
+    return result;
+  }
+
+  /// @brief Append the strided raw values of a parsed field to caller-provided scratch space
+  /// @param field the field from which we select the raw values
+  /// @param selected where the selected raw values are appended, in order
+  void SelectInto(const datalint::fieldparser::ParsedField& field,
+                  std::vector<const datalint::fieldparser::RawValue*>& selected) const override {
+    const std::size_t size = field.Values.size();
+    for (std::size_t i = Start_; i < size; i += Step_) {
+      selected.push_back(&field.Values[i]);
+      if (size - i <= Step_) {
+        break;  // the next index would be past the end, or overflow
+      }
+    }
+  }
+
+  /// @brief The index of the first value to select
+  /// @return the index
+  std::size_t Start() const { return Start_; }
+
+  /// @brief The distance between the indices of two selected values
+  /// @return the step
+  std::size_t Step() const { return Step_; }
+
+  /// @brief Clone function to create a deep copy of the selector
+  std::unique_ptr<IValueSelector> Clone() const override {
+    return std::make_unique<StrideSelector>(Start_, Step_);
+  }
+
+  /// @brief Content hash over the selector type, its start and its step
+  std::optional<std::uint64_t> ContentHash() const override {
+    return datalint::ContentHasher()
+        .Add("StrideSelector")
+        .Add(static_cast<std::uint64_t>(Start_))
+        .Add(static_cast<std::uint64_t>(Step_))
+        .Value();
+  }
+
+ private:
+  /// @brief The index of the first value to select
+  std::size_t Start_;
+  /// @brief The distance between the indices of two selected values
+  std::size_t Step_;
+};
+}  // namespace datalint::rules
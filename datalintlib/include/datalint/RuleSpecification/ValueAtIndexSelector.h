@@ -1,5 +1,6 @@
 #pragma once
 
+#include <datalint/ContentHash.h>
 #include <datalint/FieldParser/ParsedField.h>
 #include <datalint/FieldParser/RawValue.h>
 #include <datalint/RuleSpecification/IValueSelector.h>
@@ -25,12 +26,34 @@ class ValueAtIndexSelector final : public IValueSelector {
     return {&field.Values[Index_]};
   }
 
+  /// @brief Append the value at the index, if any, to caller-provided scratch space
+  /// @param field the field from which we select the raw value
+  /// @param selected where the selected raw value is appended
+  void SelectInto(const datalint::fieldparser::ParsedField& field,
+                  std::vector<const datalint::fieldparser::RawValue*>& selected) const override {
+    if (Index_ < field.Values.size()) {
+      selected.push_back(&field.Values[Index_]);
+    }
+  }
+
+  /// @brief The index of the value to select
+  /// @return the index
+  std::size_t Index() const { return Index_; }
+
   /// @brief Clone function to create a deep copy of the selector
   std::unique_ptr<IValueSelector> Clone() const override {
     // Create a new selector with the same value
     return std::make_unique<ValueAtIndexSelector>(Index_);
   }
 
+  /// @brief Content hash over the selector type and its index
+  std::optional<std::uint64_t> ContentHash() const override {
+    return datalint::ContentHasher()
+        .Add("ValueAtIndexSelector")
+        .Add(static_cast<std::uint64_t>(Index_))
+        .Value();
+  }
+
  private:
   /// @brief The index of the value to select
   std::size_t Index_;
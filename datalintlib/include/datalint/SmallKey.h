@@ -0,0 +1,291 @@
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DATALINT_SMALL_KEY_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define DATALINT_SMALL_KEY_NEON 1
+#endif
+
+namespace datalint {
+
+/// @brief String type for field keys, optimized for the short keys found in practice. Keys of up
+/// to kInlineCapacity bytes are stored inline, zero-padded, in a 32-byte block whose last byte
+/// holds the length; equality of two inline keys is then a compare of the two blocks with two
+/// 16-byte SIMD loads per key. Longer keys fall back to an allocation from a memory resource,
+/// chosen at construction like for a std::pmr::string: a copy allocates from the default resource
+/// unless given one, and a move takes the allocation along with its resource.
+class SmallKey {
+ public:
+  /// @brief The maximum length of a key stored inline
+  static constexpr std::size_t kInlineCapacity = 31;
+
+  /// @brief Default constructor: the empty key
+  SmallKey() noexcept { std::memset(Bytes_, 0, sizeof(Bytes_)); }
+
+  /// @brief Constructor from any string-like type
+  /// @param text the text of the key
+  /// @param resource the memory resource backing the key, if it is too long to be stored inline
+  template <typename T>
+    requires std::convertible_to<const T&, std::string_view> &&
+             (!std::same_as<std::remove_cvref_t<T>, SmallKey>)
+  SmallKey(const T& text, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    Assign(std::string_view(text), resource);
+  }
+
+  /// @brief Copy constructor
+  /// @param other the key to copy
+  /// @param resource the memory resource backing the copy, if it is too long to be stored inline
+  SmallKey(const SmallKey& other,
+           std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    if (other.IsInline()) {
+      std::memcpy(Bytes_, other.Bytes_, sizeof(Bytes_));
+    } else {
+      Assign(other.View(), resource);
+    }
+  }
+
+  /// @brief Move constructor, leaving the moved-from key empty
+  /// @param other the key to move from
+  SmallKey(SmallKey&& other) noexcept {
+    std::memcpy(Bytes_, other.Bytes_, sizeof(Bytes_));
+    std::memset(other.Bytes_, 0, sizeof(other.Bytes_));
+  }
+
+  /// @brief Copy assignment operator. A key already on the heap keeps its memory resource
+  /// @param other the key to copy
+  /// @return this key
+  SmallKey& operator=(const SmallKey& other) {
+    if (this != &other) {
+      SmallKey copy(other, IsInline() ? std::pmr::get_default_resource() : HeapResource());
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  /// @brief Move assignment operator, leaving the moved-from key empty
+  /// @param other the key to move from
+  /// @return this key
+  SmallKey& operator=(SmallKey&& other) noexcept {
+    if (this != &other) {
+      Release();
+      std::memcpy(Bytes_, other.Bytes_, sizeof(Bytes_));
+      std::memset(other.Bytes_, 0, sizeof(other.Bytes_));
+    }
+    return *this;
+  }
+
+  /// @brief Destructor
+  ~SmallKey() { Release(); }
+
+  /// @brief Return the text of the key
+  /// @return a view of the key's characters
+  std::string_view View() const noexcept {
+    if (IsInline()) {
+      return std::string_view(reinterpret_cast<const char*>(Bytes_), Bytes_[kTagIndex]);
+    }
+    return std::string_view(HeapData(), HeapSize());
+  }
+
+  /// @brief Implicit conversion to a string view of the key
+  operator std::string_view() const noexcept { return View(); }
+
+  /// @brief Return the length of the key
+  /// @return the number of characters of the key
+  std::size_t Size() const noexcept { return IsInline() ? Bytes_[kTagIndex] : HeapSize(); }
+
+  /// @brief Whether the key is empty
+  /// @return true for the key has no characters
+  bool Empty() const noexcept { return Size() == 0; }
+
+  /// @brief Whether the key is stored inline rather than on the heap
+  /// @return true for the key is stored inline
+  bool IsInline() const noexcept { return Bytes_[kTagIndex] != kHeapTag; }
+
+  /// @brief Hash of the key, consistent with equality
+  /// @return the hash value
+  std::size_t Hash() const noexcept {
+    if (!IsInline()) {
+      return std::hash<std::string_view>{}(View());
+    }
+    return HashBlock(Bytes_);
+  }
+
+  /// @brief Hash of the key with the given text, without constructing the key
+  /// @param text the text of the key
+  /// @return the hash value, equal to SmallKey(text).Hash()
+  static std::size_t Hash(std::string_view text) noexcept {
+    if (text.size() > kInlineCapacity) {
+      return std::hash<std::string_view>{}(text);
+    }
+    alignas(16) unsigned char block[32] = {};
+    if (!text.empty()) {
+      std::memcpy(block, text.data(), text.size());
+    }
+    block[kTagIndex] = static_cast<unsigned char>(text.size());
+    return HashBlock(block);
+  }
+
+  /// @brief Equality between two keys; a block compare when both are inline
+  friend bool operator==(const SmallKey& lhs, const SmallKey& rhs) noexcept {
+    if (lhs.IsInline() && rhs.IsInline()) {
+      return InlineEqual(lhs.Bytes_, rhs.Bytes_);
+    }
+    // A heap key is always longer than any inline key
+    if (lhs.IsInline() != rhs.IsInline()) {
+      return false;
+    }
+    return lhs.View() == rhs.View();
+  }
+
+  /// @brief Equality between a key and any string-like type
+  template <typename T>
+    requires std::convertible_to<const T&, std::string_view> &&
+             (!std::same_as<std::remove_cvref_t<T>, SmallKey>)
+  friend bool operator==(const SmallKey& lhs, const T& rhs) noexcept {
+    return lhs.View() == std::string_view(rhs);
+  }
+
+  /// @brief Lexicographic ordering between two keys
+  friend std::strong_ordering operator<=>(const SmallKey& lhs, const SmallKey& rhs) noexcept {
+    return lhs.View() <=> rhs.View();
+  }
+
+  /// @brief Lexicographic ordering between a key and any string-like type
+  template <typename T>
+    requires std::convertible_to<const T&, std::string_view> &&
+             (!std::same_as<std::remove_cvref_t<T>, SmallKey>)
+  friend std::strong_ordering operator<=>(const SmallKey& lhs, const T& rhs) noexcept {
+    return lhs.View() <=> std::string_view(rhs);
+  }
+
+  /// @brief Stream the text of the key
+  friend std::ostream& operator<<(std::ostream& os, const SmallKey& key) {
+    return os << key.View();
+  }
+
+ private:
+  /// @brief Index of the byte holding the inline length, or kHeapTag
+  static constexpr std::size_t kTagIndex = 31;
+  /// @brief Tag marking a key stored on the heap
+  static constexpr unsigned char kHeapTag = 0xFF;
+
+  /// @brief Hash a zero-padded inline block; hashing all of it is consistent with equality
+  static std::size_t HashBlock(const unsigned char* block) noexcept {
+    std::uint64_t words[4];
+    std::memcpy(words, block, sizeof(words));
+    std::uint64_t hash = 0x9E3779B97F4A7C15ull;
+    for (const std::uint64_t word : words) {
+      hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+      hash ^= hash >> 32;
+    }
+    return static_cast<std::size_t>(hash);
+  }
+
+  /// @brief Compare two zero-padded inline blocks
+  static bool InlineEqual(const unsigned char* lhs, const unsigned char* rhs) noexcept {
+#if defined(DATALINT_SMALL_KEY_SSE2)
+    const __m128i lo = _mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(lhs)),
+                                      _mm_load_si128(reinterpret_cast<const __m128i*>(rhs)));
+    const __m128i hi = _mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(lhs + 16)),
+                                      _mm_load_si128(reinterpret_cast<const __m128i*>(rhs + 16)));
+    return _mm_movemask_epi8(_mm_and_si128(lo, hi)) == 0xFFFF;
+#elif defined(DATALINT_SMALL_KEY_NEON)
+    const uint8x16_t lo = vceqq_u8(vld1q_u8(lhs), vld1q_u8(rhs));
+    const uint8x16_t hi = vceqq_u8(vld1q_u8(lhs + 16), vld1q_u8(rhs + 16));
+    return vminvq_u8(vandq_u8(lo, hi)) == 0xFF;
+#else
+    return std::memcmp(lhs, rhs, 32) == 0;
+#endif
+  }
+
+  /// @brief Set the key to the given text; the key must not hold a heap allocation
+  /// @param text the text of the key
+  /// @param resource the memory resource to allocate a long key from
+  void Assign(std::string_view text, std::pmr::memory_resource* resource) {
+    std::memset(Bytes_, 0, sizeof(Bytes_));
+    if (text.size() <= kInlineCapacity) {
+      if (!text.empty()) {
+        std::memcpy(Bytes_, text.data(), text.size());
+      }
+      Bytes_[kTagIndex] = static_cast<unsigned char>(text.size());
+      return;
+    }
+    char* data = static_cast<char*>(resource->allocate(text.size(), alignof(char)));
+    std::memcpy(data, text.data(), text.size());
+    const std::size_t size = text.size();
+    std::memcpy(Bytes_ + kHeapDataOffset, &data, sizeof(data));
+    std::memcpy(Bytes_ + kHeapSizeOffset, &size, sizeof(size));
+    std::memcpy(Bytes_ + kHeapResourceOffset, &resource, sizeof(resource));
+    Bytes_[kTagIndex] = kHeapTag;
+  }
+
+  /// @brief Free the heap allocation, if any
+  void Release() noexcept {
+    if (!IsInline()) {
+      HeapResource()->deallocate(HeapData(), HeapSize(), alignof(char));
+    }
+  }
+
+  /// @brief Pointer to the heap allocation of a long key
+  char* HeapData() const noexcept {
+    char* data;
+    std::memcpy(&data, Bytes_ + kHeapDataOffset, sizeof(data));
+    return data;
+  }
+
+  /// @brief Length of a long key
+  std::size_t HeapSize() const noexcept {
+    std::size_t size;
+    std::memcpy(&size, Bytes_ + kHeapSizeOffset, sizeof(size));
+    return size;
+  }
+
+  /// @brief Memory resource the heap allocation of a long key comes from
+  std::pmr::memory_resource* HeapResource() const noexcept {
+    std::pmr::memory_resource* resource;
+    std::memcpy(&resource, Bytes_ + kHeapResourceOffset, sizeof(resource));
+    return resource;
+  }
+
+  /// @brief Offsets of the heap pointer, length and memory resource of a long key
+  static constexpr std::size_t kHeapDataOffset = 0;
+  static constexpr std::size_t kHeapSizeOffset = kHeapDataOffset + sizeof(char*);
+  static constexpr std::size_t kHeapResourceOffset = kHeapSizeOffset + sizeof(std::size_t);
+  static_assert(kHeapResourceOffset + sizeof(std::pmr::memory_resource*) <= kTagIndex);
+
+  /// @brief Inline characters (zero-padded) followed by the length byte, or the heap pointer,
+  /// length and memory resource followed by kHeapTag
+  alignas(16) unsigned char Bytes_[32];
+};
+
+/// @brief Transparent hash functor for keys, usable for heterogeneous lookups by string view
+struct SmallKeyHash {
+  /// @brief Enables heterogeneous lookup in unordered containers
+  using is_transparent = void;
+
+  /// @brief Hash a key
+  std::size_t operator()(const SmallKey& key) const noexcept { return key.Hash(); }
+
+  /// @brief Hash a string view, consistently with the hash of the equal key
+  std::size_t operator()(std::string_view key) const noexcept { return SmallKey::Hash(key); }
+};
+}  // namespace datalint
+
+template <>
+struct std::hash<datalint::SmallKey> {
+  std::size_t operator()(const datalint::SmallKey& key) const noexcept { return key.Hash(); }
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory_resource>
 #include <string>
 
 namespace datalint {
@@ -7,7 +8,7 @@ namespace datalint {
 /// @brief Represents the location of a source element within a file.
 struct SourceLocation {
   /// @brief The filename where the source is located.
-  std::string Filename;
+  std::pmr::string Filename;
   /// @brief The line number in the source file.
   int Line;
 };
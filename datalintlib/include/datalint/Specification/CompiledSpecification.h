@@ -0,0 +1,23 @@
+#pragma once
+
+#include <datalint/LayoutSpecification/LayoutSpecification.h>
+#include <datalint/RuleSpecification/RuleSpecification.h>
+
+#include <cstddef>
+
+namespace datalint {
+
+/// @brief The layout and rule specifications built for one application version. Once built it is
+/// never modified, so a single instance can be shared read-only between threads validating
+/// different files.
+struct CompiledSpecification {
+  /// @brief The expected layout of the raw data
+  layout::LayoutSpecification Layout;
+  /// @brief The rules on the parsed field values
+  rules::RuleSpecification Rules;
+
+  /// @brief Estimate the memory held by the specifications, used to bound caches of them
+  /// @return the approximate number of bytes held
+  std::size_t ApproximateMemoryUsage() const;
+};
+}  // namespace datalint
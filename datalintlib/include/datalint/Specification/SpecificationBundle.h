@@ -0,0 +1,94 @@
+#pragma once
+
+#include <datalint/Specification/CompiledSpecification.h>
+#include <datalint/Specification/VersionedSpecifications.h>
+#include <datalint/Version/Version.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace datalint {
+
+/// @brief The specifications of every version interval, compiled ahead of time into a binary file.
+/// The file holds flat tables (interned keys, interval starts, count bounds, ordering constraints
+/// and rule parameters) referring to each other by index, so loading it is a memory map followed
+/// by bound checks and pointer fix-ups into the mapping: nothing is built until the specifications
+/// of a version are asked for, and then only those of its interval. Short-lived processes load a
+/// bundle instead of replaying every patch at startup.
+///
+/// A bundle can only hold the rules and selectors it knows the parameters of: IntegerInRangeRule,
+/// AllValuesSelector and ValueAtIndexSelector. The tables are stored in the byte order of the
+/// machine that wrote them; a bundle written on a machine of the other byte order is rejected.
+class SpecificationBundle {
+ public:
+  /// @brief The version of the file format, bumped on any incompatible change
+  static constexpr std::uint32_t kFormatVersion = 2;
+
+  /// @brief Write the specifications of every interval to a bundle file
+  /// @param specifications the compiled specifications
+  /// @param path the bundle file to write, replaced if it exists
+  /// @throws std::invalid_argument if a rule or selector cannot be stored in a bundle
+  /// @throws std::runtime_error if the file cannot be written
+  static void Write(const VersionedSpecifications& specifications,
+                    const std::filesystem::path& path);
+
+  /// @brief Memory-map a bundle file
+  /// @param path the bundle file
+  /// @return the loaded bundle, which keeps the file mapped for as long as it or a copy is alive
+  /// @throws std::runtime_error if the file cannot be read, is not a bundle, has another format
+  /// version or byte order, or is malformed
+  static SpecificationBundle Load(const std::filesystem::path& path);
+
+  /// @brief Return the specifications for the given version
+  /// @param version the application version
+  /// @return the specifications, identical to building the patches for the version
+  CompiledSpecification Find(const Version& version) const;
+
+  /// @brief The number of intervals the version line is split into
+  /// @return the number of intervals
+  std::size_t IntervalCount() const noexcept;
+
+  /// @brief The number of distinct specifications stored, at most IntervalCount()
+  /// @return the number of distinct specifications
+  std::size_t SpecificationCount() const noexcept;
+
+ private:
+  // Records of the file tables, defined with the file format
+  struct KeyRecord;
+  struct IntervalRecord;
+  struct SpecificationRecord;
+  struct FieldRecord;
+  struct ConstraintRecord;
+  struct RuleRecord;
+
+  /// @brief Constructor over the bytes of a bundle, validating them and fixing up the table
+  /// pointers
+  /// @param bytes the bytes of the bundle, kept alive by the bundle
+  /// @param size the number of bytes
+  SpecificationBundle(std::shared_ptr<const std::byte> bytes, std::size_t size);
+
+  /// @brief The bytes of the bundle: the file mapping, released with the last copy
+  std::shared_ptr<const std::byte> Bytes_;
+  /// @brief The interned keys
+  const KeyRecord* Keys_ = nullptr;
+  /// @brief The characters of the interned keys
+  const char* KeyCharacters_ = nullptr;
+  /// @brief The intervals, sorted by first version
+  const IntervalRecord* Intervals_ = nullptr;
+  /// @brief The distinct specifications
+  const SpecificationRecord* Specifications_ = nullptr;
+  /// @brief The expected fields of all specifications, each specification's in key order followed
+  /// by its field patterns in pattern order
+  const FieldRecord* Fields_ = nullptr;
+  /// @brief The ordering constraints of all specifications, each specification's in order
+  const ConstraintRecord* Constraints_ = nullptr;
+  /// @brief The field rules of all specifications, each specification's in order
+  const RuleRecord* Rules_ = nullptr;
+  /// @brief The number of intervals
+  std::size_t IntervalCount_ = 0;
+  /// @brief The number of distinct specifications
+  std::size_t SpecificationCount_ = 0;
+};
+}  // namespace datalint
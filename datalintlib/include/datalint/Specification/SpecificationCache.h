@@ -0,0 +1,97 @@
+#pragma once
+
+#include <datalint/ApplicationDescriptor/ApplicationDescriptor.h>
+#include <datalint/Specification/CompiledSpecification.h>
+#include <datalint/Version/Version.h>
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace datalint {
+
+/// @brief Thread-safe least-recently-used cache of compiled specifications, keyed by application
+/// name and version. In a batch run most files share a handful of versions, so each version's
+/// patches are replayed once rather than once per file. The cache is bounded by the approximate
+/// memory usage of the cached specifications; an evicted specification stays alive for as long as
+/// a caller still holds it.
+class SpecificationCache {
+ public:
+  /// @brief Function building the specifications of an application version
+  using BuildFunction = std::function<CompiledSpecification(const ApplicationDescriptor&)>;
+
+  /// @brief Constructor
+  /// @param maxBytes the approximate memory budget of the cached specifications
+  explicit SpecificationCache(std::size_t maxBytes);
+
+  /// @brief Return the cached specifications of the given application version, building and
+  /// caching them on a miss. Concurrent misses on the same version build it only once: the other
+  /// callers wait for that build.
+  /// @param descriptor the application name and version
+  /// @param build the function building the specifications on a miss
+  /// @return the shared, immutable specifications
+  /// @throws whatever build throws; a failed build is not cached
+  std::shared_ptr<const CompiledSpecification> GetOrBuild(const ApplicationDescriptor& descriptor,
+                                                          const BuildFunction& build);
+
+  /// @brief Return the cached specifications of the given application version, without building
+  /// @param descriptor the application name and version
+  /// @return the specifications, or nullptr for not cached (or still being built)
+  std::shared_ptr<const CompiledSpecification> Find(const ApplicationDescriptor& descriptor);
+
+  /// @brief The number of cached specifications, including those being built
+  /// @return the number of entries
+  std::size_t Size() const;
+
+  /// @brief The approximate memory usage of the cached specifications
+  /// @return the number of bytes
+  std::size_t MemoryUsage() const;
+
+  /// @brief The memory budget of the cache
+  /// @return the number of bytes
+  std::size_t MaxBytes() const noexcept;
+
+  /// @brief Drop all built specifications from the cache
+  void Clear();
+
+ private:
+  /// @brief Cache key: application name and version
+  using Key = std::pair<std::string, Version>;
+
+  /// @brief A cached specification, or the pending build of one
+  struct Entry {
+    /// @brief The specifications, ready once the build completes
+    std::shared_future<std::shared_ptr<const CompiledSpecification>> Specification;
+    /// @brief The approximate memory usage, 0 while building
+    std::size_t Bytes = 0;
+    /// @brief Whether the build completed
+    bool Ready = false;
+    /// @brief Position in the recency list
+    std::list<Key>::iterator Recency;
+  };
+
+  /// @brief Mark the entry as most recently used; the mutex must be held
+  void Touch(Entry& entry);
+
+  /// @brief Evict least recently used built entries until within budget, never evicting the given
+  /// key unless it alone exceeds the budget; the mutex must be held
+  void Evict(const Key& keep);
+
+  /// @brief The memory budget
+  std::size_t MaxBytes_;
+  /// @brief The sum of the memory usage of built entries
+  std::size_t Bytes_ = 0;
+  /// @brief The cached entries
+  std::map<Key, Entry> Entries_;
+  /// @brief Keys from most to least recently used
+  std::list<Key> Recency_;
+  /// @brief Guards all of the above
+  mutable std::mutex Mutex_;
+};
+}  // namespace datalint
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <datalint/LayoutSpecification/LayoutPatch.h>
+#include <datalint/RuleSpecification/RulePatch.h>
+#include <datalint/Specification/CompiledSpecification.h>
+#include <datalint/Version/Version.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace datalint {
+
+/// @brief The specifications for every application version, compiled ahead of time. The endpoints
+/// of the version ranges of all layout and rule patches split the version line into intervals over
+/// which the set of applicable patches is constant. Each distinct set of patches is built once, and
+/// finding the specifications for a version is a binary search over the intervals, with no patch
+/// range checks. The layout of an interval is derived from the layout of the previous interval by
+/// replaying only the patches past their common prefix, so the layouts of all intervals share
+/// their storage and keeping them all costs roughly the size of the patches.
+class VersionedSpecifications {
+ public:
+  /// @brief Compile the specifications of all versions
+  /// @param layoutPatches the layout patches, in application order
+  /// @param rulePatches the rule patches, in application order
+  /// @throws std::logic_error if the ordering constraints of the layout of some version form a
+  /// cycle, as LayoutSpecificationBuilder::Build would for that version
+  VersionedSpecifications(std::span<const layout::LayoutPatch> layoutPatches,
+                          std::span<const rules::RulePatch> rulePatches);
+
+  /// @brief Return the specifications for the given version
+  /// @param version the application version
+  /// @return the shared, immutable specifications, identical to building the patches for the
+  /// version
+  const std::shared_ptr<const CompiledSpecification>& Find(const Version& version) const;
+
+  /// @brief The number of intervals the version line is split into
+  /// @return the number of intervals
+  std::size_t IntervalCount() const noexcept;
+
+  /// @brief The first version of an interval; intervals are sorted and the first one starts at
+  /// 0.0.0
+  /// @param index the index of the interval, less than IntervalCount()
+  /// @return the first version of the interval
+  Version IntervalStart(std::size_t index) const;
+
+  /// @brief The specifications of an interval
+  /// @param index the index of the interval, less than IntervalCount()
+  /// @return the shared, immutable specifications, the same instance for intervals with the same
+  /// patches
+  const std::shared_ptr<const CompiledSpecification>& IntervalSpecification(
+      std::size_t index) const;
+
+  /// @brief The number of distinct specifications built, at most IntervalCount()
+  /// @return the number of distinct specifications
+  std::size_t SpecificationCount() const noexcept;
+
+ private:
+  /// @brief The packed first version of each interval, sorted; the first one is 0.0.0
+  std::vector<std::uint64_t> IntervalStarts_;
+  /// @brief The specifications of each interval, shared between intervals with the same patches
+  std::vector<std::shared_ptr<const CompiledSpecification>> IntervalSpecifications_;
+  /// @brief The number of distinct specifications
+  std::size_t SpecificationCount_ = 0;
+};
+}  // namespace datalint
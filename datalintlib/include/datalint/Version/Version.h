@@ -1,98 +1,223 @@
 #pragma once
 
-#include <charconv>
+#include <compare>
+#include <cstdint>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 
 namespace datalint {
-/// @brief Class to contain a version definition
+
+/// @brief Reasons for which a version string cannot be parsed
+enum class VersionParseError {
+  /// @brief The string is not made of three components separated by dots
+  InvalidFormat,
+  /// @brief A component has no digits
+  EmptyComponent,
+  /// @brief A component contains a character other than a digit
+  InvalidComponent,
+  /// @brief A component is negative
+  NegativeComponent,
+  /// @brief A component is larger than Version::kMaxComponent
+  ComponentOutOfRange
+};
+
+/// @brief Description of a version parse error
+/// @param error the parse error
+/// @return the description of the error
+constexpr std::string_view ToString(VersionParseError error) {
+  switch (error) {
+    case VersionParseError::InvalidFormat:
+      return "Invalid version format";
+    case VersionParseError::EmptyComponent:
+      return "Empty version component";
+    case VersionParseError::InvalidComponent:
+      return "Invalid version component";
+    case VersionParseError::NegativeComponent:
+      return "Negative version component";
+    case VersionParseError::ComponentOutOfRange:
+      return "Version component out of range";
+  }
+  return "Unhandled version parse error";
+}
+
+// Forward declaration
+class VersionParseResult;
+
+/// @brief Class to contain a version definition. The three components are packed into a single
+/// 64-bit integer whose ordering is the version ordering, so comparing two versions is one integer
+/// compare. Each component therefore has 21 bits: components are limited to kMaxComponent
+/// (2,097,151), so e.g. date-based components such as 20240101 are rejected.
 class Version {
  public:
+  /// @brief The largest value of a version component, 2^21 - 1
+  static constexpr int kMaxComponent = (1 << 21) - 1;
+
   /// @brief Constructor: must provide all members
   /// @param major The major version number
   /// @param minor The minor version number
   /// @param patch The patch version number
-  /// @throws std::invalid_argument if any of the version components are negative
-  Version(int major, int minor, int patch) {
+  /// @throws std::invalid_argument if any of the version components are negative or larger than
+  /// kMaxComponent
+  constexpr Version(int major, int minor, int patch) {
     if (major < 0 || minor < 0 || patch < 0) {
       throw std::invalid_argument("Version components must be non-negative");
     }
-    Major_ = major;
-    Minor_ = minor;
-    Patch_ = patch;
+    if (major > kMaxComponent || minor > kMaxComponent || patch > kMaxComponent) {
+      throw std::invalid_argument("Version components must be at most " +
+                                  std::to_string(kMaxComponent));
+    }
+    Packed_ = Pack(major, minor, patch);
   }
 
   /// @brief Major version number. The first of the numbers, i.e. HERE.x.x
   /// @return The major version number
-  int Major() const { return Major_; }
+  constexpr int Major() const { return static_cast<int>(Packed_ >> (2 * kComponentBits)); }
   /// @brief Minor version number. The second of the numbers, i.e. x.HERE.x
   /// @return The minor version number
-  int Minor() const { return Minor_; }
+  constexpr int Minor() const {
+    return static_cast<int>((Packed_ >> kComponentBits) & kComponentMask);
+  }
   /// @brief Patch version number. The third of the numbers, i.e. x.x.HERE
   /// @return The patch version number
-  int Patch() const { return Patch_; }
+  constexpr int Patch() const { return static_cast<int>(Packed_ & kComponentMask); }
+
+  /// @brief The packed representation: major, minor and patch in consecutive 21-bit fields, most
+  /// significant first. Versions compare as their packed representations do.
+  /// @return The packed representation
+  constexpr std::uint64_t Packed() const { return Packed_; }
+
+  /// @brief Create a version from its packed representation
+  /// @param packed The packed representation, as returned by Packed()
+  /// @return The version
+  /// @throws std::invalid_argument if the bits above the three components are set
+  static constexpr Version FromPacked(std::uint64_t packed) {
+    if (packed >> (3 * kComponentBits) != 0) {
+      throw std::invalid_argument("Invalid packed version");
+    }
+    return Version(static_cast<int>(packed >> (2 * kComponentBits)),
+                   static_cast<int>((packed >> kComponentBits) & kComponentMask),
+                   static_cast<int>(packed & kComponentMask));
+  }
 
-  friend auto operator<=>(const Version&, const Version&) = default;
+  friend constexpr auto operator<=>(const Version&, const Version&) = default;
+
+  /// @brief Parse a version string without throwing
+  /// @param str The version string to parse (format: "major.minor.patch")
+  /// @return The parsed Version object, or the reason the string could not be parsed
+  static constexpr VersionParseResult TryParse(std::string_view str);
 
   /// @brief Parse a version string into a Version object
   /// @param str The version string to parse (format: "major.minor.patch")
   /// @return The parsed Version object
   /// @throws std::invalid_argument if the string is not in the correct format or contains invalid
-  /// (negative) numbers
-  static Version Parse(std::string_view str) {
-    int major = 0;
-    int minor = 0;
-    int patch = 0;
-
-    auto parseInt = [](std::string_view token) -> int {
-      if (token.empty()) {
-        throw std::invalid_argument("Empty version component");
-      }
+  /// (negative, or larger than kMaxComponent) numbers
+  static constexpr Version Parse(std::string_view str);
 
-      int value = 0;
-      auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
-
-      if (ec != std::errc{} || ptr != token.data() + token.size()) {
-        throw std::invalid_argument("Invalid version component");
-      }
-      if (value < 0) {
-        throw std::invalid_argument("Negative version component");
-      }
+ private:
+  /// @brief The number of bits of each component in the packed representation
+  static constexpr int kComponentBits = 21;
+  /// @brief The mask of one component in the packed representation
+  static constexpr std::uint64_t kComponentMask = (std::uint64_t{1} << kComponentBits) - 1;
+
+  /// @brief Pack valid components
+  static constexpr std::uint64_t Pack(int major, int minor, int patch) {
+    return (static_cast<std::uint64_t>(major) << (2 * kComponentBits)) |
+           (static_cast<std::uint64_t>(minor) << kComponentBits) |
+           static_cast<std::uint64_t>(patch);
+  }
 
-      return value;
-    };
+  /// @brief Major, minor and patch, packed
+  std::uint64_t Packed_;
+};
 
-    // Parse major
-    std::size_t pos1 = str.find('.');
-    if (pos1 == std::string_view::npos) {
-      throw std::invalid_argument("Invalid version format");
+/// @brief Result of Version::TryParse: either a version or the reason parsing failed
+class VersionParseResult {
+ public:
+  /// @brief Constructor for a successful parse
+  /// @param version the parsed version
+  constexpr VersionParseResult(Version version) : Version_(version) {}
+  /// @brief Constructor for a failed parse
+  /// @param error the reason parsing failed
+  constexpr VersionParseResult(VersionParseError error) : Error_(error) {}
+
+  /// @brief Whether parsing succeeded
+  /// @return true for a version was parsed
+  constexpr bool has_value() const { return Version_.has_value(); }
+  /// @brief Whether parsing succeeded
+  constexpr explicit operator bool() const { return has_value(); }
+
+  /// @brief The parsed version
+  /// @return the parsed version
+  /// @throws std::invalid_argument with the parse error description if parsing failed
+  constexpr const Version& value() const {
+    if (!Version_) {
+      throw std::invalid_argument(std::string(ToString(Error_)));
     }
+    return *Version_;
+  }
+  /// @brief The parsed version; parsing must have succeeded
+  constexpr const Version& operator*() const { return *Version_; }
+  /// @brief Member access on the parsed version; parsing must have succeeded
+  constexpr const Version* operator->() const { return &*Version_; }
 
-    major = parseInt(str.substr(0, pos1));
-    str.remove_prefix(pos1 + 1);
+  /// @brief The reason parsing failed; parsing must have failed
+  /// @return the parse error
+  constexpr VersionParseError error() const { return Error_; }
 
-    // Parse minor
-    std::size_t pos2 = str.find('.');
-    if (pos2 == std::string_view::npos) {
-      throw std::invalid_argument("Invalid version format");
-    }
+ private:
+  /// @brief The parsed version, if parsing succeeded
+  std::optional<Version> Version_;
+  /// @brief The reason parsing failed, meaningful only if it did
+  VersionParseError Error_ = VersionParseError::InvalidFormat;
+};
 
-    minor = parseInt(str.substr(0, pos2));
-    str.remove_prefix(pos2 + 1);
+constexpr VersionParseResult Version::TryParse(std::string_view str) {
+  int components[3] = {0, 0, 0};
 
-    // Parse patch (must consume entire remainder)
-    patch = parseInt(str);
+  for (int i = 0; i < 3; ++i) {
+    // The first two components end at a dot, the patch consumes the entire remainder
+    std::string_view token = str;
+    if (i < 2) {
+      const std::size_t pos = str.find('.');
+      if (pos == std::string_view::npos) {
+        return VersionParseError::InvalidFormat;
+      }
+      token = str.substr(0, pos);
+      str.remove_prefix(pos + 1);
+    }
+
+    if (token.empty()) {
+      return VersionParseError::EmptyComponent;
+    }
+    if (token.front() == '-') {
+      token.remove_prefix(1);
+      if (token.empty() || token.find_first_not_of("0123456789") != std::string_view::npos) {
+        return VersionParseError::InvalidComponent;
+      }
+      // A negative zero such as "-0" is zero, as std::from_chars reads it
+      if (token.find_first_not_of('0') != std::string_view::npos) {
+        return VersionParseError::NegativeComponent;
+      }
+    }
 
-    return Version(major, minor, patch);
+    int value = 0;
+    for (const char c : token) {
+      if (c < '0' || c > '9') {
+        return VersionParseError::InvalidComponent;
+      }
+      value = value * 10 + (c - '0');
+      if (value > kMaxComponent) {
+        return VersionParseError::ComponentOutOfRange;
+      }
+    }
+    components[i] = value;
   }
 
- private:
-  /// @brief Major version number. The first of the numbers, i.e. HERE.x.x
-  int Major_;
-  /// @brief Minor version number. The second of the numbers, i.e. x.HERE.x
-  int Minor_;
-  /// @brief Patch version number. The third of the numbers, i.e. x.x.HERE
-  int Patch_;
-};
+  return Version(components[0], components[1], components[2]);
+}
+
+constexpr Version Version::Parse(std::string_view str) { return TryParse(str).value(); }
+
 }  // namespace datalint
@@ -2,6 +2,7 @@
 
 #include <datalint/Version/Version.h>
 
+#include <cstdint>
 #include <optional>
 #include <stdexcept>
 
@@ -13,62 +14,85 @@ class VersionRange {
   /// @param min The lower bound of the range, if any
   /// @param max The upper bound of the range, if any
   /// @throws std::invalid_argument if min > max
-  VersionRange(std::optional<Version> min, std::optional<Version> max)
-      : Min_(std::move(min)), Max_(std::move(max)) {
-    if (Min_ && Max_ && *Min_ > *Max_) {
+  constexpr VersionRange(std::optional<Version> min, std::optional<Version> max)
+      : Min_(min),
+        Max_(max),
+        MinPacked_(min ? min->Packed() : 0),
+        MaxPacked_(max ? max->Packed() : UINT64_MAX) {
+    if (MinPacked_ > MaxPacked_) {
       throw std::invalid_argument("VersionRange: Min cannot be greater than Max");
     }
   }
   /// @brief Getter for the lower bound of the range, if any
   /// @return The lower bound of the range, if any
-  std::optional<Version> Min() const { return Min_; }
+  constexpr std::optional<Version> Min() const { return Min_; }
   /// @brief Getter for the upper bound of the range, if any
   /// @return The upper bound of the range, if any
-  std::optional<Version> Max() const { return Max_; }
+  constexpr std::optional<Version> Max() const { return Max_; }
 
   /// @brief Whether the incoming version belongs to the range defined by this version range
   /// @param v incoming version
   /// @return true for the incoming version belongs to the range defined by this version range
   /// instance
-  bool Contains(const Version& v) const {
-    if (Min_ && v < *Min_) return false;
-    if (Max_ && v > *Max_) return false;
-    return true;
+  constexpr bool Contains(const Version& v) const {
+    return v.Packed() >= MinPacked_ && v.Packed() <= MaxPacked_;
+  }
+
+  /// @brief Whether every version of the other range belongs to this range
+  /// @param other the other range
+  /// @return true for the other range is a subset of this range
+  constexpr bool Includes(const VersionRange& other) const {
+    return other.MinPacked_ >= MinPacked_ && other.MaxPacked_ <= MaxPacked_;
+  }
+
+  /// @brief Whether some version belongs to both ranges
+  /// @param other the other range
+  /// @return true for the ranges intersect
+  constexpr bool Overlaps(const VersionRange& other) const {
+    return other.MinPacked_ <= MaxPacked_ && MinPacked_ <= other.MaxPacked_;
   }
 
   /// @brief Version range representing all versions
   /// @return VersionRange representing all versions
-  static VersionRange All() { return VersionRange(std::nullopt, std::nullopt); }
+  static constexpr VersionRange All() { return VersionRange(std::nullopt, std::nullopt); }
 
   /// @brief Version range starting at the incoming version, inclusive
   /// @param min the lower bound version
   /// @return the VersionRange starting at the incoming version, inclusive
-  static VersionRange From(const Version& min) { return VersionRange(min, std::nullopt); }
+  static constexpr VersionRange From(const Version& min) { return VersionRange(min, std::nullopt); }
 
   /// @brief Version range ending at the incoming version, inclusive
   /// @param max the upper bound version
   /// @return the VersionRange ending at the incoming version, inclusive
-  static VersionRange Until(const Version& max) { return VersionRange(std::nullopt, max); }
+  static constexpr VersionRange Until(const Version& max) {
+    return VersionRange(std::nullopt, max);
+  }
 
   /// @brief Version range between the incoming min and max versions, inclusive
   /// @param min the lower bound version, inclusive
   /// @param max the upper bound version, inclusive
   /// @return the VersionRange between the incoming min and max versions, inclusive
   /// @throws std::invalid_argument if min > max
-  static VersionRange Between(const Version& min, const Version& max) {
+  static constexpr VersionRange Between(const Version& min, const Version& max) {
     return VersionRange(min, max);
   }
 
-  friend bool operator==(const VersionRange& lhs, const VersionRange& rhs) {
+  friend constexpr bool operator==(const VersionRange& lhs, const VersionRange& rhs) {
     return lhs.Min_ == rhs.Min_ && lhs.Max_ == rhs.Max_;
   }
 
-  friend bool operator!=(const VersionRange& lhs, const VersionRange& rhs) { return !(lhs == rhs); }
+  friend constexpr bool operator!=(const VersionRange& lhs, const VersionRange& rhs) {
+    return !(lhs == rhs);
+  }
 
  private:
   /// @brief The lower bound of the range, if any
   std::optional<Version> Min_;
   /// @brief The upper bound of the range, if any
   std::optional<Version> Max_;
+  /// @brief The packed lower bound, 0 for none
+  std::uint64_t MinPacked_;
+  /// @brief The packed upper bound, UINT64_MAX for none
+  std::uint64_t MaxPacked_;
 };
 }  // namespace datalint
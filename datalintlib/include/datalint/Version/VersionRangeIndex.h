@@ -0,0 +1,59 @@
+#pragma once
+
+#include <datalint/Version/Version.h>
+#include <datalint/Version/VersionRange.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace datalint {
+
+/// @brief Index over a list of version ranges, e.g. those of a list of patches, answering which
+/// ranges contain a given version without testing every range. The range endpoints split the
+/// version line into elementary intervals; each range is stored at the O(log P) nodes of a segment
+/// tree over those intervals that exactly cover it. A query locates the elementary interval of the
+/// version by binary search and collects the ranges stored on the path from its leaf to the root,
+/// in O(log P + k) plus the O(k log k) sort restoring list order.
+class VersionRangeIndex {
+ public:
+  /// @brief Build the index over the given ranges
+  /// @param ranges the ranges; queries return positions in this list
+  explicit VersionRangeIndex(std::span<const VersionRange> ranges);
+
+  /// @brief Build the index over the version ranges of the given patches
+  /// @tparam Patches a range of patches with an AppliesTo() returning their version range
+  /// @param patches the patches; queries return positions in this list
+  /// @return the index
+  template <typename Patches>
+  static VersionRangeIndex ForPatches(const Patches& patches) {
+    std::vector<VersionRange> ranges;
+    ranges.reserve(patches.size());
+    for (const auto& patch : patches) {
+      ranges.push_back(patch.AppliesTo());
+    }
+    return VersionRangeIndex(ranges);
+  }
+
+  /// @brief The positions of the ranges containing the given version, in ascending order
+  /// @param version the version
+  /// @return the positions of the matching ranges
+  std::vector<std::size_t> Find(const Version& version) const;
+
+  /// @brief The number of indexed ranges
+  /// @return the number of ranges
+  std::size_t Size() const noexcept;
+
+ private:
+  /// @brief The packed first version of each elementary interval, sorted; the first one is 0.0.0
+  std::vector<std::uint64_t> IntervalStarts_;
+  /// @brief The number of leaves of the segment tree, a power of two
+  std::size_t LeafCount_ = 1;
+  /// @brief The range positions stored at each node of the segment tree, node 1 being the root and
+  /// node LeafCount_ + i the leaf of elementary interval i
+  std::vector<std::vector<std::uint32_t>> Nodes_;
+  /// @brief The number of indexed ranges
+  std::size_t Size_ = 0;
+};
+}  // namespace datalint
@@ -2,30 +2,42 @@
 #include <datalint/ApplicationDescriptor/DefaultCsvApplicationDescriptorResolver.h>
 #include <datalint/ApplicationDescriptor/ResolveError.h>
 #include <datalint/ApplicationDescriptor/ResolveResult.h>
+#include <datalint/FileParser/CsvFileParser.h>
 #include <datalint/RawData.h>
 #include <datalint/RawField.h>
+#include <datalint/SmallKey.h>
 #include <datalint/Version/Version.h>
 
+#include <algorithm>
+#include <array>
+#include <memory_resource>
+
 namespace {
 const std::string kApplicationNameKey = "ApplicationName";
 const std::string kApplicationVersionKey = "ApplicationVersion";
+// The descriptor fields are expected in the first lines, so start small
+constexpr std::size_t kInitialPrefixBytes = 4 * 1024;
 }  // namespace
 
 namespace datalint {
 ResolveResult DefaultCsvApplicationDescriptorResolver::Resolve(const datalint::RawData& rawData) {
   datalint::ResolveResult result;
-  if (!rawData.HasKey(kApplicationNameKey)) {
+  // One sweep over the fields finds both keys
+  const std::array<SmallKey, 2> keys{SmallKey(kApplicationNameKey),
+                                     SmallKey(kApplicationVersionKey)};
+  const auto occurrences = rawData.FindKeys(keys);
+  const auto& nameFields = occurrences[0].Fields;
+  const auto& versionFields = occurrences[1].Fields;
+  if (nameFields.empty()) {
     result.Errors.push_back(
         ResolveError{ResolveErrorCode::MissingRequiredField, kApplicationNameKey, ""});
     return result;
   }
-  if (!rawData.HasKey(kApplicationVersionKey)) {
+  if (versionFields.empty()) {
     result.Errors.push_back(
         ResolveError{ResolveErrorCode::MissingRequiredField, kApplicationVersionKey, ""});
     return result;
   }
-  const auto nameFields = rawData.GetFieldsByKey(kApplicationNameKey);
-  const auto versionFields = rawData.GetFieldsByKey(kApplicationVersionKey);
   if (nameFields.size() > 1) {
     result.Errors.push_back(
         ResolveError{ResolveErrorCode::DuplicateField, kApplicationNameKey, ""});
@@ -38,25 +50,42 @@ ResolveResult DefaultCsvApplicationDescriptorResolver::Resolve(const datalint::R
   }
   // in our example application, we know what our input file looks like
   // we just take the first occurrence of each field
-  auto getFirstCommaSeparatedValue = [](const std::string& s) -> std::string {
+  auto getFirstCommaSeparatedValue = [](std::string_view s) -> std::string {
     auto pos = s.find(',');
-    if (pos == std::string::npos) return s;  // no comma found
-    return s.substr(0, pos);
+    if (pos == std::string_view::npos) return std::string(s);  // no comma found
+    return std::string(s.substr(0, pos));
   };
   const auto name = getFirstCommaSeparatedValue(nameFields.front()->Value);
   const auto versionStr = getFirstCommaSeparatedValue(versionFields.front()->Value);
-  try {
-    const auto version = datalint::Version::Parse(versionStr);
-    result.Descriptor = ApplicationDescriptor{name, version};
-    return result;
-  } catch (const std::invalid_argument& e) {
-    result.Errors.push_back(
-        ResolveError{ResolveErrorCode::ParsingError, kApplicationVersionKey, e.what()});
-    return result;
-  } catch (const std::exception& e) {
-    result.Errors.push_back(
-        ResolveError{ResolveErrorCode::UnknownError, "ApplicationDescriptor", e.what()});
+  const auto version = datalint::Version::TryParse(versionStr);
+  if (!version) {
+    result.Errors.push_back(ResolveError{ResolveErrorCode::ParsingError, kApplicationVersionKey,
+                                         std::string(ToString(version.error()))});
     return result;
   }
+  result.Descriptor = ApplicationDescriptor{name, *version};
+  return result;
+}
+
+ResolveResult DefaultCsvApplicationDescriptorResolver::ResolveFromPrefix(
+    const std::filesystem::path& file, std::size_t maxBytes) {
+  // The prefix is only needed until the descriptor is resolved
+  std::pmr::monotonic_buffer_resource arena;
+  datalint::input::CsvFileParser parser(&arena);
+
+  std::error_code ec;
+  const auto fileSize = std::filesystem::file_size(file, ec);
+  const std::size_t limit = ec ? maxBytes : std::min<std::size_t>(maxBytes, fileSize);
+
+  // Double the prefix until both fields are found; the total bytes read stay below 2 * limit
+  std::size_t prefixBytes = std::min(kInitialPrefixBytes, limit);
+  while (true) {
+    const auto prefix = parser.ParsePrefix(file, prefixBytes);
+    if ((prefix.HasKey(kApplicationNameKey) && prefix.HasKey(kApplicationVersionKey)) ||
+        prefixBytes >= limit) {
+      return Resolve(prefix);
+    }
+    prefixBytes = std::min(prefixBytes * 2, limit);
+  }
 }
 }  // namespace datalint
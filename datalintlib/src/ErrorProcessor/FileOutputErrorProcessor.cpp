@@ -7,7 +7,7 @@ namespace datalint::error_processor {
 FileOutputErrorProcessor::FileOutputErrorProcessor(const std::filesystem::path& path)
     : OutputPath_(path) {}
 
-void FileOutputErrorProcessor::Process(const std::vector<datalint::error::ErrorLog>& errors) const {
+void FileOutputErrorProcessor::Process(std::span<const datalint::error::ErrorLog> errors) const {
   // Write the errors to the output file
   std::ofstream out(OutputPath_, std::ios::out | std::ios::trunc);
   if (!out.is_open()) {
@@ -2,22 +2,31 @@
 
 namespace datalint::fieldparser {
 ParsedField CsvFieldParser::ParseFieldValue(const RawField& rawFieldValue) const {
-  ParsedField parsedField;
-  parsedField.Key = rawFieldValue.Key;
+  // Allocate from the same memory resource as the raw field, so that a per-file arena also backs
+  // the parsed data
+  std::pmr::memory_resource* resource = rawFieldValue.Value.get_allocator().resource();
+  ParsedField parsedField{rawFieldValue.Key,
+                          std::pmr::vector<RawValue>(resource)};
 
-  std::string currentValue;
-  for (size_t i = 0; i < rawFieldValue.Value.size(); ++i) {
-    char c = rawFieldValue.Value[i];
-    if (c == ',') {
+  auto makeValue = [&](std::string_view value) {
+    return RawValue{
+        std::pmr::string(value, resource),
+        SourceLocation{std::pmr::string(rawFieldValue.Location.Filename, resource),
+                       rawFieldValue.Location.Line},
+    };
+  };
+
+  const std::string_view value = rawFieldValue.Value;
+  std::size_t start = 0;
+  for (std::size_t i = 0; i < value.size(); ++i) {
+    if (value[i] == ',') {
       // Found a delimiter, store the current value
-      parsedField.Values.push_back(RawValue{currentValue, rawFieldValue.Location});
-      currentValue.clear();
-    } else {
-      currentValue += c;
+      parsedField.Values.push_back(makeValue(value.substr(start, i - start)));
+      start = i + 1;
     }
   }
   // Always add the last value (may be empty after trailing comma)
-  parsedField.Values.push_back(RawValue{currentValue, rawFieldValue.Location});
+  parsedField.Values.push_back(makeValue(value.substr(start)));
 
   return parsedField;
 }
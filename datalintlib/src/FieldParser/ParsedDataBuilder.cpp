@@ -7,7 +7,7 @@ ParsedDataBuilder::ParsedDataBuilder(std::unique_ptr<IFieldParser> fieldparser)
     : FieldParser_(std::move(fieldparser)) {}
 
 ParsedData ParsedDataBuilder::Build(const RawData& rawData) const {
-  std::vector<ParsedField> parsedFields;
+  std::pmr::vector<ParsedField> parsedFields(rawData.Resource());
   parsedFields.reserve(rawData.Fields().size());
   for (const RawField& rawField : rawData.Fields()) {
     ParsedField parsedField = FieldParser_->ParseFieldValue(rawField);
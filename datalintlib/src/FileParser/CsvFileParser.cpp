@@ -12,17 +12,19 @@
 
 namespace datalint::input {
 
-datalint::RawData CsvFileParser::Parse(const std::filesystem::path& file) {
-  std::vector<RawField> fields;
-
-  csv2::Reader<csv2::delimiter<','>, csv2::quote_character<'"'>, csv2::first_row_is_header<false> >
-      reader;
-
-  if (!reader.mmap(file.string())) {
-    throw std::runtime_error("Failed to open CSV file: " + file.string());
-  }
-
+namespace {
+using Reader = csv2::Reader<csv2::delimiter<','>, csv2::quote_character<'"'>,
+                            csv2::first_row_is_header<false> >;
+
+/// @brief Convert the rows of a reader to raw data: the first column is the key, the remaining
+/// columns are joined with commas into the value
+datalint::RawData ReadRows(Reader& reader, const std::string& filename,
+                           std::pmr::memory_resource* resource, KeyFilterPolicy keyFilterPolicy) {
+  std::pmr::vector<RawField> fields(resource);
   std::size_t lineNumber = 0;
+  // Scratch buffers reused across rows
+  std::string keyText;
+  std::string cell;
 
   for (const auto& row : reader) {
     ++lineNumber;
@@ -33,16 +35,16 @@ datalint::RawData CsvFileParser::Parse(const std::filesystem::path& file) {
     }
 
     // First column → key
-    std::string key;
-    (*it).read_value(key);
+    keyText.clear();
+    (*it).read_value(keyText);
     ++it;
 
     // Remaining columns → single value string
-    std::string value;
+    std::pmr::string value(resource);
     bool first = true;
 
     for (; it != row.end(); ++it) {
-      std::string cell;
+      cell.clear();
       (*it).read_value(cell);
 
       if (!first) {
@@ -52,15 +54,74 @@ datalint::RawData CsvFileParser::Parse(const std::filesystem::path& file) {
       first = false;
     }
 
-    RawField field;
-    field.Key = std::move(key);
-    field.Value = std::move(value);
-    field.Location.Filename = file.string();
-    field.Location.Line = static_cast<int>(lineNumber);
+    RawField field{SmallKey(keyText, resource), std::move(value),
+                   SourceLocation{std::pmr::string(filename, resource),
+                                  static_cast<int>(lineNumber)}};
 
     fields.push_back(std::move(field));
   }
 
-  return RawData(std::move(fields));
+  return RawData(std::move(fields), keyFilterPolicy);
+}
+}  // namespace
+
+datalint::RawData CsvFileParser::Parse(const std::filesystem::path& file) {
+  const std::string filename = file.string();
+  Reader reader;
+
+  if (!reader.mmap(filename)) {
+    throw std::runtime_error("Failed to open CSV file: " + filename);
+  }
+
+  return ReadRows(reader, filename, Resource_, KeyFilterPolicy_);
+}
+
+datalint::RawData CsvFileParser::ParsePrefix(const std::filesystem::path& file,
+                                             std::size_t maxBytes) {
+  const std::string filename = file.string();
+  std::ifstream in(file, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("Failed to open CSV file: " + filename);
+  }
+
+  std::string prefix(maxBytes, '\0');
+  in.read(prefix.data(), static_cast<std::streamsize>(maxBytes));
+  prefix.resize(static_cast<std::size_t>(in.gcount()));
+
+  // Unless the whole file fit, drop the last line: it may have been cut off by the byte limit
+  if (in.peek() != std::char_traits<char>::eof()) {
+    const auto lastNewline = prefix.find_last_of('\n');
+    prefix.resize(lastNewline == std::string::npos ? 0 : lastNewline + 1);
+  }
+
+  Reader reader;
+  reader.parse(prefix);
+  return ReadRows(reader, filename, Resource_, KeyFilterPolicy_);
 }
+
+std::size_t CsvFileParser::ScanKeys(const std::filesystem::path& file,
+                                    const std::function<void(std::string_view key)>& visitor) {
+  const std::string filename = file.string();
+  Reader reader;
+
+  if (!reader.mmap(filename)) {
+    throw std::runtime_error("Failed to open CSV file: " + filename);
+  }
+
+  // Only the first column of each row is read, into a scratch buffer reused across rows
+  std::size_t keyCount = 0;
+  std::string keyText;
+  for (const auto& row : reader) {
+    auto it = row.begin();
+    if (!(it != row.end())) {
+      continue;  // empty row
+    }
+    keyText.clear();
+    (*it).read_value(keyText);
+    visitor(keyText);
+    ++keyCount;
+  }
+  return keyCount;
+}
+
 }  // namespace datalint::input
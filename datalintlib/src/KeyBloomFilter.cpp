@@ -0,0 +1,67 @@
+#include <datalint/KeyBloomFilter.h>
+
+#include <algorithm>
+
+namespace {
+/// @brief Number of filter bits budgeted per key; keeps the false positive rate below 1%
+constexpr std::size_t kBitsPerKey = 12;
+/// @brief Number of bits in a block
+constexpr std::size_t kBitsPerBlock = 256;
+
+/// @brief Odd constants used to derive the eight bit positions of a key from one hash
+constexpr std::uint32_t kSalts[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                     0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+/// @brief Finalizer spreading the key hash over all 64 bits
+std::uint64_t Mix(std::uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+}  // namespace
+
+namespace datalint {
+
+KeyBloomFilter::KeyBloomFilter(std::size_t expectedKeys, std::pmr::memory_resource* resource)
+    : Blocks_(std::max<std::size_t>(1, (expectedKeys * kBitsPerKey + kBitsPerBlock - 1) /
+                                           kBitsPerBlock),
+              Block{}, resource) {}
+
+void KeyBloomFilter::Insert(const SmallKey& key) {
+  const std::uint64_t hash = Mix(key.Hash());
+  Block& block = Blocks_[BlockIndex(hash)];
+  const auto mask = Mask(hash);
+  for (std::size_t i = 0; i < mask.size(); ++i) {
+    block.Words[i] |= mask[i];
+  }
+}
+
+bool KeyBloomFilter::MayContain(const SmallKey& key) const {
+  const std::uint64_t hash = Mix(key.Hash());
+  const Block& block = Blocks_[BlockIndex(hash)];
+  const auto mask = Mask(hash);
+  // No early exit: the fixed-length loop compiles to a few vector operations
+  std::uint32_t missing = 0;
+  for (std::size_t i = 0; i < mask.size(); ++i) {
+    missing |= mask[i] & ~block.Words[i];
+  }
+  return missing == 0;
+}
+
+std::size_t KeyBloomFilter::BlockIndex(std::uint64_t hash) const noexcept {
+  // Multiply-shift maps the upper half of the hash onto [0, block count) without a division
+  return static_cast<std::size_t>(((hash >> 32) * Blocks_.size()) >> 32);
+}
+
+std::array<std::uint32_t, 8> KeyBloomFilter::Mask(std::uint64_t hash) noexcept {
+  const auto low = static_cast<std::uint32_t>(hash);
+  std::array<std::uint32_t, 8> mask{};
+  for (std::size_t i = 0; i < mask.size(); ++i) {
+    mask[i] = std::uint32_t{1} << ((low * kSalts[i]) >> 27);
+  }
+  return mask;
+}
+}  // namespace datalint
@@ -0,0 +1,227 @@
+#include <datalint/KeyPatternMatcher.h>
+
+#include <algorithm>
+#include <bitset>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+/// @brief A set of bytes
+using ByteSet = std::bitset<256>;
+
+/// @brief One element of a parsed pattern
+struct Atom {
+  /// @brief How many bytes of the set the atom matches
+  enum class Repetition { One, OneOrMore, AnyRun };
+
+  /// @brief The bytes matched
+  ByteSet Bytes;
+  /// @brief How many of them
+  Repetition Count;
+};
+
+/// @brief Throw for a malformed pattern
+[[noreturn]] void ThrowMalformed(std::string_view pattern, const std::string& reason) {
+  throw std::invalid_argument("KeyPatternMatcher: malformed pattern '" + std::string(pattern) +
+                              "': " + reason);
+}
+
+/// @brief Parse a pattern into its atoms
+std::vector<Atom> Parse(std::string_view pattern) {
+  std::vector<Atom> atoms;
+  for (std::size_t i = 0; i < pattern.size(); ++i) {
+    const char c = pattern[i];
+    if (c == '*') {
+      atoms.push_back(Atom{ByteSet().set(), Atom::Repetition::AnyRun});
+    } else if (c == '?') {
+      atoms.push_back(Atom{ByteSet().set(), Atom::Repetition::One});
+    } else if (c == '+') {
+      if (atoms.empty() || atoms.back().Count != Atom::Repetition::One) {
+        ThrowMalformed(pattern, "'+' must follow a character, '?' or a class");
+      }
+      atoms.back().Count = Atom::Repetition::OneOrMore;
+    } else if (c == '\\') {
+      if (++i == pattern.size()) {
+        ThrowMalformed(pattern, "trailing '\\'");
+      }
+      atoms.push_back(
+          Atom{ByteSet().set(static_cast<unsigned char>(pattern[i])), Atom::Repetition::One});
+    } else if (c == '[') {
+      ByteSet bytes;
+      std::size_t j = i + 1;
+      const bool negated = j < pattern.size() && (pattern[j] == '!' || pattern[j] == '^');
+      if (negated) {
+        ++j;
+      }
+      // A ']' first in the class is a member
+      for (bool first = true; j < pattern.size() && (first || pattern[j] != ']'); first = false) {
+        if (pattern[j] == '\\' && ++j == pattern.size()) {
+          break;
+        }
+        const auto low = static_cast<unsigned char>(pattern[j++]);
+        auto high = low;
+        if (j + 1 < pattern.size() && pattern[j] == '-' && pattern[j + 1] != ']') {
+          j += pattern[j + 1] == '\\' ? 2 : 1;
+          if (j == pattern.size()) {
+            break;
+          }
+          high = static_cast<unsigned char>(pattern[j++]);
+          if (high < low) {
+            ThrowMalformed(pattern, "reversed range in class");
+          }
+        }
+        for (unsigned byte = low; byte <= high; ++byte) {
+          bytes.set(byte);
+        }
+      }
+      if (j >= pattern.size()) {
+        ThrowMalformed(pattern, "unterminated class");
+      }
+      atoms.push_back(Atom{negated ? ~bytes : bytes, Atom::Repetition::One});
+      i = j;
+    } else {
+      atoms.push_back(Atom{ByteSet().set(static_cast<unsigned char>(c)), Atom::Repetition::One});
+    }
+  }
+  return atoms;
+}
+
+/// @brief State of the nondeterministic automaton
+struct NfaState {
+  /// @brief The transitions: the index of a byte set and the target state
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> Moves;
+  /// @brief The states reached without consuming a byte
+  std::vector<std::uint32_t> Epsilons;
+  /// @brief The pattern matched when the key ends in this state, if any
+  std::vector<std::uint32_t> Accepts;
+};
+
+/// @brief Sort the given states and add every state reachable from them by epsilon transitions
+void Close(const std::vector<NfaState>& states, std::vector<std::uint32_t>& set) {
+  std::vector<std::uint32_t> stack = std::move(set);
+  set.clear();
+  while (!stack.empty()) {
+    const std::uint32_t state = stack.back();
+    stack.pop_back();
+    set.push_back(state);
+    stack.insert(stack.end(), states[state].Epsilons.begin(), states[state].Epsilons.end());
+  }
+  std::sort(set.begin(), set.end());
+  set.erase(std::unique(set.begin(), set.end()), set.end());
+}
+}  // namespace
+
+namespace datalint {
+
+void KeyPatternMatcher::CheckSyntax(std::string_view pattern) { Parse(pattern); }
+
+KeyPatternMatcher::KeyPatternMatcher(std::span<const std::string_view> patterns)
+    : PatternCount_(patterns.size()) {
+  // One chain of states per pattern; the distinct byte sets are numbered as they appear
+  std::vector<NfaState> states;
+  std::vector<ByteSet> byteSets;
+  std::unordered_map<ByteSet, std::uint32_t> byteSetIds;
+  std::vector<std::uint32_t> starts;
+  for (std::uint32_t pattern = 0; pattern < patterns.size(); ++pattern) {
+    std::uint32_t current = static_cast<std::uint32_t>(states.size());
+    states.emplace_back();
+    starts.push_back(current);
+    for (const Atom& atom : Parse(patterns[pattern])) {
+      const auto [it, inserted] =
+          byteSetIds.try_emplace(atom.Bytes, static_cast<std::uint32_t>(byteSets.size()));
+      if (inserted) {
+        byteSets.push_back(atom.Bytes);
+      }
+      const std::uint32_t set = it->second;
+      const auto next = static_cast<std::uint32_t>(states.size());
+      states.emplace_back();
+      if (atom.Count == Atom::Repetition::AnyRun) {
+        states[current].Epsilons.push_back(next);
+      } else {
+        states[current].Moves.emplace_back(set, next);
+      }
+      if (atom.Count != Atom::Repetition::One) {
+        states[next].Moves.emplace_back(set, next);
+      }
+      current = next;
+    }
+    states[current].Accepts.push_back(pattern);
+  }
+
+  // Split the bytes into the classes no byte set tells apart
+  std::array<std::uint32_t, 256> classes{};
+  std::size_t classCount = 1;
+  for (const ByteSet& set : byteSets) {
+    std::map<std::pair<std::uint32_t, bool>, std::uint32_t> refined;
+    for (std::size_t byte = 0; byte < 256; ++byte) {
+      classes[byte] = refined
+                          .try_emplace({classes[byte], set[byte]},
+                                       static_cast<std::uint32_t>(refined.size()))
+                          .first->second;
+    }
+    classCount = refined.size();
+  }
+  ClassCount_ = classCount;
+  std::vector<std::uint8_t> representatives(ClassCount_);
+  for (std::size_t byte = 256; byte-- > 0;) {
+    ByteClasses_[byte] = static_cast<std::uint8_t>(classes[byte]);
+    representatives[classes[byte]] = static_cast<std::uint8_t>(byte);
+  }
+
+  // Subset construction: each state is a set of states of the nondeterministic automaton, the
+  // empty set rejecting
+  std::vector<std::vector<std::uint32_t>> sets{{}, starts};
+  Close(states, sets[1]);
+  std::map<std::vector<std::uint32_t>, std::uint32_t> ids{{sets[0], 0}, {sets[1], 1}};
+  Transitions_.assign(ClassCount_, 0);
+  MatchOffsets_.push_back(0);
+  for (std::size_t id = 1; id < sets.size(); ++id) {
+    std::vector<std::vector<std::uint32_t>> targets(ClassCount_);
+    std::vector<std::uint32_t> accepts;
+    for (const std::uint32_t state : sets[id]) {
+      for (const auto& [set, target] : states[state].Moves) {
+        for (std::size_t c = 0; c < ClassCount_; ++c) {
+          if (byteSets[set][representatives[c]]) {
+            targets[c].push_back(target);
+          }
+        }
+      }
+      accepts.insert(accepts.end(), states[state].Accepts.begin(), states[state].Accepts.end());
+    }
+    std::sort(accepts.begin(), accepts.end());
+    Matches_.insert(Matches_.end(), accepts.begin(), accepts.end());
+    MatchOffsets_.push_back(static_cast<std::uint32_t>(Matches_.size()));
+
+    for (auto& target : targets) {
+      Close(states, target);
+      const auto [it, inserted] = ids.try_emplace(target, static_cast<std::uint32_t>(sets.size()));
+      if (inserted) {
+        if (sets.size() == kMaxStates) {
+          throw std::invalid_argument("KeyPatternMatcher: the patterns need more than " +
+                                      std::to_string(kMaxStates) + " states");
+        }
+        sets.push_back(std::move(target));
+      }
+      Transitions_.push_back(it->second);
+    }
+  }
+}
+
+std::span<const std::uint32_t> KeyPatternMatcher::Match(std::string_view key) const noexcept {
+  if (PatternCount_ == 0) {
+    return {};
+  }
+  std::uint32_t state = 1;
+  for (const char c : key) {
+    state = Transitions_[state * ClassCount_ + ByteClasses_[static_cast<unsigned char>(c)]];
+    if (state == 0) {
+      return {};
+    }
+  }
+  return std::span<const std::uint32_t>(Matches_).subspan(
+      MatchOffsets_[state], MatchOffsets_[state + 1] - MatchOffsets_[state]);
+}
+}  // namespace datalint
@@ -0,0 +1,72 @@
+#include <datalint/KeyPrefixIndex.h>
+#include <datalint/RawDataColumns.h>
+
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+
+namespace datalint {
+
+KeyPrefixIndex::KeyPrefixIndex(const RawDataColumns& columns, std::pmr::memory_resource* resource)
+    : SortedIds_(resource),
+      KeyBuffer_(resource),
+      KeyOffsets_(resource),
+      CumulativeCounts_(resource) {
+  const auto& keys = columns.Keys();
+  SortedIds_.resize(keys.Size());
+  std::iota(SortedIds_.begin(), SortedIds_.end(), KeyId{0});
+  std::sort(SortedIds_.begin(), SortedIds_.end(),
+            [&keys](KeyId lhs, KeyId rhs) { return keys.Key(lhs) < keys.Key(rhs); });
+
+  // Copy the keys in sorted order, so that the binary searches walk one buffer
+  KeyOffsets_.reserve(SortedIds_.size() + 1);
+  for (const KeyId id : SortedIds_) {
+    KeyOffsets_.push_back(KeyBuffer_.size());
+    KeyBuffer_ += keys.Key(id);
+  }
+  KeyOffsets_.push_back(KeyBuffer_.size());
+
+  // Count the occurrences of each key, then accumulate them in sorted key order
+  std::pmr::vector<std::size_t> counts(keys.Size(), 0, resource);
+  for (const KeyId id : columns.KeyIds()) {
+    ++counts[id];
+  }
+  CumulativeCounts_.resize(SortedIds_.size() + 1, 0);
+  for (std::size_t i = 0; i < SortedIds_.size(); ++i) {
+    CumulativeCounts_[i + 1] = CumulativeCounts_[i] + counts[SortedIds_[i]];
+  }
+}
+
+bool KeyPrefixIndex::HasPrefix(std::string_view prefix) const {
+  const auto [first, last] = Range(prefix);
+  return first != last;
+}
+
+std::size_t KeyPrefixIndex::CountKeys(std::string_view prefix) const {
+  const auto [first, last] = Range(prefix);
+  return last - first;
+}
+
+std::size_t KeyPrefixIndex::CountFields(std::string_view prefix) const {
+  const auto [first, last] = Range(prefix);
+  return CumulativeCounts_[last] - CumulativeCounts_[first];
+}
+
+std::span<const KeyId> KeyPrefixIndex::KeysWithPrefix(std::string_view prefix) const {
+  const auto [first, last] = Range(prefix);
+  return std::span<const KeyId>(SortedIds_).subspan(first, last - first);
+}
+
+std::pair<std::size_t, std::size_t> KeyPrefixIndex::Range(std::string_view prefix) const {
+  // Keys starting with the prefix sort contiguously, from the prefix itself up to the first key
+  // that neither equals nor extends it
+  const auto positions = std::views::iota(std::size_t{0}, SortedIds_.size());
+  const auto first = std::ranges::partition_point(
+      positions, [this, prefix](std::size_t position) { return SortedKey(position) < prefix; });
+  const auto last = std::ranges::partition_point(
+      std::ranges::subrange(first, positions.end()),
+      [this, prefix](std::size_t position) { return SortedKey(position).starts_with(prefix); });
+  return {static_cast<std::size_t>(first - positions.begin()),
+          static_cast<std::size_t>(last - positions.begin())};
+}
+}  // namespace datalint
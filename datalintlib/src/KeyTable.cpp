@@ -0,0 +1,63 @@
+#include <datalint/KeyTable.h>
+
+namespace {
+/// @brief Initial number of slots of the hash index; must be a power of two
+constexpr std::size_t kInitialSlotCount = 16;
+}  // namespace
+
+namespace datalint {
+
+KeyTable::KeyTable(std::pmr::memory_resource* resource)
+    : Keys_(resource), Hashes_(resource), Slots_(kInitialSlotCount, kEmptySlot, resource) {}
+
+KeyId KeyTable::Intern(const SmallKey& key) {
+  const std::size_t hash = key.Hash();
+  std::size_t slot = FindSlot(key, hash);
+  if (Slots_[slot] != kEmptySlot) {
+    return Slots_[slot];
+  }
+
+  // Keep the load factor at or below one half
+  if ((Keys_.size() + 1) * 2 > Slots_.size()) {
+    Grow();
+    slot = FindSlot(key, hash);
+  }
+
+  const auto id = static_cast<KeyId>(Keys_.size());
+  Keys_.emplace_back(key, Keys_.get_allocator().resource());
+  Hashes_.push_back(hash);
+  Slots_[slot] = id;
+  return id;
+}
+
+std::optional<KeyId> KeyTable::Find(const SmallKey& key) const {
+  const KeyId id = Slots_[FindSlot(key, key.Hash())];
+  if (id == kEmptySlot) {
+    return std::nullopt;
+  }
+  return id;
+}
+
+std::size_t KeyTable::FindSlot(const SmallKey& key, std::size_t hash) const {
+  const std::size_t mask = Slots_.size() - 1;
+  for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+    const KeyId id = Slots_[slot];
+    if (id == kEmptySlot || (Hashes_[id] == hash && Keys_[id] == key)) {
+      return slot;
+    }
+  }
+}
+
+void KeyTable::Grow() {
+  const std::size_t slotCount = Slots_.size() * 2;
+  const std::size_t mask = slotCount - 1;
+  Slots_.assign(slotCount, kEmptySlot);
+  for (KeyId id = 0; id < Keys_.size(); ++id) {
+    std::size_t slot = Hashes_[id] & mask;
+    while (Slots_[slot] != kEmptySlot) {
+      slot = (slot + 1) & mask;
+    }
+    Slots_[slot] = id;
+  }
+}
+}  // namespace datalint
@@ -0,0 +1,300 @@
+#include <datalint/Error/ErrorLog.h>
+#include <datalint/LayoutSpecification/CompiledLayout.h>
+#include <datalint/LayoutSpecification/FieldOrderingConstraint.h>
+#include <datalint/RawDataColumns.h>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+namespace datalint::layout {
+
+// Every key of the specification gets a dense id: first the expected fields in key order, then the
+// keys only named by ordering constraints. Count bounds are arrays indexed by id, ordering
+// constraints are pairs of ids compiled into an OrderingGraph, and a minimal perfect hash maps a
+// key to its id. Field patterns are numbered in pattern order and matched all at once by a
+// KeyPatternMatcher. Validation makes no allocation once its workspace has grown to the size of the
+// data. Scanning keys one at a time, straight from a file parser, fills counters sized by the
+// layout, so a layout-only check needs no raw data at all.
+
+CompiledLayout::CompiledLayout(const LayoutSpecification& specification) {
+  // The id of each key, viewing the keys of the specification, which outlive the constructor
+  std::map<std::string_view, Id, std::less<>> ids;
+  for (const auto& [key, field] : specification.Fields()) {
+    ids.emplace(key.View(), static_cast<Id>(Keys_.size()));
+    Keys_.push_back(key);
+    MinCounts_.push_back(field.MinCount());
+    MaxCounts_.push_back(field.MaxCount().value_or(kUnlimited));
+  }
+  FieldCount_ = Keys_.size();
+
+  for (const auto& [pattern, field] : specification.FieldPatterns()) {
+    Patterns_.push_back(pattern);
+    PatternMinCounts_.push_back(field.MinCount());
+    PatternMaxCounts_.push_back(field.MaxCount().value_or(kUnlimited));
+  }
+  PatternMatcher_ = specification.FieldPatternMatcher();
+
+  // Keys only named by ordering constraints get the ids after the fields
+  auto idOf = [&](const datalint::SmallKey& key) {
+    const auto [it, inserted] = ids.try_emplace(key.View(), static_cast<Id>(Keys_.size()));
+    if (inserted) {
+      Keys_.push_back(key);
+    }
+    return it->second;
+  };
+  for (const auto& constraint : specification.OrderingConstraints()) {
+    OrderingConstraints_.push_back(
+        OrderingConstraint{idOf(constraint.BeforeKey), idOf(constraint.AfterKey)});
+  }
+  const auto cycle = OrderingGraph::FindCycle(Keys_.size(), OrderingConstraints_);
+  if (!cycle.empty()) {
+    std::vector<datalint::SmallKey> cycleKeys;
+    for (const Id id : cycle) {
+      cycleKeys.push_back(Keys_[id]);
+    }
+    throw std::logic_error("CompiledLayout failed: ordering constraints form a cycle: " +
+                           DescribeOrderingCycle(cycleKeys));
+  }
+  Ordering_ = OrderingGraph(Keys_.size(), OrderingConstraints_);
+
+  std::vector<std::string_view> keys;
+  keys.reserve(Keys_.size());
+  for (const auto& key : Keys_) {
+    keys.push_back(key.View());
+  }
+  KeyHash_ = datalint::MinimalPerfectHash(keys);
+}
+
+std::optional<CompiledLayout::Id> CompiledLayout::FindKey(std::string_view key) const noexcept {
+  if (Keys_.empty()) {
+    return std::nullopt;
+  }
+  const Id id = KeyHash_.Index(key);
+  if (Keys_[id] != key) {
+    return std::nullopt;
+  }
+  return id;
+}
+
+bool CompiledLayout::Validate(const datalint::RawData& rawData,
+                              UnexpectedFieldStrictness strictness, Workspace& workspace,
+                              datalint::error::ErrorCollector& errorCollector) const {
+  const std::size_t errorCountBefore = errorCollector.ErrorCount();
+  const auto& columns = rawData.Columns();
+  const auto& rawKeys = columns.Keys();
+  const auto keyIds = columns.KeyIds();
+  const Id unknown = static_cast<Id>(Keys_.size());
+
+  // Map each distinct key of the raw data to its layout id and its field patterns once. Keys the
+  // layout does not name share the statistics entry after the layout ids, so the sweep below needs
+  // no branch for them, unless they match a field pattern: those get an entry each, after it.
+  auto& layoutIds = workspace.LayoutIds_;
+  auto& patternMatches = workspace.PatternMatches_;
+  layoutIds.resize(rawKeys.Size());
+  patternMatches.assign(Patterns_.empty() ? 0 : rawKeys.Size(), {});
+  Id nextEntry = unknown + 1;
+  for (datalint::KeyId rawId = 0; rawId < rawKeys.Size(); ++rawId) {
+    layoutIds[rawId] = FindKey(rawKeys.Key(rawId)).value_or(unknown);
+    if (!Patterns_.empty()) {
+      patternMatches[rawId] = PatternMatcher_.Match(rawKeys.Key(rawId));
+      if (layoutIds[rawId] == unknown && !patternMatches[rawId].empty()) {
+        layoutIds[rawId] = nextEntry++;
+      }
+    }
+  }
+  auto isUnexpected = [&](datalint::KeyId rawId) {
+    return layoutIds[rawId] >= FieldCount_ &&
+           (patternMatches.empty() || patternMatches[rawId].empty());
+  };
+
+  auto& statistics = workspace.Statistics_;
+  statistics.assign(nextEntry, Workspace::KeyStatistics{0, kUnlimited, 0});
+  for (std::size_t i = 0; i < keyIds.size(); ++i) {
+    auto& entry = statistics[layoutIds[keyIds[i]]];
+    ++entry.Count;
+    entry.FirstIndex = std::min(entry.FirstIndex, i);
+    entry.LastIndex = i;
+  }
+
+  // 1. Validate expected fields and field patterns, each pattern counting the occurrences of all
+  // the keys it matches
+  auto& patternCounts = workspace.PatternCounts_;
+  patternCounts.assign(Patterns_.size(), 0);
+  for (datalint::KeyId rawId = 0; rawId < patternMatches.size(); ++rawId) {
+    for (const std::uint32_t pattern : patternMatches[rawId]) {
+      patternCounts[pattern] += statistics[layoutIds[rawId]].Count;
+    }
+  }
+  ReportCounts(statistics, patternCounts, errorCollector);
+
+  // 2. Report unexpected fields (strict mode only), in order of occurrence. Only when there are
+  // any does this take a second pass over the key ids.
+  if (strictness == UnexpectedFieldStrictness::Strict &&
+      std::any_of(statistics.begin() + static_cast<std::ptrdiff_t>(FieldCount_),
+                  statistics.begin() + unknown + 1,
+                  [](const Workspace::KeyStatistics& entry) { return entry.Count > 0; })) {
+    for (const datalint::KeyId rawId : keyIds) {
+      if (isUnexpected(rawId)) {
+        errorCollector.AddErrorLog(datalint::error::ErrorLog(
+            "Unexpected Field",
+            "Field is not defined in layout specification: " + std::string(rawKeys.Key(rawId))));
+      }
+    }
+  }
+
+  // 3. Validate ordering constraints
+  ReportOrdering(statistics, workspace.Bounds_, errorCollector);
+
+  // Return true if no new errors were added
+  return errorCollector.ErrorCount() == errorCountBefore;
+}
+
+void CompiledLayout::BeginScan(UnexpectedFieldStrictness strictness,
+                               Workspace& workspace) const {
+  workspace.Statistics_.assign(Keys_.size(), Workspace::KeyStatistics{0, kUnlimited, 0});
+  workspace.PatternCounts_.assign(Patterns_.size(), 0);
+  workspace.ScannedCount_ = 0;
+  workspace.KeepsUnexpected_ = strictness == UnexpectedFieldStrictness::Strict;
+  workspace.UnexpectedKeys_.clear();
+  workspace.UnexpectedOccurrences_.clear();
+}
+
+void CompiledLayout::ScanKey(std::string_view key, Workspace& workspace) const {
+  const std::size_t index = workspace.ScannedCount_++;
+  const std::optional<Id> id = FindKey(key);
+  if (id) {
+    auto& entry = workspace.Statistics_[*id];
+    ++entry.Count;
+    entry.FirstIndex = std::min(entry.FirstIndex, index);
+    entry.LastIndex = index;
+  }
+  bool matchesPattern = false;
+  if (!Patterns_.empty()) {
+    for (const std::uint32_t pattern : PatternMatcher_.Match(key)) {
+      ++workspace.PatternCounts_[pattern];
+      matchesPattern = true;
+    }
+  }
+  if (workspace.KeepsUnexpected_ && (!id || *id >= FieldCount_) && !matchesPattern) {
+    auto it = workspace.UnexpectedKeys_.find(key);
+    if (it == workspace.UnexpectedKeys_.end()) {
+      it = workspace.UnexpectedKeys_.emplace(key).first;
+    }
+    workspace.UnexpectedOccurrences_.push_back(it);
+  }
+}
+
+bool CompiledLayout::ReportScan(UnexpectedFieldStrictness strictness, Workspace& workspace,
+                                datalint::error::ErrorCollector& errorCollector) const {
+  const bool strict = strictness == UnexpectedFieldStrictness::Strict;
+  if (strict && !workspace.KeepsUnexpected_) {
+    throw std::invalid_argument(
+        "CompiledLayout::ReportScan: strict report of a scan begun permissive");
+  }
+  const std::size_t errorCountBefore = errorCollector.ErrorCount();
+
+  // 1. Validate expected fields and field patterns
+  ReportCounts(workspace.Statistics_, workspace.PatternCounts_, errorCollector);
+
+  // 2. Report unexpected fields (strict mode only), in order of occurrence
+  if (strict) {
+    for (const auto& key : workspace.UnexpectedOccurrences_) {
+      errorCollector.AddErrorLog(datalint::error::ErrorLog(
+          "Unexpected Field", "Field is not defined in layout specification: " + *key));
+    }
+  }
+
+  // 3. Validate ordering constraints
+  ReportOrdering(workspace.Statistics_, workspace.Bounds_, errorCollector);
+
+  return errorCollector.ErrorCount() == errorCountBefore;
+}
+
+void CompiledLayout::ReportCounts(const std::vector<Workspace::KeyStatistics>& statistics,
+                                  std::span<const std::size_t> patternCounts,
+                                  datalint::error::ErrorCollector& errorCollector) const {
+  for (Id id = 0; id < FieldCount_; ++id) {
+    const std::size_t count = statistics[id].Count;
+    if (count == 0) {
+      if (MinCounts_[id] > 0) {
+        errorCollector.AddErrorLog(datalint::error::ErrorLog(
+            "Missing Required Field", "Expected at least " + std::to_string(MinCounts_[id]) +
+                                          " occurrence(s) of field: " + std::string(Key(id))));
+      }
+      continue;
+    }
+    if (count > MaxCounts_[id]) {
+      errorCollector.AddErrorLog(datalint::error::ErrorLog(
+          "Duplicate Field", "Expected at most " + std::to_string(MaxCounts_[id]) +
+                                 " occurrence(s) of field: " + std::string(Key(id))));
+    }
+  }
+
+  for (std::size_t pattern = 0; pattern < Patterns_.size(); ++pattern) {
+    const std::size_t count = patternCounts[pattern];
+    if (count == 0) {
+      if (PatternMinCounts_[pattern] > 0) {
+        errorCollector.AddErrorLog(datalint::error::ErrorLog(
+            "Missing Required Field", "Expected at least " +
+                                          std::to_string(PatternMinCounts_[pattern]) +
+                                          " occurrence(s) of fields matching: " +
+                                          std::string(Patterns_[pattern])));
+      }
+    } else if (count > PatternMaxCounts_[pattern]) {
+      errorCollector.AddErrorLog(datalint::error::ErrorLog(
+          "Duplicate Field", "Expected at most " + std::to_string(PatternMaxCounts_[pattern]) +
+                                 " occurrence(s) of fields matching: " +
+                                 std::string(Patterns_[pattern])));
+    }
+  }
+}
+
+void CompiledLayout::ReportOrdering(const std::vector<Workspace::KeyStatistics>& statistics,
+                                    std::vector<std::size_t>& bounds,
+                                    datalint::error::ErrorCollector& errorCollector) const {
+  // One pass over the reduced graph in topological order carries the last index of each present key
+  // to the keys after it, through absent keys; when no present key is preceded by a later one,
+  // every constraint holds. The check is stricter than the constraints when it goes through absent
+  // keys, so on failure each constraint is checked.
+  if (!OrderingConstraints_.empty() && !HoldsOrdering(statistics, bounds)) {
+    for (const auto& constraint : OrderingConstraints_) {
+      const auto& before = statistics[constraint.Before];
+      const auto& after = statistics[constraint.After];
+
+      // If one or both fields don't exist, skip — presence rules handle that
+      if (before.Count == 0 || after.Count == 0) {
+        continue;
+      }
+
+      if (before.LastIndex > after.FirstIndex) {
+        errorCollector.AddErrorLog(datalint::error::ErrorLog(
+            "Field Ordering Violation", "All occurrences of field '" +
+                                            std::string(Key(constraint.Before)) +
+                                            "' must precede any occurrence of field '" +
+                                            std::string(Key(constraint.After)) + "'"));
+      }
+    }
+  }
+}
+
+bool CompiledLayout::HoldsOrdering(const std::vector<Workspace::KeyStatistics>& statistics,
+                                   std::vector<std::size_t>& bounds) const {
+  bounds.assign(Keys_.size(), 0);
+  for (const Id id : Ordering_.Order()) {
+    const auto& entry = statistics[id];
+    std::size_t bound = bounds[id];
+    if (entry.Count > 0) {
+      if (bound > entry.FirstIndex) {
+        return false;
+      }
+      bound = entry.LastIndex + 1;
+    }
+    for (const Id after : Ordering_.Successors(id)) {
+      bounds[after] = std::max(bounds[after], bound);
+    }
+  }
+  return true;
+}
+}  // namespace datalint::layout
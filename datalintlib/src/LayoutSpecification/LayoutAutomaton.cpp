@@ -0,0 +1,313 @@
+#include <datalint/Error/ErrorLog.h>
+#include <datalint/LayoutSpecification/LayoutAutomaton.h>
+#include <datalint/RawData.h>
+#include <datalint/RawDataColumns.h>
+#include <datalint/RawField.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace datalint::layout {
+
+namespace {
+/// @brief Label of a state of the nondeterministic automaton with only epsilon transitions
+constexpr std::uint32_t kNoLabel = std::numeric_limits<std::uint32_t>::max();
+/// @brief Label of a state of the nondeterministic automaton moving on any symbol
+constexpr std::uint32_t kAnyLabel = kNoLabel - 1;
+
+/// @brief State of the nondeterministic automaton: epsilon transitions, plus at most one labelled
+/// transition
+struct NfaState {
+  /// @brief The states reached without consuming a key
+  std::vector<std::uint32_t> Epsilons;
+  /// @brief The symbol of the labelled transition, kAnyLabel or kNoLabel
+  std::uint32_t Label = kNoLabel;
+  /// @brief The target of the labelled transition
+  std::uint32_t Target = 0;
+};
+
+/// @brief Thompson construction of a nondeterministic automaton from a grammar
+class NfaBuilder {
+ public:
+  /// @brief A piece of automaton with one entry and one exit state
+  struct Fragment {
+    /// @brief The entry state
+    std::uint32_t Start;
+    /// @brief The exit state
+    std::uint32_t Accept;
+  };
+
+  /// @brief Constructor
+  /// @param symbols the symbol of each key of the grammar
+  explicit NfaBuilder(const std::map<std::string_view, std::uint32_t, std::less<>>& symbols)
+      : Symbols_(symbols) {}
+
+  /// @brief Build the fragment of a grammar
+  Fragment Build(const LayoutGrammar& grammar) {
+    switch (grammar.GetKind()) {
+      case LayoutGrammar::Kind::Key:
+        return Labelled(Symbols_.find(grammar.MatchedKey().View())->second);
+      case LayoutGrammar::Kind::AnyKey:
+        return Labelled(kAnyLabel);
+      case LayoutGrammar::Kind::Sequence: {
+        const std::uint32_t start = NewState();
+        std::uint32_t current = start;
+        for (const auto& item : grammar.Items()) {
+          current = Append(current, item);
+        }
+        return Fragment{start, current};
+      }
+      case LayoutGrammar::Kind::Choice: {
+        const std::uint32_t start = NewState();
+        const std::uint32_t accept = NewState();
+        for (const auto& alternative : grammar.Items()) {
+          const Fragment fragment = Build(alternative);
+          States[start].Epsilons.push_back(fragment.Start);
+          States[fragment.Accept].Epsilons.push_back(accept);
+        }
+        return Fragment{start, accept};
+      }
+      case LayoutGrammar::Kind::Repeat:
+        break;
+    }
+
+    // The mandatory repetitions in a row, then either a loop or a chain of optional ones. Each
+    // copy of the item takes at least two states, so check the counts before copying
+    const std::size_t copies = grammar.MaxCount().value_or(grammar.MinCount());
+    if (copies > (LayoutAutomaton::kMaxNfaStates - States.size()) / 2) {
+      ThrowTooManyStates();
+    }
+    const LayoutGrammar& item = grammar.Items().front();
+    const std::uint32_t start = NewState();
+    std::uint32_t current = start;
+    for (std::size_t i = 0; i < grammar.MinCount(); ++i) {
+      current = Append(current, item);
+    }
+    const std::uint32_t accept = NewState();
+    if (!grammar.MaxCount()) {
+      const std::uint32_t loop = NewState();
+      States[current].Epsilons.push_back(loop);
+      States[Append(loop, item)].Epsilons.push_back(loop);
+      States[loop].Epsilons.push_back(accept);
+      return Fragment{start, accept};
+    }
+    for (std::size_t i = grammar.MinCount(); i < *grammar.MaxCount(); ++i) {
+      States[current].Epsilons.push_back(accept);
+      current = Append(current, item);
+    }
+    States[current].Epsilons.push_back(accept);
+    return Fragment{start, accept};
+  }
+
+  /// @brief The states built
+  std::vector<NfaState> States;
+
+ private:
+  /// @brief Throw for a grammar needing more than kMaxNfaStates nondeterministic states
+  [[noreturn]] static void ThrowTooManyStates() {
+    throw std::invalid_argument("LayoutAutomaton: the grammar needs more than " +
+                                std::to_string(LayoutAutomaton::kMaxNfaStates) +
+                                " nondeterministic states");
+  }
+
+  /// @brief Add a state
+  /// @throws std::invalid_argument if there would be more than kMaxNfaStates states
+  std::uint32_t NewState() {
+    if (States.size() == LayoutAutomaton::kMaxNfaStates) {
+      ThrowTooManyStates();
+    }
+    States.emplace_back();
+    return static_cast<std::uint32_t>(States.size() - 1);
+  }
+
+  /// @brief Build a fragment moving on one label
+  Fragment Labelled(std::uint32_t label) {
+    const std::uint32_t start = NewState();
+    const std::uint32_t accept = NewState();
+    States[start].Label = label;
+    States[start].Target = accept;
+    return Fragment{start, accept};
+  }
+
+  /// @brief Build the fragment of a grammar after a state, returning its exit state
+  std::uint32_t Append(std::uint32_t state, const LayoutGrammar& grammar) {
+    const Fragment fragment = Build(grammar);
+    States[state].Epsilons.push_back(fragment.Start);
+    return fragment.Accept;
+  }
+
+  /// @brief The symbol of each key of the grammar
+  const std::map<std::string_view, std::uint32_t, std::less<>>& Symbols_;
+};
+
+/// @brief Collect the keys a grammar names
+void CollectKeys(const LayoutGrammar& grammar, std::set<std::string_view>& keys) {
+  if (grammar.GetKind() == LayoutGrammar::Kind::Key) {
+    keys.insert(grammar.MatchedKey().View());
+  }
+  for (const auto& item : grammar.Items()) {
+    CollectKeys(item, keys);
+  }
+}
+
+/// @brief Sort the given states and add every state reachable from them by epsilon transitions
+void Close(const std::vector<NfaState>& states, std::vector<std::uint32_t>& set,
+           std::vector<std::uint8_t>& seen) {
+  std::vector<std::uint32_t> stack(set.begin(), set.end());
+  set.clear();
+  while (!stack.empty()) {
+    const std::uint32_t state = stack.back();
+    stack.pop_back();
+    if (seen[state]) {
+      continue;
+    }
+    seen[state] = 1;
+    set.push_back(state);
+    stack.insert(stack.end(), states[state].Epsilons.begin(), states[state].Epsilons.end());
+  }
+  for (const std::uint32_t state : set) {
+    seen[state] = 0;
+  }
+  std::sort(set.begin(), set.end());
+}
+}  // namespace
+
+LayoutAutomaton::LayoutAutomaton(const LayoutGrammar& grammar) {
+  // The keys of the grammar in key order, viewing the grammar, which outlives the constructor
+  std::set<std::string_view> keys;
+  CollectKeys(grammar, keys);
+  std::map<std::string_view, Symbol, std::less<>> symbols;
+  std::vector<std::string_view> views(keys.begin(), keys.end());
+  for (const std::string_view key : views) {
+    symbols.emplace(key, static_cast<Symbol>(Keys_.size()));
+    Keys_.emplace_back(key);
+  }
+  KeyHash_ = datalint::MinimalPerfectHash(views);
+
+  NfaBuilder builder(symbols);
+  const NfaBuilder::Fragment root = builder.Build(grammar);
+  const auto& states = builder.States;
+
+  // Subset construction: each state of the automaton is a set of states of the nondeterministic
+  // one, the empty set being kRejected
+  const std::size_t width = Keys_.size() + 1;
+  const Symbol other = static_cast<Symbol>(Keys_.size());
+  std::vector<std::uint8_t> seen(states.size(), 0);
+  std::vector<std::vector<std::uint32_t>> sets{{}, {root.Start}};
+  Close(states, sets[kStart], seen);
+  std::map<std::vector<std::uint32_t>, State> ids{{sets[kRejected], kRejected},
+                                                  {sets[kStart], kStart}};
+  auto idOf = [&](std::vector<std::uint32_t> set) {
+    Close(states, set, seen);
+    const auto [it, inserted] = ids.try_emplace(set, static_cast<State>(sets.size()));
+    if (inserted) {
+      if (sets.size() == kMaxStates) {
+        throw std::invalid_argument("LayoutAutomaton: the grammar needs more than " +
+                                    std::to_string(kMaxStates) + " states");
+      }
+      sets.push_back(std::move(set));
+    }
+    return it->second;
+  };
+
+  Transitions_.assign(width, kRejected);
+  for (std::size_t id = kStart; id < sets.size(); ++id) {
+    // The targets on each named key, and on any key; a key with no transition of its own only
+    // moves on the latter, like every key the grammar does not name
+    std::map<Symbol, std::vector<std::uint32_t>> targets;
+    std::vector<std::uint32_t> anyTargets;
+    for (const std::uint32_t state : sets[id]) {
+      if (states[state].Label == kAnyLabel) {
+        anyTargets.push_back(states[state].Target);
+      } else if (states[state].Label != kNoLabel) {
+        targets[states[state].Label].push_back(states[state].Target);
+      }
+    }
+    const State otherState = idOf(anyTargets);
+    const std::size_t row = Transitions_.size();
+    Transitions_.resize(row + width, otherState);
+    for (auto& [symbol, symbolTargets] : targets) {
+      symbolTargets.insert(symbolTargets.end(), anyTargets.begin(), anyTargets.end());
+      Transitions_[row + symbol] = idOf(std::move(symbolTargets));
+    }
+    Transitions_[row + other] = otherState;
+  }
+
+  Accepting_.resize(sets.size());
+  for (std::size_t id = 0; id < sets.size(); ++id) {
+    Accepting_[id] = std::binary_search(sets[id].begin(), sets[id].end(), root.Accept) ? 1 : 0;
+  }
+}
+
+LayoutAutomaton::Symbol LayoutAutomaton::FindSymbol(std::string_view key) const noexcept {
+  const Symbol other = static_cast<Symbol>(Keys_.size());
+  if (Keys_.empty()) {
+    return other;
+  }
+  const Symbol symbol = KeyHash_.Index(key);
+  return Keys_[symbol] == key ? symbol : other;
+}
+
+bool LayoutAutomaton::Validate(const datalint::RawData& rawData, Workspace& workspace,
+                               datalint::error::ErrorCollector& errorCollector) const {
+  const auto& columns = rawData.Columns();
+  const auto& rawKeys = columns.Keys();
+  const auto keyIds = columns.KeyIds();
+
+  auto& symbols = workspace.Symbols_;
+  symbols.resize(rawKeys.Size());
+  for (datalint::KeyId rawId = 0; rawId < rawKeys.Size(); ++rawId) {
+    symbols[rawId] = FindSymbol(rawKeys.Key(rawId));
+  }
+
+  const std::size_t width = Keys_.size() + 1;
+  State state = kStart;
+  for (std::size_t i = 0; i < keyIds.size(); ++i) {
+    const State next = Transitions_[state * width + symbols[keyIds[i]]];
+    if (next == kRejected) {
+      errorCollector.AddErrorLog(datalint::error::ErrorLog(
+          "Layout Grammar Violation", "Field '" + std::string(columns.Key(i)) + "' at line " +
+                                          std::to_string(rawData.Fields()[i].Location.Line) +
+                                          " does not fit the layout grammar; expected " +
+                                          DescribeExpected(state)));
+      return false;
+    }
+    state = next;
+  }
+
+  if (!IsAccepting(state)) {
+    errorCollector.AddErrorLog(datalint::error::ErrorLog(
+        "Layout Grammar Violation",
+        "The data ends before the layout grammar is complete; expected " +
+            DescribeExpected(state)));
+    return false;
+  }
+  return true;
+}
+
+std::string LayoutAutomaton::DescribeExpected(State state) const {
+  std::vector<std::string> choices;
+  for (Symbol symbol = 0; symbol < Keys_.size(); ++symbol) {
+    if (Next(state, symbol) != kRejected) {
+      choices.push_back("'" + std::string(Keys_[symbol]) + "'");
+    }
+  }
+  if (Next(state, static_cast<Symbol>(Keys_.size())) != kRejected) {
+    choices.push_back(Keys_.empty() ? "any field" : "any other field");
+  }
+  if (IsAccepting(state)) {
+    choices.push_back("the end of the data");
+  }
+
+  std::string description = choices.size() > 1 ? "one of: " : "";
+  for (std::size_t i = 0; i < choices.size(); ++i) {
+    description += (i == 0 ? "" : ", ") + choices[i];
+  }
+  return description;
+}
+}  // namespace datalint::layout
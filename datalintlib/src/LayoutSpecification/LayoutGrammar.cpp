@@ -0,0 +1,86 @@
+#include <datalint/LayoutSpecification/LayoutGrammar.h>
+
+#include <stdexcept>
+#include <utility>
+
+namespace datalint::layout {
+
+/// @brief The node of a grammar; only the members of its kind are meaningful
+struct LayoutGrammar::Node {
+  /// @brief The kind of the grammar
+  Kind GrammarKind;
+  /// @brief The key of a Key grammar
+  datalint::SmallKey MatchedKey;
+  /// @brief The sub-grammars
+  std::vector<LayoutGrammar> Items;
+  /// @brief The minimum number of repetitions
+  std::size_t MinCount = 0;
+  /// @brief The maximum number of repetitions
+  std::optional<std::size_t> MaxCount;
+};
+
+LayoutGrammar::LayoutGrammar(std::shared_ptr<const Node> node) : Node_(std::move(node)) {}
+
+LayoutGrammar LayoutGrammar::Key(datalint::SmallKey key) {
+  return LayoutGrammar(
+      std::make_shared<const Node>(Node{Kind::Key, std::move(key), {}, 0, std::nullopt}));
+}
+
+LayoutGrammar LayoutGrammar::AnyKey() {
+  return LayoutGrammar(std::make_shared<const Node>(Node{Kind::AnyKey, {}, {}, 0, std::nullopt}));
+}
+
+LayoutGrammar LayoutGrammar::Sequence(std::vector<LayoutGrammar> items) {
+  return LayoutGrammar(
+      std::make_shared<const Node>(Node{Kind::Sequence, {}, std::move(items), 0, std::nullopt}));
+}
+
+LayoutGrammar LayoutGrammar::Choice(std::vector<LayoutGrammar> alternatives) {
+  if (alternatives.empty()) {
+    throw std::invalid_argument("LayoutGrammar::Choice: no alternative");
+  }
+  return LayoutGrammar(std::make_shared<const Node>(
+      Node{Kind::Choice, {}, std::move(alternatives), 0, std::nullopt}));
+}
+
+LayoutGrammar LayoutGrammar::Repeat(LayoutGrammar item, std::size_t minCount,
+                                    std::optional<std::size_t> maxCount) {
+  if (maxCount && *maxCount < minCount) {
+    throw std::invalid_argument("MaxCount < MinCount");
+  }
+  std::vector<LayoutGrammar> items;
+  items.push_back(std::move(item));
+  return LayoutGrammar(std::make_shared<const Node>(
+      Node{Kind::Repeat, {}, std::move(items), minCount, maxCount}));
+}
+
+LayoutGrammar LayoutGrammar::Optional(LayoutGrammar item) {
+  return Repeat(std::move(item), 0, 1);
+}
+
+LayoutGrammar LayoutGrammar::Block(datalint::SmallKey key) {
+  return Repeat(Key(std::move(key)), 1, std::nullopt);
+}
+
+LayoutGrammar LayoutGrammar::AnyOrder(std::vector<datalint::SmallKey> keys) {
+  if (keys.empty()) {
+    throw std::invalid_argument("LayoutGrammar::AnyOrder: no key");
+  }
+  std::vector<LayoutGrammar> alternatives;
+  alternatives.reserve(keys.size());
+  for (auto& key : keys) {
+    alternatives.push_back(Key(std::move(key)));
+  }
+  return Repeat(Choice(std::move(alternatives)), 0, std::nullopt);
+}
+
+LayoutGrammar::Kind LayoutGrammar::GetKind() const noexcept { return Node_->GrammarKind; }
+
+const datalint::SmallKey& LayoutGrammar::MatchedKey() const noexcept { return Node_->MatchedKey; }
+
+std::span<const LayoutGrammar> LayoutGrammar::Items() const noexcept { return Node_->Items; }
+
+std::size_t LayoutGrammar::MinCount() const noexcept { return Node_->MinCount; }
+
+std::optional<std::size_t> LayoutGrammar::MaxCount() const noexcept { return Node_->MaxCount; }
+}  // namespace datalint::layout
@@ -0,0 +1,327 @@
+#include <datalint/LayoutSpecification/LayoutPatchSquasher.h>
+#include <datalint/SmallKey.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace datalint::layout {
+
+namespace {
+/// @brief Throw if the given bounds are inconsistent, as ExpectedField does
+void CheckBounds(std::size_t minCount, std::optional<std::size_t> maxCount) {
+  if (maxCount && *maxCount < minCount) {
+    throw std::invalid_argument("MaxCount < MinCount");
+  }
+}
+
+/// @brief Declarative count modifications of a field with unknown bounds, folded into one edit of
+/// constant size: the bounds set last, plus the checks the folded operations make against the
+/// bounds of the field they did not set
+struct CountEdit {
+  /// @brief The min count set, if any
+  std::optional<std::size_t> MinCount;
+  /// @brief The max count set, if any (std::nullopt inside for unlimited)
+  std::optional<std::optional<std::size_t>> MaxCount;
+  /// @brief The largest min count set while the max count was still the field's
+  std::size_t MinSetBeforeMax = 0;
+  /// @brief The smallest max count set while the min count was still the field's
+  std::optional<std::size_t> MaxSetBeforeMin;
+
+  /// @brief Whether both bounds are set, so that later modifications need no field
+  bool IsKnown() const noexcept { return MinCount && MaxCount; }
+
+  /// @throws std::invalid_argument if the min count exceeds a max count set before
+  void Fold(const SetFieldMinCount& op) {
+    if (MaxCount) {
+      CheckBounds(op.MinCount, *MaxCount);
+    } else {
+      MinSetBeforeMax = std::max(MinSetBeforeMax, op.MinCount);
+    }
+    MinCount = op.MinCount;
+  }
+
+  /// @throws std::invalid_argument if the max count is below a min count set before
+  void Fold(const SetFieldMaxCount& op) {
+    if (MinCount) {
+      CheckBounds(*MinCount, op.MaxCount);
+    } else if (op.MaxCount) {
+      MaxSetBeforeMin = std::min(MaxSetBeforeMin.value_or(*op.MaxCount), *op.MaxCount);
+    }
+    MaxCount = op.MaxCount;
+  }
+
+  /// @throws std::invalid_argument if the max count is less than the min count
+  void Fold(const SetFieldCountBounds& op) {
+    CheckBounds(op.MinCount, op.MaxCount);
+    MinCount = op.MinCount;
+    MaxCount = op.MaxCount;
+  }
+
+  /// @brief Apply the edit to a field, throwing where one of the folded operations would have
+  /// @throws std::invalid_argument if the folded operations do not fit the field's bounds
+  void ApplyTo(ExpectedField& field) const {
+    if (field.MaxCount() && *field.MaxCount() < MinSetBeforeMax) {
+      throw std::invalid_argument("MaxCount < MinCount");
+    }
+    if (MaxSetBeforeMin && *MaxSetBeforeMin < field.MinCount()) {
+      throw std::invalid_argument("MaxCount < MinCount");
+    }
+    field = ExpectedField(MinCount.value_or(field.MinCount()), MaxCount.value_or(field.MaxCount()));
+  }
+
+  /// @brief The operation applying the edit to the field of a key: a declarative one when one has
+  /// the same effect, a ModifyField otherwise
+  LayoutPatchOperation ToOperation(const SmallKey& key) const {
+    if (MinCount && !MaxCount && MinSetBeforeMax == *MinCount && !MaxSetBeforeMin) {
+      return SetFieldMinCount{key, *MinCount};
+    }
+    if (!MinCount && MaxCount && MinSetBeforeMax == 0 && MaxSetBeforeMin == *MaxCount) {
+      return SetFieldMaxCount{key, *MaxCount};
+    }
+    if (IsKnown() && MinSetBeforeMax == 0 && !MaxSetBeforeMin) {
+      return SetFieldCountBounds{key, *MinCount, *MaxCount};
+    }
+    return ModifyField{key, [edit = *this](ExpectedField& field) { edit.ApplyTo(field); }};
+  }
+};
+
+/// @brief Net effect of the squashed operations on one field
+struct FieldChange {
+  /// @brief Whether the field of the base specification is removed
+  bool RemovesBase = false;
+  /// @brief The field present afterwards, when added by the sequence
+  std::optional<ExpectedField> Added;
+  /// @brief Whether the field is known to be absent afterwards
+  bool Absent = false;
+  /// @brief Modifications of the base field, in order: runs of declarative ones are folded into
+  /// one edit, so only opaque ModifyField operations make the list grow
+  std::vector<std::variant<CountEdit, ModifyField>> Modifications;
+};
+
+/// @brief Net effect of the squashed operations on one field pattern
+struct PatternChange {
+  /// @brief Whether the pattern of the base specification is removed
+  bool RemovesBase = false;
+  /// @brief The pattern's bounds afterwards, when added by the sequence
+  std::optional<ExpectedField> Added;
+  /// @brief Whether the pattern is known to be absent afterwards
+  bool Absent = false;
+};
+
+/// @brief Net effect of the squashed operations on one ordering constraint
+struct ConstraintChange {
+  /// @brief Whether the constraint of the base specification is removed
+  bool RemovesBase = false;
+  /// @brief When the constraint is present afterwards because the sequence added it, the position
+  /// of that addition
+  std::optional<std::size_t> AddedAt;
+  /// @brief Whether the constraint is known to be absent afterwards
+  bool Absent = false;
+};
+
+/// @brief Fold layout operations into per-key net changes
+class Folder {
+ public:
+  void operator()(const AddField& op) {
+    auto& change = Fields_[op.Key];
+    if (change.Added || (!change.Absent && !change.RemovesBase && !change.Modifications.empty())) {
+      throw std::logic_error("AddExpectedField failed: field already exists: " +
+                             std::string(op.Key));
+    }
+    change.Added = op.Field;
+    change.Absent = false;
+  }
+
+  void operator()(const RemoveField& op) {
+    auto& change = Fields_[op.Key];
+    if (change.Absent) {
+      throw std::logic_error("RemoveExpectedField failed: field does not exist: " +
+                             std::string(op.Key));
+    }
+    if (!change.Added) {
+      change.RemovesBase = true;
+    }
+    change.Added.reset();
+    change.Modifications.clear();
+    change.Absent = true;
+  }
+
+  void operator()(const ModifyField& op) { Modify(op); }
+  void operator()(const SetFieldMinCount& op) { Modify(op); }
+  void operator()(const SetFieldMaxCount& op) { Modify(op); }
+  void operator()(const SetFieldCountBounds& op) { Modify(op); }
+
+  void operator()(const AddFieldPattern& op) {
+    auto& change = Patterns_[op.Pattern];
+    if (change.Added) {
+      throw std::logic_error("AddExpectedFieldPattern failed: pattern already exists: " +
+                             std::string(op.Pattern));
+    }
+    change.Added = op.Field;
+    change.Absent = false;
+  }
+
+  void operator()(const RemoveFieldPattern& op) {
+    auto& change = Patterns_[op.Pattern];
+    if (change.Absent) {
+      throw std::logic_error("RemoveExpectedFieldPattern failed: pattern does not exist: " +
+                             std::string(op.Pattern));
+    }
+    if (!change.Added) {
+      change.RemovesBase = true;
+    }
+    change.Added.reset();
+    change.Absent = true;
+  }
+
+  void operator()(const AddFieldOrdering& op) {
+    auto& change = Constraints_[{op.BeforeKey, op.AfterKey}];
+    if (change.AddedAt) {
+      throw std::logic_error("AddOrderingConstraint failed: constraint already exists: " +
+                             std::string(op.BeforeKey) + " -> " + std::string(op.AfterKey));
+    }
+    change.AddedAt = NextPosition_++;
+    change.Absent = false;
+  }
+
+  void operator()(const RemoveFieldOrdering& op) {
+    auto& change = Constraints_[{op.BeforeKey, op.AfterKey}];
+    if (change.Absent) {
+      throw std::logic_error("RemoveOrderingConstraint failed: constraint does not exist: " +
+                             std::string(op.BeforeKey) + " -> " + std::string(op.AfterKey));
+    }
+    if (change.AddedAt) {
+      change.AddedAt.reset();
+    } else {
+      change.RemovesBase = true;
+    }
+    change.Absent = true;
+  }
+
+  /// @brief The operations with the net effect of the folded ones
+  std::vector<LayoutPatchOperation> Operations() const {
+    std::vector<LayoutPatchOperation> operations;
+    for (const auto& [key, change] : Fields_) {
+      if (change.RemovesBase) {
+        operations.push_back(RemoveField{key});
+      }
+      if (change.Added) {
+        operations.push_back(AddField{key, *change.Added});
+      } else if (!change.Modifications.empty()) {
+        operations.push_back(Modification(key, change.Modifications));
+      }
+    }
+
+    for (const auto& [pattern, change] : Patterns_) {
+      if (change.RemovesBase) {
+        operations.push_back(RemoveFieldPattern{pattern});
+      }
+      if (change.Added) {
+        operations.push_back(AddFieldPattern{pattern, *change.Added});
+      }
+    }
+
+    // Removals first, then the surviving additions in the order they were made, which is the
+    // order the constraints end up in
+    std::vector<std::pair<std::size_t, const std::pair<SmallKey, SmallKey>*>> added;
+    for (const auto& [keys, change] : Constraints_) {
+      if (change.RemovesBase) {
+        operations.push_back(RemoveFieldOrdering{keys.first, keys.second});
+      }
+      if (change.AddedAt) {
+        added.emplace_back(*change.AddedAt, &keys);
+      }
+    }
+    std::sort(added.begin(), added.end());
+    for (const auto& [position, keys] : added) {
+      operations.push_back(AddFieldOrdering{keys->first, keys->second});
+    }
+    return operations;
+  }
+
+ private:
+  /// @brief Fold a modification: applied to the field when the sequence added it or set both its
+  /// bounds, folded into the last edit of the base field otherwise
+  template <typename Modification>
+  void Modify(const Modification& op) {
+    auto& change = Fields_[op.Key];
+    if (change.Absent) {
+      throw std::logic_error("ModifyExpectedField failed: field does not exist: " +
+                             std::string(op.Key));
+    }
+    if (change.Added) {
+      op.ApplyTo(*change.Added);
+      return;
+    }
+    auto& modifications = change.Modifications;
+    auto* edit = modifications.empty() ? nullptr : std::get_if<CountEdit>(&modifications.back());
+    if constexpr (std::is_same_v<Modification, ModifyField>) {
+      if (edit && edit->IsKnown()) {
+        ExpectedField field(*edit->MinCount, *edit->MaxCount);
+        op.ApplyTo(field);
+        edit->MinCount = field.MinCount();
+        edit->MaxCount = field.MaxCount();
+      } else {
+        modifications.emplace_back(op);
+      }
+    } else {
+      if (!edit) {
+        edit = &std::get<CountEdit>(modifications.emplace_back(CountEdit{}));
+      }
+      edit->Fold(op);
+    }
+  }
+
+  /// @brief The single operation applying the modifications of a base field in order
+  static LayoutPatchOperation Modification(
+      const SmallKey& key, const std::vector<std::variant<CountEdit, ModifyField>>& modifications) {
+    if (modifications.size() == 1) {
+      if (const auto* edit = std::get_if<CountEdit>(&modifications.front())) {
+        return edit->ToOperation(key);
+      }
+      return std::get<ModifyField>(modifications.front());
+    }
+    return ModifyField{key, [modifications](ExpectedField& field) {
+                         for (const auto& modification : modifications) {
+                           std::visit([&field](const auto& op) { op.ApplyTo(field); },
+                                      modification);
+                         }
+                       }};
+  }
+
+  /// @brief Net changes per field key
+  std::map<SmallKey, FieldChange, std::less<>> Fields_;
+  /// @brief Net changes per field pattern
+  std::map<SmallKey, PatternChange, std::less<>> Patterns_;
+  /// @brief Net changes per (before, after) constraint
+  std::map<std::pair<SmallKey, SmallKey>, ConstraintChange> Constraints_;
+  /// @brief Position of the next constraint addition
+  std::size_t NextPosition_ = 0;
+};
+}  // namespace
+
+LayoutPatch LayoutPatchSquasher::Squash(std::string name, const VersionRange& interval,
+                                        std::span<const LayoutPatch> patches) const {
+  Folder folder;
+  for (const auto& patch : patches) {
+    if (!patch.AppliesTo().Overlaps(interval)) {
+      continue;
+    }
+    if (!patch.AppliesTo().Includes(interval)) {
+      throw std::invalid_argument("LayoutPatchSquasher: patch '" + patch.Name() +
+                                  "' applies to only part of the interval");
+    }
+    for (const auto& op : patch.Operations()) {
+      std::visit(folder, op);
+    }
+  }
+  return LayoutPatch(std::move(name), interval, folder.Operations());
+}
+}  // namespace datalint::layout
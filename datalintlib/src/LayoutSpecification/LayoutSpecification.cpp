@@ -1,77 +1,238 @@
+#include <datalint/ContentHash.h>
 #include <datalint/LayoutSpecification/ExpectedField.h>
 #include <datalint/LayoutSpecification/FieldOrderingConstraint.h>
 #include <datalint/LayoutSpecification/LayoutSpecification.h>
+#include <datalint/LayoutSpecification/OrderingGraph.h>
 
 #include <algorithm>
+#include <bit>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace datalint::layout {
 
-LayoutSpecification::LayoutSpecification() : ExpectedFields_(), OrderingConstraints_() {}
+// The fields, patterns and constraints are held in persistent containers, so a copy shares its
+// storage with the original, and a specification derived from another by a patch only costs the
+// size of the patch. Field lookups go through a FieldIndex built on the first lookup after a
+// modification and shared by unmodified copies. The field patterns are compiled into a single
+// KeyPatternMatcher whenever they change, so a pattern whose matcher would exceed the state limit
+// is rejected when it is added.
+
+/// @brief Open-addressing hash index from key to field, with linear probing over a power-of-two
+/// number of slots kept at most half full
+struct LayoutSpecification::FieldIndex {
+  /// @brief A slot of the index
+  struct Slot {
+    /// @brief The hash of the key of the field
+    std::size_t Hash;
+    /// @brief The entry of the field in the map, nullptr for an empty slot
+    const std::pair<const datalint::SmallKey, ExpectedField>* Entry;
+  };
+
+  /// @brief Guards the one-time build of the slots
+  std::once_flag Built;
+  /// @brief The slots
+  std::vector<Slot> Slots;
+
+  /// @brief Index the fields of the given map
+  void Build(const datalint::PersistentMap<datalint::SmallKey, ExpectedField>& fields) {
+    Slots.assign(std::bit_ceil(2 * fields.size() + 1), Slot{0, nullptr});
+    for (const auto& entry : fields) {
+      const std::size_t hash = entry.first.Hash();
+      std::size_t slot = hash & (Slots.size() - 1);
+      while (Slots[slot].Entry != nullptr) {
+        slot = (slot + 1) & (Slots.size() - 1);
+      }
+      Slots[slot] = Slot{hash, &entry};
+    }
+  }
 
-const std::optional<ExpectedField> LayoutSpecification::GetField(const std::string& key) const {
-  auto it = ExpectedFields_.find(key);
-  if (it != ExpectedFields_.end()) {
-    return it->second;
+  /// @brief Find the field with the given key
+  const ExpectedField* Find(std::string_view key) const {
+    const std::size_t hash = datalint::SmallKey::Hash(key);
+    for (std::size_t slot = hash & (Slots.size() - 1); Slots[slot].Entry != nullptr;
+         slot = (slot + 1) & (Slots.size() - 1)) {
+      if (Slots[slot].Hash == hash && Slots[slot].Entry->first == key) {
+        return &Slots[slot].Entry->second;
+      }
+    }
+    return nullptr;
+  }
+};
+
+LayoutSpecification::LayoutSpecification()
+    : ExpectedFields_(),
+      FieldPatterns_(),
+      PatternMatcher_(std::make_shared<const datalint::KeyPatternMatcher>()),
+      OrderingConstraints_(),
+      SortedOrderingConstraints_(),
+      Index_(std::make_shared<FieldIndex>()) {}
+
+const LayoutSpecification::FieldIndex* LayoutSpecification::Index() const {
+  if (!Index_) {
+    return nullptr;
+  }
+  // The entries stay alive as long as the map, or any copy sharing this index, does
+  std::call_once(Index_->Built, [this] { Index_->Build(ExpectedFields_); });
+  return Index_.get();
+}
+
+void LayoutSpecification::InvalidateIndex() { Index_ = std::make_shared<FieldIndex>(); }
+
+void LayoutSpecification::SetFieldPatterns(
+    datalint::PersistentMap<datalint::SmallKey, ExpectedField> patterns) {
+  std::vector<std::string_view> keys;
+  keys.reserve(patterns.size());
+  for (const auto& [pattern, field] : patterns) {
+    keys.push_back(pattern.View());
+  }
+  PatternMatcher_ = std::make_shared<const datalint::KeyPatternMatcher>(keys);
+  FieldPatterns_ = std::move(patterns);
+}
+
+const std::optional<ExpectedField> LayoutSpecification::GetField(std::string_view key) const {
+  if (const ExpectedField* field = FindField(key)) {
+    return *field;
   }
   return std::nullopt;
 }
 
-bool LayoutSpecification::HasField(const std::string& key) const {
-  return ExpectedFields_.contains(key);
+const ExpectedField* LayoutSpecification::FindField(std::string_view key) const {
+  const FieldIndex* index = Index();
+  return index ? index->Find(key) : nullptr;
 }
 
-const std::map<std::string, ExpectedField>& LayoutSpecification::Fields() const {
+bool LayoutSpecification::HasField(std::string_view key) const { return FindField(key) != nullptr; }
+
+const datalint::PersistentMap<datalint::SmallKey, ExpectedField>& LayoutSpecification::Fields()
+    const {
   return ExpectedFields_;
 }
 
-const std::vector<FieldOrderingConstraint>& LayoutSpecification::OrderingConstraints() const {
+const datalint::PersistentMap<datalint::SmallKey, ExpectedField>&
+LayoutSpecification::FieldPatterns() const {
+  return FieldPatterns_;
+}
+
+const datalint::KeyPatternMatcher& LayoutSpecification::FieldPatternMatcher() const {
+  static const datalint::KeyPatternMatcher kNoPatterns;
+  return PatternMatcher_ ? *PatternMatcher_ : kNoPatterns;
+}
+
+const datalint::PersistentSequence<FieldOrderingConstraint>&
+LayoutSpecification::OrderingConstraints() const {
   return OrderingConstraints_;
 }
 
-void LayoutSpecification::AddExpectedField(const std::string& key, const ExpectedField& field) {
-  auto [it, inserted] = ExpectedFields_.emplace(key, field);
-  if (!inserted) {
-    throw std::logic_error("AddExpectedField failed: field already exists: " + key);
+std::uint64_t LayoutSpecification::ContentHash() const {
+  datalint::ContentHasher hasher;
+  hasher.Add(static_cast<std::uint64_t>(ExpectedFields_.size()));
+  for (const auto& [key, field] : ExpectedFields_) {
+    hasher.Add(key.View()).Add(static_cast<std::uint64_t>(field.MinCount())).Add(field.MaxCount());
+  }
+  hasher.Add(static_cast<std::uint64_t>(FieldPatterns_.size()));
+  for (const auto& [pattern, field] : FieldPatterns_) {
+    hasher.Add(pattern.View())
+        .Add(static_cast<std::uint64_t>(field.MinCount()))
+        .Add(field.MaxCount());
+  }
+  hasher.Add(static_cast<std::uint64_t>(OrderingConstraints_.size()));
+  for (const auto& constraint : OrderingConstraints_) {
+    hasher.Add(constraint.BeforeKey.View()).Add(constraint.AfterKey.View());
+  }
+  return hasher.Value();
+}
+
+void LayoutSpecification::AddExpectedField(const datalint::SmallKey& key,
+                                           const ExpectedField& field) {
+  if (!ExpectedFields_.insert(key, field)) {
+    throw std::logic_error("AddExpectedField failed: field already exists: " + std::string(key));
   }
+  InvalidateIndex();
 }
 
-void LayoutSpecification::ModifyExpectedField(const std::string& key,
+void LayoutSpecification::ModifyExpectedField(const datalint::SmallKey& key,
                                               const std::function<void(ExpectedField&)> mutator) {
   auto it = ExpectedFields_.find(key);
   if (it == ExpectedFields_.end()) {
-    throw std::logic_error("ModifyExpectedField failed: field does not exist: " + key);
+    throw std::logic_error("ModifyExpectedField failed: field does not exist: " + std::string(key));
   }
 
-  mutator(it->second);
+  // The stored field is shared with copies of this specification: modify a copy and replace it
+  ExpectedField modified = it->second;
+  mutator(modified);
+  ExpectedFields_.insert_or_assign(key, modified);
+  InvalidateIndex();
 }
 
-void LayoutSpecification::RemoveExpectedField(const std::string& key) {
+void LayoutSpecification::RemoveExpectedField(const datalint::SmallKey& key) {
   if (ExpectedFields_.erase(key) == 0) {
-    throw std::logic_error("RemoveExpectedField failed: field does not exist: " + key);
+    throw std::logic_error("RemoveExpectedField failed: field does not exist: " + std::string(key));
   }
+  InvalidateIndex();
+}
+
+void LayoutSpecification::AddExpectedFieldPattern(const datalint::SmallKey& pattern,
+                                                  const ExpectedField& field) {
+  datalint::KeyPatternMatcher::CheckSyntax(pattern);
+  auto patterns = FieldPatterns_;
+  if (!patterns.insert(pattern, field)) {
+    throw std::logic_error("AddExpectedFieldPattern failed: pattern already exists: " +
+                           std::string(pattern));
+  }
+  SetFieldPatterns(std::move(patterns));
+}
+
+void LayoutSpecification::RemoveExpectedFieldPattern(const datalint::SmallKey& pattern) {
+  auto patterns = FieldPatterns_;
+  if (patterns.erase(pattern) == 0) {
+    throw std::logic_error("RemoveExpectedFieldPattern failed: pattern does not exist: " +
+                           std::string(pattern));
+  }
+  SetFieldPatterns(std::move(patterns));
+}
+
+std::vector<datalint::SmallKey> LayoutSpecification::FindOrderingCycle() const {
+  std::map<std::string_view, OrderingGraph::Id, std::less<>> ids;
+  std::vector<datalint::SmallKey> keys;
+  auto idOf = [&](const datalint::SmallKey& key) {
+    const auto [it, inserted] =
+        ids.try_emplace(key.View(), static_cast<OrderingGraph::Id>(keys.size()));
+    if (inserted) {
+      keys.push_back(key);
+    }
+    return it->second;
+  };
+  std::vector<OrderingGraph::Edge> edges;
+  edges.reserve(OrderingConstraints_.size());
+  for (const auto& constraint : OrderingConstraints_) {
+    edges.push_back(OrderingGraph::Edge{idOf(constraint.BeforeKey), idOf(constraint.AfterKey)});
+  }
+
+  std::vector<datalint::SmallKey> cycle;
+  for (const OrderingGraph::Id id : OrderingGraph::FindCycle(keys.size(), edges)) {
+    cycle.push_back(keys[id]);
+  }
+  return cycle;
 }
 
 void LayoutSpecification::AddOrderingConstraint(FieldOrderingConstraint constraint) {
-  auto& constraints = OrderingConstraints_;
-  bool exists =
-      std::any_of(constraints.begin(), constraints.end(), [&](const FieldOrderingConstraint& c) {
-        return c.BeforeKey == constraint.BeforeKey && c.AfterKey == constraint.AfterKey;
-      });
-  if (exists) {
+  if (!SortedOrderingConstraints_.insert(constraint, true)) {
     throw std::logic_error("AddOrderingConstraint failed: constraint already exists: " +
-                           constraint.BeforeKey + " -> " + constraint.AfterKey);
+                           std::string(constraint.BeforeKey) + " -> " +
+                           std::string(constraint.AfterKey));
   }
 
   OrderingConstraints_.push_back(std::move(constraint));
 }
 
-void LayoutSpecification::RemoveOrderingConstraint(const std::string& beforeKey,
-                                                   const std::string& afterKey) {
-  auto& constraints = OrderingConstraints_;
+void LayoutSpecification::RemoveOrderingConstraint(const datalint::SmallKey& beforeKey,
+                                                   const datalint::SmallKey& afterKey) {
+  const auto& constraints = OrderingConstraints_;
 
   auto it =
       std::find_if(constraints.begin(), constraints.end(), [&](const FieldOrderingConstraint& c) {
@@ -80,9 +241,10 @@ void LayoutSpecification::RemoveOrderingConstraint(const std::string& beforeKey,
 
   if (it == constraints.end()) {
     throw std::logic_error("RemoveOrderingConstraint failed: constraint does not exist: " +
-                           beforeKey + " -> " + afterKey);
+                           std::string(beforeKey) + " -> " + std::string(afterKey));
   }
 
-  constraints.erase(it);
+  SortedOrderingConstraints_.erase(*it);
+  OrderingConstraints_.erase(it);
 }
 }  // namespace datalint::layout
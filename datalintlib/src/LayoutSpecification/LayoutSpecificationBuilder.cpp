@@ -1,6 +1,9 @@
 #include <datalint/LayoutSpecification/FieldOrderingConstraint.h>
 #include <datalint/LayoutSpecification/LayoutSpecificationBuilder.h>
 
+#include <stdexcept>
+#include <string>
+
 namespace datalint::layout {
 
 LayoutSpecification LayoutSpecificationBuilder::Build(Version version,
@@ -15,9 +18,36 @@ LayoutSpecification LayoutSpecificationBuilder::Build(Version version,
     ApplyPatch(spec, patch);
   }
 
+  RejectOrderingCycle(spec);
+  return spec;
+}
+
+LayoutSpecification LayoutSpecificationBuilder::Build(Version version,
+                                                      std::span<const LayoutPatch> patches,
+                                                      const VersionRangeIndex& index) const {
+  if (index.Size() != patches.size()) {
+    throw std::invalid_argument("Build failed: the version range index was not built over the " +
+                                std::to_string(patches.size()) + " patches");
+  }
+  LayoutSpecification spec;
+
+  for (const std::size_t position : index.Find(version)) {
+    ApplyPatch(spec, patches[position]);
+  }
+
+  RejectOrderingCycle(spec);
   return spec;
 }
 
+void LayoutSpecificationBuilder::RejectOrderingCycle(
+    const LayoutSpecification& specification) const {
+  const auto cycle = specification.FindOrderingCycle();
+  if (!cycle.empty()) {
+    throw std::logic_error("Build failed: ordering constraints form a cycle: " +
+                           DescribeOrderingCycle(cycle));
+  }
+}
+
 void LayoutSpecificationBuilder::ApplyPatch(LayoutSpecification& specification,
                                             const LayoutPatch& patch) const {
   for (const auto& op : patch.Operations()) {
@@ -35,11 +65,36 @@ void LayoutSpecificationBuilder::ApplyOperation(LayoutSpecification& specificati
   specification.ModifyExpectedField(op.Key, op.Mutator);
 }
 
+void LayoutSpecificationBuilder::ApplyOperation(LayoutSpecification& specification,
+                                                const SetFieldMinCount& op) const {
+  specification.ModifyExpectedField(op.Key, [&op](ExpectedField& field) { op.ApplyTo(field); });
+}
+
+void LayoutSpecificationBuilder::ApplyOperation(LayoutSpecification& specification,
+                                                const SetFieldMaxCount& op) const {
+  specification.ModifyExpectedField(op.Key, [&op](ExpectedField& field) { op.ApplyTo(field); });
+}
+
+void LayoutSpecificationBuilder::ApplyOperation(LayoutSpecification& specification,
+                                                const SetFieldCountBounds& op) const {
+  specification.ModifyExpectedField(op.Key, [&op](ExpectedField& field) { op.ApplyTo(field); });
+}
+
 void LayoutSpecificationBuilder::ApplyOperation(LayoutSpecification& specification,
                                                 const AddField& op) const {
   specification.AddExpectedField(op.Key, op.Field);
 }
 
+void LayoutSpecificationBuilder::ApplyOperation(LayoutSpecification& specification,
+                                                const AddFieldPattern& op) const {
+  specification.AddExpectedFieldPattern(op.Pattern, op.Field);
+}
+
+void LayoutSpecificationBuilder::ApplyOperation(LayoutSpecification& specification,
+                                                const RemoveFieldPattern& op) const {
+  specification.RemoveExpectedFieldPattern(op.Pattern);
+}
+
 void LayoutSpecificationBuilder::ApplyOperation(LayoutSpecification& specification,
                                                 const AddFieldOrdering& op) const {
   specification.AddOrderingConstraint(FieldOrderingConstraint{op.BeforeKey, op.AfterKey});
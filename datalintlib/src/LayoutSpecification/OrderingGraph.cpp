@@ -0,0 +1,144 @@
+#include <datalint/LayoutSpecification/OrderingGraph.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace datalint::layout {
+
+namespace {
+/// @brief The distinct successors of each node, sorted by id
+std::vector<std::vector<OrderingGraph::Id>> Adjacency(std::size_t nodeCount,
+                                                      std::span<const OrderingGraph::Edge> edges) {
+  std::vector<std::vector<OrderingGraph::Id>> successors(nodeCount);
+  for (const auto& edge : edges) {
+    if (edge.Before >= nodeCount || edge.After >= nodeCount) {
+      throw std::invalid_argument("OrderingGraph: edge id out of range");
+    }
+    successors[edge.Before].push_back(edge.After);
+  }
+  for (auto& list : successors) {
+    std::sort(list.begin(), list.end());
+    list.erase(std::unique(list.begin(), list.end()), list.end());
+  }
+  return successors;
+}
+}  // namespace
+
+OrderingGraph::OrderingGraph(std::size_t nodeCount, std::span<const Edge> edges)
+    : Ranks_(nodeCount, 0) {
+  const auto successors = Adjacency(nodeCount, edges);
+
+  // Kahn's algorithm, raising the rank of each node as its predecessors are removed
+  std::vector<std::size_t> inDegrees(nodeCount, 0);
+  for (const auto& list : successors) {
+    for (const Id after : list) {
+      ++inDegrees[after];
+    }
+  }
+  Order_.reserve(nodeCount);
+  for (Id id = 0; id < nodeCount; ++id) {
+    if (inDegrees[id] == 0) {
+      Order_.push_back(id);
+    }
+  }
+  for (std::size_t i = 0; i < Order_.size(); ++i) {
+    const Id before = Order_[i];
+    for (const Id after : successors[before]) {
+      Ranks_[after] = std::max(Ranks_[after], Ranks_[before] + 1);
+      if (--inDegrees[after] == 0) {
+        Order_.push_back(after);
+      }
+    }
+  }
+  if (Order_.size() != nodeCount) {
+    throw std::invalid_argument("OrderingGraph: the edges form a cycle");
+  }
+  std::sort(Order_.begin(), Order_.end(), [this](Id lhs, Id rhs) {
+    return std::pair(Ranks_[lhs], lhs) < std::pair(Ranks_[rhs], rhs);
+  });
+  std::vector<std::size_t> positions(nodeCount);
+  for (std::size_t i = 0; i < nodeCount; ++i) {
+    positions[Order_[i]] = i;
+  }
+
+  // Transitive reduction, from the last node to the first so that the reduced successors of every
+  // successor are known: an edge is kept unless its target is reachable through a successor
+  // earlier in topological order. Reachability from the current node is marked with a stamp.
+  std::vector<std::vector<Id>> reduced(nodeCount);
+  std::vector<std::size_t> stamps(nodeCount, 0);
+  std::vector<Id> stack;
+  for (std::size_t i = nodeCount; i-- > 0;) {
+    const Id before = Order_[i];
+    const std::size_t stamp = i + 1;
+    std::vector<Id> candidates = successors[before];
+    std::sort(candidates.begin(), candidates.end(),
+              [&](Id lhs, Id rhs) { return positions[lhs] < positions[rhs]; });
+    for (const Id after : candidates) {
+      if (stamps[after] == stamp) {
+        continue;
+      }
+      reduced[before].push_back(after);
+      stamps[after] = stamp;
+      stack.push_back(after);
+      while (!stack.empty()) {
+        const Id node = stack.back();
+        stack.pop_back();
+        for (const Id next : reduced[node]) {
+          if (stamps[next] != stamp) {
+            stamps[next] = stamp;
+            stack.push_back(next);
+          }
+        }
+      }
+    }
+  }
+
+  Offsets_.reserve(nodeCount + 1);
+  for (const auto& list : reduced) {
+    Successors_.insert(Successors_.end(), list.begin(), list.end());
+    Offsets_.push_back(Successors_.size());
+  }
+}
+
+std::vector<OrderingGraph::Id> OrderingGraph::FindCycle(std::size_t nodeCount,
+                                                        std::span<const Edge> edges) {
+  const auto successors = Adjacency(nodeCount, edges);
+
+  // Depth-first search: a node on the current path reached again closes a cycle
+  enum class State : std::uint8_t { Unvisited, OnPath, Done };
+  std::vector<State> states(nodeCount, State::Unvisited);
+  std::vector<std::pair<Id, std::size_t>> path;
+  for (Id root = 0; root < nodeCount; ++root) {
+    if (states[root] != State::Unvisited) {
+      continue;
+    }
+    states[root] = State::OnPath;
+    path.emplace_back(root, 0);
+    while (!path.empty()) {
+      auto& [node, next] = path.back();
+      if (next == successors[node].size()) {
+        states[node] = State::Done;
+        path.pop_back();
+        continue;
+      }
+      const Id after = successors[node][next++];
+      if (states[after] == State::OnPath) {
+        auto start = std::find_if(path.begin(), path.end(),
+                                  [after](const auto& entry) { return entry.first == after; });
+        std::vector<Id> cycle;
+        for (; start != path.end(); ++start) {
+          cycle.push_back(start->first);
+        }
+        cycle.push_back(after);
+        return cycle;
+      }
+      if (states[after] == State::Unvisited) {
+        states[after] = State::OnPath;
+        path.emplace_back(after, 0);
+      }
+    }
+  }
+  return {};
+}
+}  // namespace datalint::layout
@@ -0,0 +1,146 @@
+#include <datalint/ContentHash.h>
+#include <datalint/MinimalPerfectHash.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// Hash-and-displace: keys are hashed into buckets, and each bucket, largest first, is given a
+// displacement that sends all its keys to free slots. A lookup is one key hash, two table reads and
+// no comparison. The table starts with one slot per key; when no seed can place a large set in it,
+// the table grows by an eighth at a time, trading a few unused slots for a construction that always
+// succeeds.
+
+namespace {
+/// @brief Average number of keys per bucket; smaller buckets are quicker to place
+constexpr std::size_t kKeysPerBucket = 2;
+/// @brief Displacements tried for one bucket before starting over with another seed
+constexpr std::uint32_t kMaxDisplacement = 1u << 16;
+/// @brief Seeds tried for one table size before growing the table. With one slot per key, the last
+/// buckets of a large set have so few free slots left that kMaxDisplacement tries rarely find one,
+/// whatever the seed, so growing soon is quicker than trying many seeds.
+constexpr std::uint64_t kSeedsPerTableSize = 2;
+/// @brief Table sizes tried before giving up, far beyond what any set of distinct keys needs: each
+/// grows the table by an eighth, and a table a few times larger than the set places it at once
+constexpr std::size_t kMaxTableSizes = 32;
+/// @brief Marker for a free slot during construction
+constexpr std::uint32_t kFreeSlot = std::numeric_limits<std::uint32_t>::max();
+
+/// @brief Finalizer spreading a hash over all 64 bits
+std::uint64_t Mix(std::uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+}  // namespace
+
+namespace datalint {
+
+MinimalPerfectHash::MinimalPerfectHash(std::span<const std::string_view> keys) {
+  if (keys.empty()) {
+    return;
+  }
+  std::vector<std::string_view> sorted(keys.begin(), keys.end());
+  std::sort(sorted.begin(), sorted.end());
+  if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+    throw std::invalid_argument("MinimalPerfectHash: duplicate key");
+  }
+
+  const std::size_t bucketCount = (keys.size() + kKeysPerBucket - 1) / kKeysPerBucket;
+  std::vector<std::uint64_t> hashes(keys.size());
+  std::vector<std::vector<std::uint32_t>> buckets(bucketCount);
+  std::vector<std::uint32_t> order(bucketCount);
+  std::vector<std::size_t> slots;
+  KeyCount_ = keys.size();
+  Displacements_.resize(bucketCount);
+
+  // Start with one slot per key, the minimal table, unless the set is so large that the last
+  // buckets cannot expect to find the last free slots within kMaxDisplacement tries; grow the table
+  // when no seed places every bucket
+  std::size_t slotCount = keys.size();
+  if (slotCount > kMaxDisplacement / 4) {
+    slotCount += slotCount / 8;
+  }
+  for (std::size_t round = 0; round < kMaxTableSizes * kSeedsPerTableSize; ++round) {
+    if (round > 0 && round % kSeedsPerTableSize == 0) {
+      slotCount += slotCount / 8 + 1;
+    }
+    Seed_ = round;
+    Indices_.resize(slotCount);
+    for (auto& bucket : buckets) {
+      bucket.clear();
+    }
+    for (std::uint32_t i = 0; i < keys.size(); ++i) {
+      hashes[i] = Hash(keys[i]);
+      buckets[hashes[i] % bucketCount].push_back(i);
+    }
+    // Place the largest buckets first, while most slots are free
+    for (std::uint32_t b = 0; b < bucketCount; ++b) {
+      order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::uint32_t lhs, std::uint32_t rhs) {
+      return buckets[lhs].size() > buckets[rhs].size();
+    });
+    std::fill(Indices_.begin(), Indices_.end(), kFreeSlot);
+    std::fill(Displacements_.begin(), Displacements_.end(), 0);
+
+    bool placedAll = true;
+    for (const std::uint32_t b : order) {
+      const auto& bucket = buckets[b];
+      if (bucket.empty()) {
+        break;
+      }
+      bool placed = false;
+      for (std::uint32_t displacement = 0; displacement < kMaxDisplacement && !placed;
+           ++displacement) {
+        slots.clear();
+        placed = true;
+        for (const std::uint32_t key : bucket) {
+          const std::size_t slot = Slot(hashes[key], displacement);
+          if (Indices_[slot] != kFreeSlot ||
+              std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+            placed = false;
+            break;
+          }
+          slots.push_back(slot);
+        }
+        if (placed) {
+          Displacements_[b] = displacement;
+          for (std::size_t k = 0; k < bucket.size(); ++k) {
+            Indices_[slots[k]] = bucket[k];
+          }
+        }
+      }
+      if (!placed) {
+        placedAll = false;
+        break;
+      }
+    }
+    if (placedAll) {
+      // Slots left free by a grown table map foreign keys to some key, like any other slot
+      std::replace(Indices_.begin(), Indices_.end(), kFreeSlot, std::uint32_t{0});
+      return;
+    }
+  }
+  throw std::runtime_error("MinimalPerfectHash: could not place " + std::to_string(keys.size()) +
+                           " keys");
+}
+
+std::uint32_t MinimalPerfectHash::Index(std::string_view key) const noexcept {
+  const std::uint64_t hash = Hash(key);
+  return Indices_[Slot(hash, Displacements_[hash % Displacements_.size()])];
+}
+
+std::uint64_t MinimalPerfectHash::Hash(std::string_view key) const noexcept {
+  return Mix(ContentHasher().Add(Seed_).Add(key).Value());
+}
+
+std::size_t MinimalPerfectHash::Slot(std::uint64_t hash,
+                                     std::uint32_t displacement) const noexcept {
+  return Mix(hash ^ (0x9E3779B97F4A7C15ull * (displacement + 1ull))) % Indices_.size();
+}
+}  // namespace datalint
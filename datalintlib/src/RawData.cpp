@@ -1,29 +1,117 @@
 #include <datalint/RawData.h>
 #include <datalint/RawField.h>
 
+#include <cstdint>
+
 namespace datalint {
 
-RawData::RawData(std::vector<RawField> fields) {
-  this->fields = fields;
+RawData::RawData(std::pmr::vector<RawField> fields, KeyFilterPolicy keyFilterPolicy,
+                 ColumnPolicy columnPolicy)
+    : fields(std::move(fields)), columns(this->fields, Resource(), columnPolicy) {
+  BuildKeyFilter(keyFilterPolicy);
 }
-bool RawData::HasKey(const std::string& key) const {
+
+RawData::RawData(std::span<const RawField> fields, std::pmr::memory_resource* resource,
+                 KeyFilterPolicy keyFilterPolicy, ColumnPolicy columnPolicy)
+    : fields(resource), columns(fields, resource, columnPolicy) {
+  this->fields.reserve(fields.size());
   for (const auto& field : fields) {
-    if (field.Key == key) {
-      return true;
-    }
+    this->fields.push_back(CopyRawField(field, resource));
+  }
+  BuildKeyFilter(keyFilterPolicy);
+}
+
+void RawData::BuildKeyFilter(KeyFilterPolicy keyFilterPolicy) {
+  if (keyFilterPolicy != KeyFilterPolicy::BloomFilter) {
+    return;
+  }
+  const auto& keys = columns.Keys();
+  keyFilter.emplace(keys.Size(), Resource());
+  for (KeyId id = 0; id < keys.Size(); ++id) {
+    keyFilter->Insert(keys.Key(id));
   }
-  return false;
 }
-const std::vector<RawField>& RawData::Fields() const noexcept {
+
+std::optional<KeyId> RawData::FindKeyId(const SmallKey& key) const {
+  if (keyFilter && !keyFilter->MayContain(key)) {
+    return std::nullopt;
+  }
+  return columns.Keys().Find(key);
+}
+
+bool RawData::HasKey(const SmallKey& key) const {
+  return FindKeyId(key).has_value();
+}
+const std::pmr::vector<RawField>& RawData::Fields() const noexcept {
   return fields;
 }
-std::vector<const RawField*> RawData::GetFieldsByKey(const std::string& key) const {
+const RawDataColumns& RawData::Columns() const noexcept {
+  return columns;
+}
+const std::optional<KeyBloomFilter>& RawData::KeyFilter() const noexcept {
+  return keyFilter;
+}
+std::pmr::memory_resource* RawData::Resource() const noexcept {
+  return fields.get_allocator().resource();
+}
+std::vector<const RawField*> RawData::GetFieldsByKey(const SmallKey& key) const {
   std::vector<const RawField*> matchingFields;
-  for (const auto& field : fields) {
-    if (field.Key == key) {
-      matchingFields.push_back(&field);
+  const auto id = FindKeyId(key);
+  if (!id) {
+    return matchingFields;
+  }
+  const auto keyIds = columns.KeyIds();
+  for (std::size_t i = 0; i < keyIds.size(); ++i) {
+    if (keyIds[i] == *id) {
+      matchingFields.push_back(&fields[i]);
     }
   }
   return matchingFields;
 }
+std::vector<KeyOccurrences> RawData::FindKeys(std::span<const SmallKey> keys) const {
+  std::vector<KeyOccurrences> occurrences(keys.size());
+
+  // Map each present key id to the first requested slot for it; duplicate keys copy that slot
+  constexpr std::uint32_t kNoSlot = UINT32_MAX;
+  std::vector<std::uint32_t> slotOfId(columns.Keys().Size(), kNoSlot);
+  std::vector<std::uint32_t> sourceSlot(keys.size(), kNoSlot);
+  bool anyPresent = false;
+  for (std::uint32_t slot = 0; slot < keys.size(); ++slot) {
+    const auto id = FindKeyId(keys[slot]);
+    if (!id) {
+      continue;
+    }
+    anyPresent = true;
+    if (slotOfId[*id] == kNoSlot) {
+      slotOfId[*id] = slot;
+    } else {
+      sourceSlot[slot] = slotOfId[*id];
+    }
+  }
+  if (!anyPresent) {
+    return occurrences;
+  }
+
+  const auto keyIds = columns.KeyIds();
+  for (std::size_t i = 0; i < keyIds.size(); ++i) {
+    const std::uint32_t slot = slotOfId[keyIds[i]];
+    if (slot == kNoSlot) {
+      continue;
+    }
+    auto& occurrence = occurrences[slot];
+    ++occurrence.Count;
+    if (!occurrence.FirstIndex) {
+      occurrence.FirstIndex = i;
+    }
+    occurrence.LastIndex = i;
+    occurrence.Fields.push_back(&fields[i]);
+  }
+
+  for (std::size_t slot = 0; slot < keys.size(); ++slot) {
+    if (sourceSlot[slot] != kNoSlot) {
+      occurrences[slot] = occurrences[sourceSlot[slot]];
+    }
+  }
+  return occurrences;
+}
 }  // namespace datalint
@@ -0,0 +1,48 @@
+#include <datalint/RawDataColumns.h>
+#include <datalint/RawField.h>
+
+namespace datalint {
+
+RawDataColumns::RawDataColumns(std::span<const RawField> fields,
+                               std::pmr::memory_resource* resource, ColumnPolicy policy)
+    : Keys_(resource),
+      KeyIds_(resource),
+      ValueOffsets_(resource),
+      ValueLengths_(resource),
+      ValueBuffer_(resource),
+      Lines_(resource),
+      FilenameIds_(resource),
+      Filenames_(resource) {
+  KeyIds_.reserve(fields.size());
+  for (const auto& field : fields) {
+    KeyIds_.push_back(Keys_.Intern(field.Key));
+  }
+  if (policy != ColumnPolicy::All) {
+    return;
+  }
+
+  std::size_t valueBytes = 0;
+  for (const auto& field : fields) {
+    valueBytes += field.Value.size();
+  }
+
+  ValueOffsets_.reserve(fields.size());
+  ValueLengths_.reserve(fields.size());
+  ValueBuffer_.reserve(valueBytes);
+  Lines_.reserve(fields.size());
+  FilenameIds_.reserve(fields.size());
+
+  for (const auto& field : fields) {
+    ValueOffsets_.push_back(ValueBuffer_.size());
+    ValueLengths_.push_back(static_cast<std::uint32_t>(field.Value.size()));
+    ValueBuffer_ += field.Value;
+
+    // Fields almost always come from a single file, so only compare against the last filename
+    if (Filenames_.empty() || Filenames_.back() != field.Location.Filename) {
+      Filenames_.emplace_back(field.Location.Filename);
+    }
+    FilenameIds_.push_back(static_cast<std::uint32_t>(Filenames_.size() - 1));
+    Lines_.push_back(field.Location.Line);
+  }
+}
+}  // namespace datalint
@@ -0,0 +1,56 @@
+#include <datalint/RuleSpecification/AddFieldRulePatchOperation.h>
+#include <datalint/RuleSpecification/RemoveFieldRulePatchOperation.h>
+#include <datalint/RuleSpecification/RulePatchSquasher.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace datalint::rules {
+
+RulePatch RulePatchSquasher::Squash(std::string name, const VersionRange& interval,
+                                    std::span<const RulePatch> patches) const {
+  // Rules added by the sequence that are still present, and the removals applying to the base
+  std::vector<FieldRule> added;
+  std::vector<RemoveFieldRulePatchOperation::Predicate> removals;
+
+  for (const auto& patch : patches) {
+    if (!patch.AppliesTo().Overlaps(interval)) {
+      continue;
+    }
+    if (!patch.AppliesTo().Includes(interval)) {
+      throw std::invalid_argument("RulePatchSquasher: patch '" + patch.Name() +
+                                  "' applies to only part of the interval");
+    }
+    for (const auto& op : patch.Operations()) {
+      if (const auto* add = dynamic_cast<const AddFieldRulePatchOperation*>(op.get())) {
+        add->Apply(added);
+      } else if (const auto* remove =
+                     dynamic_cast<const RemoveFieldRulePatchOperation*>(op.get())) {
+        remove->Apply(added);
+        removals.push_back(remove->Pred());
+      } else {
+        throw std::invalid_argument("RulePatchSquasher: patch '" + patch.Name() +
+                                    "' contains an operation that cannot be squashed");
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<IRulePatchOperation>> operations;
+  if (removals.size() == 1) {
+    operations.push_back(std::make_unique<RemoveFieldRulePatchOperation>(removals.front()));
+  } else if (!removals.empty()) {
+    // Removing in turn with each predicate removes the rules matching any of them
+    operations.push_back(std::make_unique<RemoveFieldRulePatchOperation>(
+        [removals = std::move(removals)](const FieldRule& rule) {
+          return std::any_of(removals.begin(), removals.end(),
+                             [&rule](const auto& removal) { return removal(rule); });
+        }));
+  }
+  for (auto& rule : added) {
+    operations.push_back(std::make_unique<AddFieldRulePatchOperation>(std::move(rule)));
+  }
+  return RulePatch(std::move(name), interval, std::move(operations));
+}
+}  // namespace datalint::rules
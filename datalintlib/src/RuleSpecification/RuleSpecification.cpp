@@ -0,0 +1,39 @@
+#include <datalint/RuleSpecification/RuleSpecification.h>
+
+#include <map>
+
+namespace datalint::rules {
+
+RuleSpecification::RuleSpecification(std::vector<FieldRule> rules) : Rules_(std::move(rules)) {
+  // The id of each key in order of first rule, viewing the keys of the rules, which the
+  // specification owns
+  std::map<std::string_view, std::uint32_t, std::less<>> ids;
+  RuleKeys_.reserve(Rules_.size());
+  for (std::uint32_t rule = 0; rule < Rules_.size(); ++rule) {
+    const auto [it, inserted] = ids.try_emplace(Rules_[rule].FieldKey.View(),
+                                                static_cast<std::uint32_t>(KeyFirstRules_.size()));
+    if (inserted) {
+      KeyFirstRules_.push_back(rule);
+    }
+    RuleKeys_.push_back(it->second);
+  }
+
+  std::vector<std::string_view> keys;
+  keys.reserve(KeyFirstRules_.size());
+  for (const std::uint32_t rule : KeyFirstRules_) {
+    keys.push_back(Rules_[rule].FieldKey.View());
+  }
+  KeyHash_ = datalint::MinimalPerfectHash(keys);
+}
+
+std::optional<std::uint32_t> RuleSpecification::FindKey(std::string_view key) const noexcept {
+  if (KeyFirstRules_.empty()) {
+    return std::nullopt;
+  }
+  const std::uint32_t id = KeyHash_.Index(key);
+  if (Rules_[KeyFirstRules_[id]].FieldKey != key) {
+    return std::nullopt;
+  }
+  return id;
+}
+}  // namespace datalint::rules
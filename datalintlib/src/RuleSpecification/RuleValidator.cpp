@@ -1,14 +1,49 @@
 #include <datalint/RuleSpecification/RuleValidator.h>
 
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 namespace datalint::rules {
 
 bool RuleValidator::Validate(const RuleSpecification& ruleSpec,
                              const fieldparser::ParsedData& parsedData,
                              error::ErrorCollector& errorCollector) const {
-  bool success = true;
+  constexpr std::uint32_t kNoKey = std::numeric_limits<std::uint32_t>::max();
+  const auto& fields = parsedData.Fields();
+
+  // Bucket the fields by key id in one pass over the parsed data, keeping their order; fields no
+  // rule is on are skipped
+  std::vector<std::uint32_t> fieldKeys(fields.size());
+  std::vector<std::uint32_t> offsets(ruleSpec.KeyCount() + 1, 0);
+  for (std::size_t i = 0; i < fields.size(); ++i) {
+    fieldKeys[i] = ruleSpec.FindKey(fields[i].Key.View()).value_or(kNoKey);
+    if (fieldKeys[i] != kNoKey) {
+      ++offsets[fieldKeys[i] + 1];
+    }
+  }
+  for (std::size_t key = 0; key < ruleSpec.KeyCount(); ++key) {
+    offsets[key + 1] += offsets[key];
+  }
+  std::vector<const fieldparser::ParsedField*> buckets(offsets.back());
+  std::vector<std::uint32_t> next(offsets.begin(), offsets.end() - 1);
+  for (std::size_t i = 0; i < fields.size(); ++i) {
+    if (fieldKeys[i] != kNoKey) {
+      buckets[next[fieldKeys[i]]++] = &fields[i];
+    }
+  }
 
-  for (const auto& rule : ruleSpec.Rules()) {
-    if (!ValidateFieldRule(rule, parsedData, errorCollector)) {
+  // Evaluate the rules in order, each over the fields on its key, so that errors come in the same
+  // order as when each rule scanned all the fields
+  bool success = true;
+  const std::span<const fieldparser::ParsedField* const> allBuckets(buckets);
+  const auto& rules = ruleSpec.Rules();
+  SelectedValues selected;
+  for (std::size_t rule = 0; rule < rules.size(); ++rule) {
+    const std::uint32_t key = ruleSpec.RuleKey(rule);
+    if (!ValidateFieldRule(rules[rule],
+                           allBuckets.subspan(offsets[key], offsets[key + 1] - offsets[key]),
+                           selected, errorCollector)) {
       success = false;
     }
   }
@@ -17,34 +52,23 @@ bool RuleValidator::Validate(const RuleSpecification& ruleSpec,
 }
 
 bool RuleValidator::ValidateFieldRule(const FieldRule& rule,
-                                      const fieldparser::ParsedData& parsedData,
+                                      std::span<const fieldparser::ParsedField* const> fields,
+                                      SelectedValues& selected,
                                       error::ErrorCollector& errorCollector) const {
-  bool matchedAnyField = false;
-  bool success = true;
-
-  for (const auto& field : parsedData.Fields()) {
-    if (field.Key != rule.FieldKey) {
-      continue;
-    }
-
-    matchedAnyField = true;
-
-    const auto selectedValues = rule.ValueSelector->Select(field);
-    const auto errorCountBefore = errorCollector.ErrorCount();
-
-    for (const auto& value : selectedValues) {
-      RuleContext ctx{field, *value};
-
-      rule.ValueRule->Evaluate(ctx, errorCollector);
-    }
-
-    if (errorCollector.ErrorCount() > errorCountBefore) {
-      success = false;
-    }
+  // Gather the selected values of all the fields, then evaluate them in one call
+  selected.Values.clear();
+  selected.Fields.clear();
+  for (const auto* field : fields) {
+    rule.ValueSelector->SelectInto(*field, selected.Values);
+    selected.Fields.resize(selected.Values.size(), field);
   }
+  const auto errorCountBefore = errorCollector.ErrorCount();
+  rule.ValueRule->EvaluateBatch(selected.Values, selected.Fields, errorCollector);
+  const bool success = errorCollector.ErrorCount() == errorCountBefore;
 
-  if (!matchedAnyField) {
-    errorCollector.AddErrorLog(error::ErrorLog{"Missing required field", rule.FieldKey});
+  if (fields.empty()) {
+    errorCollector.AddErrorLog(
+        error::ErrorLog{"Missing required field", std::string(rule.FieldKey)});
     return false;
   }
 
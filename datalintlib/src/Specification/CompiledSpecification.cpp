@@ -0,0 +1,35 @@
+#include <datalint/Specification/CompiledSpecification.h>
+
+namespace datalint {
+
+namespace {
+/// @brief Bytes held by a key beyond its inline storage
+std::size_t HeapBytes(const SmallKey& key) {
+  return key.IsInline() ? 0 : key.Size();
+}
+
+/// @brief Rough overhead of a std::map node beyond its value: three pointers and the color
+constexpr std::size_t kMapNodeOverhead = 4 * sizeof(void*);
+/// @brief Rough size of a heap-allocated value rule or selector
+constexpr std::size_t kRuleObjectBytes = 32;
+}  // namespace
+
+std::size_t CompiledSpecification::ApproximateMemoryUsage() const {
+  std::size_t bytes = sizeof(CompiledSpecification);
+
+  for (const auto& [key, field] : Layout.Fields()) {
+    bytes += kMapNodeOverhead + sizeof(key) + sizeof(field) + HeapBytes(key);
+  }
+  for (const auto& [pattern, field] : Layout.FieldPatterns()) {
+    bytes += kMapNodeOverhead + sizeof(pattern) + sizeof(field) + HeapBytes(pattern);
+  }
+  for (const auto& constraint : Layout.OrderingConstraints()) {
+    bytes += sizeof(constraint) + HeapBytes(constraint.BeforeKey) + HeapBytes(constraint.AfterKey);
+  }
+  for (const auto& rule : Rules.Rules()) {
+    bytes += sizeof(rule) + HeapBytes(rule.FieldKey) + 2 * kRuleObjectBytes;
+  }
+
+  return bytes;
+}
+}  // namespace datalint
@@ -0,0 +1,557 @@
+#include <datalint/KeyPatternMatcher.h>
+#include <datalint/LayoutSpecification/ExpectedField.h>
+#include <datalint/LayoutSpecification/FieldOrderingConstraint.h>
+#include <datalint/LayoutSpecification/LayoutSpecification.h>
+#include <datalint/LayoutSpecification/OrderingGraph.h>
+#include <datalint/RuleSpecification/AllValuesSelector.h>
+#include <datalint/RuleSpecification/FieldRule.h>
+#include <datalint/RuleSpecification/IntegerInRangeRule.h>
+#include <datalint/RuleSpecification/RuleSpecification.h>
+#include <datalint/RuleSpecification/ValueAtIndexSelector.h>
+#include <datalint/Specification/SpecificationBundle.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace datalint {
+
+// File format: a Header followed by the tables listed in its sections, each starting at a multiple
+// of 8 bytes. Records refer to other records and to keys by their index in the respective table.
+
+/// @brief An interned key: a range of the key characters table
+struct SpecificationBundle::KeyRecord {
+  /// @brief The offset of the key in the key characters table
+  std::uint32_t Offset;
+  /// @brief The length of the key
+  std::uint32_t Length;
+};
+
+/// @brief A version interval
+struct SpecificationBundle::IntervalRecord {
+  /// @brief The packed first version of the interval
+  std::uint64_t Start;
+  /// @brief The index of the specification of the interval
+  std::uint32_t Specification;
+  /// @brief Padding, zero
+  std::uint32_t Reserved;
+};
+
+/// @brief A specification: ranges of the field, constraint and rule tables
+struct SpecificationBundle::SpecificationRecord {
+  /// @brief The index of the first expected field
+  std::uint32_t FirstField;
+  /// @brief The number of expected fields
+  std::uint32_t FieldCount;
+  /// @brief The index of the first ordering constraint
+  std::uint32_t FirstConstraint;
+  /// @brief The number of ordering constraints
+  std::uint32_t ConstraintCount;
+  /// @brief The index of the first field rule
+  std::uint32_t FirstRule;
+  /// @brief The number of field rules
+  std::uint32_t RuleCount;
+};
+
+/// @brief An expected field or field pattern and its count bounds
+struct SpecificationBundle::FieldRecord {
+  /// @brief The index of the key of the field, or of the pattern
+  std::uint32_t Key;
+  /// @brief The field flags: kPatternField for a field pattern
+  std::uint32_t Flags;
+  /// @brief The minimum number of occurrences
+  std::uint64_t MinCount;
+  /// @brief The maximum number of occurrences, or kUnlimited
+  std::uint64_t MaxCount;
+};
+
+/// @brief An ordering constraint between two fields
+struct SpecificationBundle::ConstraintRecord {
+  /// @brief The index of the key of the field that must come before
+  std::uint32_t BeforeKey;
+  /// @brief The index of the key of the field that must come after
+  std::uint32_t AfterKey;
+};
+
+/// @brief A field rule: the rule and selector kinds with their parameters
+struct SpecificationBundle::RuleRecord {
+  /// @brief The index of the key of the field
+  std::uint32_t Key;
+  /// @brief The kind of value rule
+  std::uint32_t RuleKind;
+  /// @brief The minimum of an IntegerInRangeRule
+  std::int64_t RuleMin;
+  /// @brief The maximum of an IntegerInRangeRule
+  std::int64_t RuleMax;
+  /// @brief The kind of value selector
+  std::uint32_t SelectorKind;
+  /// @brief Padding, zero
+  std::uint32_t Reserved;
+  /// @brief The index of a ValueAtIndexSelector
+  std::uint64_t SelectorIndex;
+};
+
+namespace {
+/// @brief The magic bytes starting a bundle file
+constexpr char kMagic[8] = {'D', 'L', 'S', 'P', 'E', 'C', 'B', '\0'};
+/// @brief Written in native byte order, reads differently on a machine of the other byte order
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+/// @brief The maximum count of an expected field without a maximum
+constexpr std::uint64_t kUnlimited = std::numeric_limits<std::uint64_t>::max();
+/// @brief The alignment of every table
+constexpr std::size_t kTableAlignment = 8;
+
+/// @brief Flag of a field record holding a field pattern
+constexpr std::uint32_t kPatternField = 1;
+
+/// @brief The kinds of value rule a bundle can hold
+enum RuleKind : std::uint32_t { kIntegerInRangeRule = 1 };
+/// @brief The kinds of value selector a bundle can hold
+enum SelectorKind : std::uint32_t { kAllValuesSelector = 1, kValueAtIndexSelector = 2 };
+
+/// @brief The tables of a bundle, in file order
+enum Table : std::size_t {
+  kKeyTable,
+  kKeyCharacterTable,
+  kIntervalTable,
+  kSpecificationTable,
+  kFieldTable,
+  kConstraintTable,
+  kRuleTable,
+  kTableCount
+};
+
+/// @brief The position of a table in the file
+struct Section {
+  /// @brief The offset of the table from the start of the file
+  std::uint64_t Offset;
+  /// @brief The number of records of the table
+  std::uint64_t Count;
+};
+
+/// @brief The start of a bundle file
+struct Header {
+  /// @brief kMagic
+  char Magic[8];
+  /// @brief SpecificationBundle::kFormatVersion
+  std::uint32_t FormatVersion;
+  /// @brief kByteOrderMark
+  std::uint32_t ByteOrderMark;
+  /// @brief The size of the file
+  std::uint64_t FileSize;
+  /// @brief The position of each table
+  Section Sections[kTableCount];
+};
+
+/// @brief Throw the error of a malformed bundle
+[[noreturn]] void ThrowMalformed(const std::string& reason) {
+  throw std::runtime_error("SpecificationBundle: malformed bundle: " + reason);
+}
+
+/// @brief Convert a table size or index to its 32-bit record representation
+std::uint32_t ToIndex(std::size_t value) {
+  if (value > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::invalid_argument("SpecificationBundle: too many entries for a bundle");
+  }
+  return static_cast<std::uint32_t>(value);
+}
+
+/// @brief Append a table to the file bytes, aligned, and record its position
+template <typename Record>
+void AppendTable(std::vector<std::byte>& bytes, const std::vector<Record>& table,
+                 Section& section) {
+  bytes.resize((bytes.size() + kTableAlignment - 1) / kTableAlignment * kTableAlignment);
+  section = Section{bytes.size(), table.size()};
+  const auto* begin = reinterpret_cast<const std::byte*>(table.data());
+  bytes.insert(bytes.end(), begin, begin + table.size() * sizeof(Record));
+}
+
+/// @brief Locate a table in the bundle bytes, checking it lies within them
+template <typename Record>
+const Record* LocateTable(const std::byte* bytes, std::size_t size, const Section& section,
+                          std::size_t& count) {
+  if (section.Offset % alignof(Record) != 0 || section.Offset > size ||
+      section.Count > (size - section.Offset) / sizeof(Record)) {
+    ThrowMalformed("table out of bounds");
+  }
+  count = static_cast<std::size_t>(section.Count);
+  return reinterpret_cast<const Record*>(bytes + section.Offset);
+}
+
+/// @brief Check a range of a table lies within it
+void CheckRange(std::uint64_t first, std::uint64_t count, std::size_t tableSize) {
+  if (first > tableSize || count > tableSize - first) {
+    ThrowMalformed("range out of bounds");
+  }
+}
+
+/// @brief Whether some values are equal, sorting them
+template <typename Value>
+bool SortAndFindDuplicate(std::vector<Value>& values) {
+  std::sort(values.begin(), values.end());
+  return std::adjacent_find(values.begin(), values.end()) != values.end();
+}
+
+/// @brief Map a file read-only; the returned bytes unmap it once released
+std::shared_ptr<const std::byte> MapFile(const std::filesystem::path& path, std::size_t& size) {
+#if defined(_WIN32)
+  // No mapping here: read the file into memory aligned for the records
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("SpecificationBundle: cannot open " + path.string());
+  }
+  const std::vector<char> content{std::istreambuf_iterator<char>(file),
+                                  std::istreambuf_iterator<char>()};
+  size = content.size();
+  std::shared_ptr<std::uint64_t[]> storage(new std::uint64_t[size / 8 + 1]);
+  std::memcpy(storage.get(), content.data(), size);
+  return std::shared_ptr<const std::byte>(storage,
+                                          reinterpret_cast<const std::byte*>(storage.get()));
+#else
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("SpecificationBundle: cannot open " + path.string());
+  }
+  struct stat status;
+  if (::fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(Header))) {
+    ::close(fd);
+    throw std::runtime_error("SpecificationBundle: not a bundle: " + path.string());
+  }
+  size = static_cast<std::size_t>(status.st_size);
+  void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("SpecificationBundle: cannot map " + path.string());
+  }
+  return std::shared_ptr<const std::byte>(
+      static_cast<const std::byte*>(mapping),
+      [size](const std::byte* bytes) { ::munmap(const_cast<std::byte*>(bytes), size); });
+#endif
+}
+}  // namespace
+
+void SpecificationBundle::Write(const VersionedSpecifications& specifications,
+                                const std::filesystem::path& path) {
+  std::vector<KeyRecord> keys;
+  std::vector<char> keyCharacters;
+  std::vector<IntervalRecord> intervals;
+  std::vector<SpecificationRecord> specificationRecords;
+  std::vector<FieldRecord> fields;
+  std::vector<ConstraintRecord> constraints;
+  std::vector<RuleRecord> rules;
+
+  // The keys outlive the tables, as they belong to the specifications
+  std::map<std::string_view, std::uint32_t, std::less<>> keyIndices;
+  auto intern = [&](std::string_view key) {
+    const auto [it, inserted] = keyIndices.try_emplace(key, ToIndex(keys.size()));
+    if (inserted) {
+      keys.push_back(KeyRecord{ToIndex(keyCharacters.size()), ToIndex(key.size())});
+      keyCharacters.insert(keyCharacters.end(), key.begin(), key.end());
+    }
+    return it->second;
+  };
+
+  // Intervals sharing a specification share its record
+  std::map<const CompiledSpecification*, std::uint32_t> specificationIndices;
+  for (std::size_t i = 0; i < specifications.IntervalCount(); ++i) {
+    const CompiledSpecification& specification = *specifications.IntervalSpecification(i);
+    const auto [it, inserted] =
+        specificationIndices.try_emplace(&specification, ToIndex(specificationRecords.size()));
+    intervals.push_back(IntervalRecord{specifications.IntervalStart(i).Packed(), it->second, 0});
+    if (!inserted) {
+      continue;
+    }
+
+    SpecificationRecord record{ToIndex(fields.size()), 0, ToIndex(constraints.size()), 0,
+                               ToIndex(rules.size()), 0};
+    for (const auto& [key, field] : specification.Layout.Fields()) {
+      fields.push_back(FieldRecord{intern(key), 0, field.MinCount(),
+                                   field.MaxCount() ? *field.MaxCount() : kUnlimited});
+    }
+    for (const auto& [pattern, field] : specification.Layout.FieldPatterns()) {
+      fields.push_back(FieldRecord{intern(pattern), kPatternField, field.MinCount(),
+                                   field.MaxCount() ? *field.MaxCount() : kUnlimited});
+    }
+    for (const auto& constraint : specification.Layout.OrderingConstraints()) {
+      constraints.push_back(
+          ConstraintRecord{intern(constraint.BeforeKey), intern(constraint.AfterKey)});
+    }
+    for (const auto& rule : specification.Rules.Rules()) {
+      RuleRecord ruleRecord{intern(rule.FieldKey), 0, 0, 0, 0, 0, 0};
+      if (const auto* range =
+              dynamic_cast<const rules::IntegerInRangeRule*>(rule.ValueRule.get())) {
+        ruleRecord.RuleKind = kIntegerInRangeRule;
+        ruleRecord.RuleMin = range->Min();
+        ruleRecord.RuleMax = range->Max();
+      } else {
+        throw std::invalid_argument("SpecificationBundle: unsupported value rule for field: " +
+                                    std::string(rule.FieldKey));
+      }
+      if (dynamic_cast<const rules::AllValuesSelector*>(rule.ValueSelector.get())) {
+        ruleRecord.SelectorKind = kAllValuesSelector;
+      } else if (const auto* atIndex =
+                     dynamic_cast<const rules::ValueAtIndexSelector*>(rule.ValueSelector.get())) {
+        ruleRecord.SelectorKind = kValueAtIndexSelector;
+        ruleRecord.SelectorIndex = atIndex->Index();
+      } else {
+        throw std::invalid_argument("SpecificationBundle: unsupported value selector for field: " +
+                                    std::string(rule.FieldKey));
+      }
+      rules.push_back(ruleRecord);
+    }
+    record.FieldCount = ToIndex(fields.size() - record.FirstField);
+    record.ConstraintCount = ToIndex(constraints.size() - record.FirstConstraint);
+    record.RuleCount = ToIndex(rules.size() - record.FirstRule);
+    specificationRecords.push_back(record);
+  }
+
+  Header header{};
+  std::memcpy(header.Magic, kMagic, sizeof(kMagic));
+  header.FormatVersion = kFormatVersion;
+  header.ByteOrderMark = kByteOrderMark;
+
+  std::vector<std::byte> bytes(sizeof(Header));
+  AppendTable(bytes, keys, header.Sections[kKeyTable]);
+  AppendTable(bytes, keyCharacters, header.Sections[kKeyCharacterTable]);
+  AppendTable(bytes, intervals, header.Sections[kIntervalTable]);
+  AppendTable(bytes, specificationRecords, header.Sections[kSpecificationTable]);
+  AppendTable(bytes, fields, header.Sections[kFieldTable]);
+  AppendTable(bytes, constraints, header.Sections[kConstraintTable]);
+  AppendTable(bytes, rules, header.Sections[kRuleTable]);
+  header.FileSize = bytes.size();
+  std::memcpy(bytes.data(), &header, sizeof(Header));
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(bytes.data()),
+             static_cast<std::streamsize>(bytes.size()));
+  if (!file) {
+    throw std::runtime_error("SpecificationBundle: cannot write " + path.string());
+  }
+}
+
+SpecificationBundle SpecificationBundle::Load(const std::filesystem::path& path) {
+  std::size_t size = 0;
+  auto bytes = MapFile(path, size);
+  return SpecificationBundle(std::move(bytes), size);
+}
+
+SpecificationBundle::SpecificationBundle(std::shared_ptr<const std::byte> bytes, std::size_t size)
+    : Bytes_(std::move(bytes)) {
+  if (size < sizeof(Header)) {
+    ThrowMalformed("truncated header");
+  }
+  Header header;
+  std::memcpy(&header, Bytes_.get(), sizeof(Header));
+  if (std::memcmp(header.Magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("SpecificationBundle: not a bundle");
+  }
+  if (header.ByteOrderMark != kByteOrderMark) {
+    throw std::runtime_error("SpecificationBundle: bundle written with another byte order");
+  }
+  if (header.FormatVersion != kFormatVersion) {
+    throw std::runtime_error("SpecificationBundle: unsupported format version " +
+                             std::to_string(header.FormatVersion));
+  }
+  if (header.FileSize != size) {
+    ThrowMalformed("size mismatch");
+  }
+
+  // Fix up the table pointers into the mapping
+  const std::byte* base = Bytes_.get();
+  std::size_t keyCount = 0;
+  std::size_t characterCount = 0;
+  std::size_t fieldCount = 0;
+  std::size_t constraintCount = 0;
+  std::size_t ruleCount = 0;
+  Keys_ = LocateTable<KeyRecord>(base, size, header.Sections[kKeyTable], keyCount);
+  KeyCharacters_ =
+      LocateTable<char>(base, size, header.Sections[kKeyCharacterTable], characterCount);
+  Intervals_ =
+      LocateTable<IntervalRecord>(base, size, header.Sections[kIntervalTable], IntervalCount_);
+  Specifications_ = LocateTable<SpecificationRecord>(
+      base, size, header.Sections[kSpecificationTable], SpecificationCount_);
+  Fields_ = LocateTable<FieldRecord>(base, size, header.Sections[kFieldTable], fieldCount);
+  Constraints_ =
+      LocateTable<ConstraintRecord>(base, size, header.Sections[kConstraintTable], constraintCount);
+  Rules_ = LocateTable<RuleRecord>(base, size, header.Sections[kRuleTable], ruleCount);
+
+  // Check every index, so that Find needs no checks
+  for (std::size_t i = 0; i < keyCount; ++i) {
+    CheckRange(Keys_[i].Offset, Keys_[i].Length, characterCount);
+  }
+  if (IntervalCount_ == 0 || Intervals_[0].Start != 0) {
+    ThrowMalformed("intervals must start at 0.0.0");
+  }
+  for (std::size_t i = 0; i < IntervalCount_; ++i) {
+    if ((i > 0 && Intervals_[i].Start <= Intervals_[i - 1].Start) ||
+        Intervals_[i].Specification >= SpecificationCount_) {
+      ThrowMalformed("invalid interval");
+    }
+  }
+  for (std::size_t i = 0; i < SpecificationCount_; ++i) {
+    const SpecificationRecord& record = Specifications_[i];
+    CheckRange(record.FirstField, record.FieldCount, fieldCount);
+    CheckRange(record.FirstConstraint, record.ConstraintCount, constraintCount);
+    CheckRange(record.FirstRule, record.RuleCount, ruleCount);
+  }
+  for (std::size_t i = 0; i < fieldCount; ++i) {
+    if (Fields_[i].Key >= keyCount || (Fields_[i].Flags & ~kPatternField) != 0 ||
+        Fields_[i].MinCount > Fields_[i].MaxCount) {
+      ThrowMalformed("invalid field");
+    }
+    if (Fields_[i].Flags & kPatternField) {
+      try {
+        KeyPatternMatcher::CheckSyntax(std::string_view(
+            KeyCharacters_ + Keys_[Fields_[i].Key].Offset, Keys_[Fields_[i].Key].Length));
+      } catch (const std::invalid_argument&) {
+        ThrowMalformed("invalid field pattern");
+      }
+    }
+  }
+  for (std::size_t i = 0; i < constraintCount; ++i) {
+    if (Constraints_[i].BeforeKey >= keyCount || Constraints_[i].AfterKey >= keyCount) {
+      ThrowMalformed("invalid ordering constraint");
+    }
+  }
+  for (std::size_t i = 0; i < ruleCount; ++i) {
+    const RuleRecord& rule = Rules_[i];
+    const bool validRule = rule.RuleKind == kIntegerInRangeRule &&
+                           rule.RuleMin >= std::numeric_limits<int>::min() &&
+                           rule.RuleMax <= std::numeric_limits<int>::max() &&
+                           rule.RuleMin <= rule.RuleMax;
+    const bool validSelector =
+        rule.SelectorKind == kAllValuesSelector || rule.SelectorKind == kValueAtIndexSelector;
+    if (rule.Key >= keyCount || !validRule || !validSelector) {
+      ThrowMalformed("invalid field rule");
+    }
+  }
+
+  // Keys are interned, so each specification record can be checked on key indices: its fields,
+  // patterns and ordering constraints must be distinct, and the constraints without a cycle, as
+  // in a built specification
+  std::vector<std::string_view> keyTexts;
+  keyTexts.reserve(keyCount);
+  for (std::size_t i = 0; i < keyCount; ++i) {
+    keyTexts.emplace_back(KeyCharacters_ + Keys_[i].Offset, Keys_[i].Length);
+  }
+  if (SortAndFindDuplicate(keyTexts)) {
+    ThrowMalformed("duplicate key");
+  }
+  std::vector<std::uint32_t> fieldKeys;
+  std::vector<std::uint32_t> patternKeys;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> constraintKeys;
+  std::vector<std::uint32_t> orderedKeys;
+  std::vector<layout::OrderingGraph::Edge> edges;
+  for (std::size_t i = 0; i < SpecificationCount_; ++i) {
+    const SpecificationRecord& record = Specifications_[i];
+    fieldKeys.clear();
+    patternKeys.clear();
+    for (std::uint32_t j = 0; j < record.FieldCount; ++j) {
+      const FieldRecord& field = Fields_[record.FirstField + j];
+      (field.Flags & kPatternField ? patternKeys : fieldKeys).push_back(field.Key);
+    }
+    if (SortAndFindDuplicate(fieldKeys) || SortAndFindDuplicate(patternKeys)) {
+      ThrowMalformed("duplicate field");
+    }
+
+    constraintKeys.clear();
+    orderedKeys.clear();
+    for (std::uint32_t j = 0; j < record.ConstraintCount; ++j) {
+      const ConstraintRecord& constraint = Constraints_[record.FirstConstraint + j];
+      constraintKeys.emplace_back(constraint.BeforeKey, constraint.AfterKey);
+      orderedKeys.push_back(constraint.BeforeKey);
+      orderedKeys.push_back(constraint.AfterKey);
+    }
+    if (SortAndFindDuplicate(constraintKeys)) {
+      ThrowMalformed("duplicate ordering constraint");
+    }
+    std::sort(orderedKeys.begin(), orderedKeys.end());
+    orderedKeys.erase(std::unique(orderedKeys.begin(), orderedKeys.end()), orderedKeys.end());
+    auto id = [&orderedKeys](std::uint32_t key) {
+      return static_cast<layout::OrderingGraph::Id>(
+          std::lower_bound(orderedKeys.begin(), orderedKeys.end(), key) - orderedKeys.begin());
+    };
+    edges.clear();
+    for (const auto& [before, after] : constraintKeys) {
+      edges.push_back(layout::OrderingGraph::Edge{id(before), id(after)});
+    }
+    if (!layout::OrderingGraph::FindCycle(orderedKeys.size(), edges).empty()) {
+      ThrowMalformed("ordering constraints form a cycle");
+    }
+  }
+}
+
+CompiledSpecification SpecificationBundle::Find(const Version& version) const {
+  // The last interval starting at or before the version; the first interval starts at 0.0.0
+  const IntervalRecord* next = std::upper_bound(
+      Intervals_, Intervals_ + IntervalCount_, version.Packed(),
+      [](std::uint64_t packed, const IntervalRecord& interval) { return packed < interval.Start; });
+  const SpecificationRecord& record = Specifications_[(next - 1)->Specification];
+
+  auto key = [this](std::uint32_t index) {
+    return std::string_view(KeyCharacters_ + Keys_[index].Offset, Keys_[index].Length);
+  };
+
+  layout::LayoutSpecification layoutSpec;
+  for (std::uint32_t i = 0; i < record.FieldCount; ++i) {
+    const FieldRecord& field = Fields_[record.FirstField + i];
+    const layout::ExpectedField bounds(
+        field.MinCount, field.MaxCount == kUnlimited ? std::nullopt
+                                                     : std::optional<std::size_t>(field.MaxCount));
+    if (field.Flags & kPatternField) {
+      layoutSpec.AddExpectedFieldPattern(key(field.Key), bounds);
+    } else {
+      layoutSpec.AddExpectedField(key(field.Key), bounds);
+    }
+  }
+  for (std::uint32_t i = 0; i < record.ConstraintCount; ++i) {
+    const ConstraintRecord& constraint = Constraints_[record.FirstConstraint + i];
+    layoutSpec.AddOrderingConstraint(
+        layout::FieldOrderingConstraint{key(constraint.BeforeKey), key(constraint.AfterKey)});
+  }
+
+  std::vector<rules::FieldRule> fieldRules;
+  fieldRules.reserve(record.RuleCount);
+  for (std::uint32_t i = 0; i < record.RuleCount; ++i) {
+    const RuleRecord& rule = Rules_[record.FirstRule + i];
+    std::unique_ptr<rules::IValueSelector> selector;
+    if (rule.SelectorKind == kValueAtIndexSelector) {
+      selector = std::make_unique<rules::ValueAtIndexSelector>(rule.SelectorIndex);
+    } else {
+      selector = std::make_unique<rules::AllValuesSelector>();
+    }
+    fieldRules.push_back(rules::FieldRule{
+        key(rule.Key),
+        std::make_unique<rules::IntegerInRangeRule>(static_cast<int>(rule.RuleMin),
+                                                    static_cast<int>(rule.RuleMax)),
+        std::move(selector)});
+  }
+
+  return CompiledSpecification{std::move(layoutSpec),
+                               rules::RuleSpecification(std::move(fieldRules))};
+}
+
+std::size_t SpecificationBundle::IntervalCount() const noexcept { return IntervalCount_; }
+
+std::size_t SpecificationBundle::SpecificationCount() const noexcept {
+  return SpecificationCount_;
+}
+}  // namespace datalint
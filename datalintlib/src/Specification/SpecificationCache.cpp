@@ -0,0 +1,120 @@
+#include <datalint/Specification/SpecificationCache.h>
+
+#include <exception>
+
+namespace datalint {
+
+SpecificationCache::SpecificationCache(std::size_t maxBytes) : MaxBytes_(maxBytes) {}
+
+std::shared_ptr<const CompiledSpecification> SpecificationCache::GetOrBuild(
+    const ApplicationDescriptor& descriptor, const BuildFunction& build) {
+  Key key{descriptor.Name(), descriptor.Version()};
+  std::promise<std::shared_ptr<const CompiledSpecification>> promise;
+
+  {
+    std::unique_lock lock(Mutex_);
+    const auto it = Entries_.find(key);
+    if (it != Entries_.end()) {
+      Touch(it->second);
+      const auto specification = it->second.Specification;
+      lock.unlock();
+      // Waits if another thread is still building this version
+      return specification.get();
+    }
+    Recency_.push_front(key);
+    Entry entry;
+    entry.Specification = promise.get_future().share();
+    entry.Recency = Recency_.begin();
+    Entries_.emplace(key, std::move(entry));
+  }
+
+  // Build outside the lock, so that other versions can be looked up and built meanwhile
+  std::shared_ptr<const CompiledSpecification> specification;
+  try {
+    specification = std::make_shared<const CompiledSpecification>(build(descriptor));
+  } catch (...) {
+    {
+      std::lock_guard lock(Mutex_);
+      const auto it = Entries_.find(key);
+      Recency_.erase(it->second.Recency);
+      Entries_.erase(it);
+    }
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+  promise.set_value(specification);
+
+  std::lock_guard lock(Mutex_);
+  auto& entry = Entries_.at(key);
+  entry.Ready = true;
+  entry.Bytes = specification->ApproximateMemoryUsage();
+  Bytes_ += entry.Bytes;
+  Evict(key);
+  return specification;
+}
+
+std::shared_ptr<const CompiledSpecification> SpecificationCache::Find(
+    const ApplicationDescriptor& descriptor) {
+  std::lock_guard lock(Mutex_);
+  const auto it = Entries_.find(Key{descriptor.Name(), descriptor.Version()});
+  if (it == Entries_.end() || !it->second.Ready) {
+    return nullptr;
+  }
+  Touch(it->second);
+  return it->second.Specification.get();
+}
+
+std::size_t SpecificationCache::Size() const {
+  std::lock_guard lock(Mutex_);
+  return Entries_.size();
+}
+
+std::size_t SpecificationCache::MemoryUsage() const {
+  std::lock_guard lock(Mutex_);
+  return Bytes_;
+}
+
+std::size_t SpecificationCache::MaxBytes() const noexcept {
+  return MaxBytes_;
+}
+
+void SpecificationCache::Clear() {
+  std::lock_guard lock(Mutex_);
+  // Pending builds stay, their builders still have to record their result
+  for (auto it = Entries_.begin(); it != Entries_.end();) {
+    if (it->second.Ready) {
+      Recency_.erase(it->second.Recency);
+      it = Entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  Bytes_ = 0;
+}
+
+void SpecificationCache::Touch(Entry& entry) {
+  Recency_.splice(Recency_.begin(), Recency_, entry.Recency);
+}
+
+void SpecificationCache::Evict(const Key& keep) {
+  auto it = Recency_.end();
+  while (Bytes_ > MaxBytes_ && it != Recency_.begin()) {
+    --it;
+    const auto entry = Entries_.find(*it);
+    if (!entry->second.Ready || *it == keep) {
+      continue;
+    }
+    Bytes_ -= entry->second.Bytes;
+    Entries_.erase(entry);
+    it = Recency_.erase(it);
+  }
+
+  // A single specification larger than the whole budget is returned but not kept
+  if (Bytes_ > MaxBytes_) {
+    const auto entry = Entries_.find(keep);
+    Bytes_ -= entry->second.Bytes;
+    Recency_.erase(entry->second.Recency);
+    Entries_.erase(entry);
+  }
+}
+}  // namespace datalint
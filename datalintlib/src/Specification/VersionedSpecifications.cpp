@@ -0,0 +1,125 @@
+#include <datalint/LayoutSpecification/LayoutSpecificationBuilder.h>
+#include <datalint/RuleSpecification/RuleSpecificationBuilder.h>
+#include <datalint/Specification/VersionedSpecifications.h>
+#include <datalint/Version/VersionRange.h>
+
+#include <algorithm>
+#include <map>
+
+namespace datalint {
+
+namespace {
+/// @brief The packed value of the largest version
+constexpr std::uint64_t kMaxPackedVersion =
+    Version(Version::kMaxComponent, Version::kMaxComponent, Version::kMaxComponent).Packed();
+
+/// @brief Add the interval boundaries of a version range: its first version and the version
+/// following its last one
+void AddEndpoints(const VersionRange& range, std::vector<std::uint64_t>& starts) {
+  if (const auto min = range.Min()) {
+    starts.push_back(min->Packed());
+  }
+  // Every packed value up to kMaxPackedVersion is a version, so the next version is packed + 1
+  if (const auto max = range.Max(); max && max->Packed() < kMaxPackedVersion) {
+    starts.push_back(max->Packed() + 1);
+  }
+}
+}  // namespace
+
+VersionedSpecifications::VersionedSpecifications(
+    std::span<const layout::LayoutPatch> layoutPatches,
+    std::span<const rules::RulePatch> rulePatches) {
+  IntervalStarts_.push_back(0);
+  for (const auto& patch : layoutPatches) {
+    AddEndpoints(patch.AppliesTo(), IntervalStarts_);
+  }
+  for (const auto& patch : rulePatches) {
+    AddEndpoints(patch.AppliesTo(), IntervalStarts_);
+  }
+  std::sort(IntervalStarts_.begin(), IntervalStarts_.end());
+  IntervalStarts_.erase(std::unique(IntervalStarts_.begin(), IntervalStarts_.end()),
+                        IntervalStarts_.end());
+
+  // Intervals with the same applicable patches share one specification
+  std::map<std::vector<bool>, std::shared_ptr<const CompiledSpecification>> built;
+  layout::LayoutSpecificationBuilder layoutBuilder;
+  rules::RuleSpecificationBuilder ruleBuilder;
+  IntervalSpecifications_.reserve(IntervalStarts_.size());
+
+  // The layout after each applicable patch of the previous interval: snapshots[k] has the first k
+  // patches applied. The next interval resumes from the longest common prefix of applicable
+  // patches, so its layout shares storage with the previous one and costs only the difference.
+  std::vector<std::size_t> appliedPatches;
+  std::vector<layout::LayoutSpecification> snapshots(1);
+
+  for (const std::uint64_t start : IntervalStarts_) {
+    const Version version = Version::FromPacked(start);
+    std::vector<bool> applicable;
+    applicable.reserve(layoutPatches.size() + rulePatches.size());
+    for (const auto& patch : layoutPatches) {
+      applicable.push_back(patch.AppliesTo().Contains(version));
+    }
+    for (const auto& patch : rulePatches) {
+      applicable.push_back(patch.AppliesTo().Contains(version));
+    }
+
+    auto& specification = built[applicable];
+    if (!specification) {
+      std::size_t common = 0;
+      std::size_t next = 0;
+      for (std::size_t i = 0; i < layoutPatches.size(); ++i) {
+        if (!applicable[i]) {
+          continue;
+        }
+        if (next == common && common < appliedPatches.size() && appliedPatches[common] == i) {
+          ++common;
+        }
+        ++next;
+      }
+      appliedPatches.resize(common);
+      snapshots.resize(common + 1);
+      for (std::size_t i = common == 0 ? 0 : appliedPatches.back() + 1; i < layoutPatches.size();
+           ++i) {
+        if (!applicable[i]) {
+          continue;
+        }
+        layout::LayoutSpecification snapshot = snapshots.back();
+        layoutBuilder.ApplyPatch(snapshot, layoutPatches[i]);
+        snapshots.push_back(std::move(snapshot));
+        appliedPatches.push_back(i);
+      }
+
+      layoutBuilder.RejectOrderingCycle(snapshots.back());
+      specification = std::make_shared<const CompiledSpecification>(
+          CompiledSpecification{snapshots.back(), ruleBuilder.Build(version, rulePatches)});
+    }
+    IntervalSpecifications_.push_back(specification);
+  }
+  SpecificationCount_ = built.size();
+}
+
+const std::shared_ptr<const CompiledSpecification>& VersionedSpecifications::Find(
+    const Version& version) const {
+  // The last interval starting at or before the version; the first interval starts at 0.0.0
+  const auto next =
+      std::upper_bound(IntervalStarts_.begin(), IntervalStarts_.end(), version.Packed());
+  return IntervalSpecifications_[static_cast<std::size_t>(next - IntervalStarts_.begin()) - 1];
+}
+
+std::size_t VersionedSpecifications::IntervalCount() const noexcept {
+  return IntervalStarts_.size();
+}
+
+Version VersionedSpecifications::IntervalStart(std::size_t index) const {
+  return Version::FromPacked(IntervalStarts_.at(index));
+}
+
+const std::shared_ptr<const CompiledSpecification>& VersionedSpecifications::IntervalSpecification(
+    std::size_t index) const {
+  return IntervalSpecifications_.at(index);
+}
+
+std::size_t VersionedSpecifications::SpecificationCount() const noexcept {
+  return SpecificationCount_;
+}
+}  // namespace datalint
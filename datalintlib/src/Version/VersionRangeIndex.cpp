@@ -0,0 +1,81 @@
+#include <datalint/Version/VersionRangeIndex.h>
+
+#include <algorithm>
+
+namespace datalint {
+
+namespace {
+/// @brief The packed value of the largest version
+constexpr std::uint64_t kMaxPackedVersion =
+    Version(Version::kMaxComponent, Version::kMaxComponent, Version::kMaxComponent).Packed();
+
+/// @brief The packed first version of a range
+std::uint64_t First(const VersionRange& range) {
+  const auto min = range.Min();
+  return min ? min->Packed() : 0;
+}
+
+/// @brief The packed version following the last version of a range; past kMaxPackedVersion for
+/// ranges without an upper bound
+std::uint64_t End(const VersionRange& range) {
+  const auto max = range.Max();
+  return max ? max->Packed() + 1 : kMaxPackedVersion + 1;
+}
+}  // namespace
+
+VersionRangeIndex::VersionRangeIndex(std::span<const VersionRange> ranges) : Size_(ranges.size()) {
+  IntervalStarts_.push_back(0);
+  for (const auto& range : ranges) {
+    IntervalStarts_.push_back(First(range));
+    if (End(range) <= kMaxPackedVersion) {
+      IntervalStarts_.push_back(End(range));
+    }
+  }
+  std::sort(IntervalStarts_.begin(), IntervalStarts_.end());
+  IntervalStarts_.erase(std::unique(IntervalStarts_.begin(), IntervalStarts_.end()),
+                        IntervalStarts_.end());
+
+  while (LeafCount_ < IntervalStarts_.size()) {
+    LeafCount_ *= 2;
+  }
+  Nodes_.resize(2 * LeafCount_);
+
+  // Store each range at the canonical nodes covering its elementary intervals [lo, hi). Ranges are
+  // added in order, so every node lists its positions in ascending order.
+  const auto intervalOf = [this](std::uint64_t packed) {
+    return static_cast<std::size_t>(
+        std::lower_bound(IntervalStarts_.begin(), IntervalStarts_.end(), packed) -
+        IntervalStarts_.begin());
+  };
+  for (std::uint32_t position = 0; position < ranges.size(); ++position) {
+    std::size_t lo = intervalOf(First(ranges[position])) + LeafCount_;
+    std::size_t hi = intervalOf(End(ranges[position])) + LeafCount_;
+    for (; lo < hi; lo /= 2, hi /= 2) {
+      if (lo % 2 == 1) {
+        Nodes_[lo++].push_back(position);
+      }
+      if (hi % 2 == 1) {
+        Nodes_[--hi].push_back(position);
+      }
+    }
+  }
+}
+
+std::vector<std::size_t> VersionRangeIndex::Find(const Version& version) const {
+  const auto next =
+      std::upper_bound(IntervalStarts_.begin(), IntervalStarts_.end(), version.Packed());
+  const auto interval = static_cast<std::size_t>(next - IntervalStarts_.begin()) - 1;
+
+  std::vector<std::size_t> positions;
+  for (std::size_t node = LeafCount_ + interval; node >= 1; node /= 2) {
+    positions.insert(positions.end(), Nodes_[node].begin(), Nodes_[node].end());
+  }
+  // A range is stored at most once on a leaf-to-root path
+  std::sort(positions.begin(), positions.end());
+  return positions;
+}
+
+std::size_t VersionRangeIndex::Size() const noexcept {
+  return Size_;
+}
+}  // namespace datalint
@@ -8,10 +8,10 @@
 #include <datalint/FieldParser/IFieldParser.h>
 #include <datalint/FieldParser/ParsedDataBuilder.h>
 #include <datalint/FileParser/CsvFileParser.h>
+#include <datalint/LayoutSpecification/CompiledLayout.h>
 #include <datalint/LayoutSpecification/FieldOrderingConstraint.h>
 #include <datalint/LayoutSpecification/LayoutPatch.h>
 #include <datalint/LayoutSpecification/LayoutSpecificationBuilder.h>
-#include <datalint/LayoutSpecification/LayoutSpecificationValidator.h>
 #include <datalint/RawData.h>
 #include <datalint/RawField.h>
 #include <datalint/RuleSpecification/AddFieldRulePatchOperation.h>
@@ -22,18 +22,110 @@
 #include <datalint/RuleSpecification/RuleSpecificationBuilder.h>
 #include <datalint/RuleSpecification/RuleValidator.h>
 #include <datalint/RuleSpecification/ValueAtIndexSelector.h>
+#include <datalint/Specification/CompiledSpecification.h>
+#include <datalint/Specification/SpecificationBundle.h>
+#include <datalint/Specification/VersionedSpecifications.h>
+#include <datalint/Version/Version.h>
 
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace {
+/// @brief The layout patches of the example application
+/// @return the layout patches, in application order
+std::vector<datalint::layout::LayoutPatch> MakeLayoutPatches() {
+  using namespace datalint::layout;
+
+  const LayoutPatch layoutPatch1(
+      "patch1", datalint::VersionRange::All(),
+      std::vector<LayoutPatchOperation>{
+          AddField{"key1", ExpectedField{1, std::nullopt}},
+          AddField{"key2", ExpectedField{1, std::nullopt}},
+          AddField{"key10", ExpectedField{1, std::nullopt}},
+          AddField{"ApplicationName", ExpectedField{1, std::nullopt}},
+          AddField{"ApplicationVersion", ExpectedField{1, std::nullopt}},
+          // ApplicationName must come before ApplicationVersion
+          AddFieldOrdering{"ApplicationName", "ApplicationVersion"},
+      });
+
+  return {layoutPatch1};
+}
+
+/// @brief The rule patches of the example application
+/// @return the rule patches, in application order
+std::vector<datalint::rules::RulePatch> MakeRulePatches() {
+  using namespace datalint::rules;
+
+  FieldRule key10Rule{"key10", std::make_unique<IntegerInRangeRule>(0, 10),
+                      std::make_unique<ValueAtIndexSelector>(0)};
+
+  auto addKey1Operation = std::make_unique<AddFieldRulePatchOperation>(std::move(key10Rule));
+
+  std::vector<std::unique_ptr<IRulePatchOperation>> ops;
+  ops.push_back(std::move(addKey1Operation));
+
+  RulePatch patch("example-rule-patch", datalint::VersionRange::All(), std::move(ops));
+
+  std::vector<RulePatch> rulePatches;
+  rulePatches.push_back(std::move(patch));
+  return rulePatches;
+}
+
+/// @brief Build the layout and rule specifications of the example application for a version
+/// @param version the application version
+/// @return the specifications for the version
+datalint::CompiledSpecification BuildSpecifications(const datalint::Version& version) {
+  datalint::layout::LayoutSpecificationBuilder layoutSpecificationBuilder;
+  datalint::rules::RuleSpecificationBuilder ruleSpecBuilder;
+  return datalint::CompiledSpecification{
+      layoutSpecificationBuilder.Build(version, MakeLayoutPatches()),
+      ruleSpecBuilder.Build(version, MakeRulePatches())};
+}
+
+/// @brief Compile the specifications of every version of the example application to a bundle
+/// @param bundlePath the bundle file to write
+/// @return the process exit code
+int CompileSpecifications(const std::filesystem::path& bundlePath) {
+  try {
+    const datalint::VersionedSpecifications specifications(MakeLayoutPatches(),
+                                                           MakeRulePatches());
+    datalint::SpecificationBundle::Write(specifications, bundlePath);
+  } catch (const std::exception& e) {
+    std::cerr << "Failed to compile specifications: " << e.what() << '\n';
+    return 1;
+  }
+  std::cout << "Specifications compiled to " << bundlePath.string() << '\n';
+  return 0;
+}
+}  // namespace
 
 int main(int argc, char** argv) {
   // 1. Parse the command line arguments for the input file path
   if (argc < 2) {
-    std::cerr << "Usage: datalinttool <input_file_path>\n";
+    std::cerr << "Usage: datalinttool <input_file_path> [spec_bundle_path]\n"
+                 "       datalinttool --compile-specs <spec_bundle_path>\n";
     return 1;
   }
-  datalint::error::ErrorCollector errorCollector;
+  if (std::string_view(argv[1]) == "--compile-specs") {
+    if (argc < 3) {
+      std::cerr << "Usage: datalinttool --compile-specs <spec_bundle_path>\n";
+      return 1;
+    }
+    return CompileSpecifications(argv[2]);
+  }
+  // All per-file data (raw data, parsed data, error logs) is allocated from a single arena, which
+  // is released in one go rather than field by field. When processing several files, keep these
+  // objects in a per-file scope: once a file's errors are processed, destroy its RawData,
+  // ParsedData and ErrorCollector, and only then call arena.release() and reuse the arena for the
+  // next file. Releasing while any of them is alive leaves it pointing at freed memory.
+  std::pmr::monotonic_buffer_resource arena;
+  datalint::error::ErrorCollector errorCollector{&arena};
   datalint::error_processor::FileOutputErrorProcessor errorProcessor{
       std::filesystem::path{"output.txt"}};
   auto printErrors = [&errorCollector, &errorProcessor]() {
@@ -49,12 +141,35 @@ int main(int argc, char** argv) {
   // it's assumed that in the consuming project, we know the file type
   // and can select the appropriate parser
 
-  // 1. Parse the input file to raw data
-  auto parser = std::make_unique<datalint::input::CsvFileParser>();
+  // 1. With a compiled bundle, map it; its specifications are then ready in microseconds.
+  // Otherwise resolve the application descriptor from the start of the file, then build the
+  // layout and rule specifications for that version on another thread while the whole file is
+  // parsed
+  std::optional<datalint::SpecificationBundle> bundle;
+  if (argc > 2) {
+    try {
+      bundle = datalint::SpecificationBundle::Load(argv[2]);
+    } catch (const std::runtime_error& e) {
+      std::cerr << "Failed to load specification bundle: " << e.what() << '\n';
+      return 1;
+    }
+  }
+  datalint::DefaultCsvApplicationDescriptorResolver resolver;
+  datalint::ResolveResult sniffed;
+  std::future<datalint::CompiledSpecification> prefetchedSpecs;
+  if (!bundle) {
+    sniffed = resolver.ResolveFromPrefix(inputPath);
+    if (sniffed.Success()) {
+      prefetchedSpecs =
+          std::async(std::launch::async, BuildSpecifications, sniffed.Descriptor->Version());
+    }
+  }
+
+  // 2. Parse the input file to raw data
+  auto parser = std::make_unique<datalint::input::CsvFileParser>(&arena);
   const auto rawData = parser->Parse(inputPath);
 
-  datalint::DefaultCsvApplicationDescriptorResolver resolver;
-  // 2. Resolve the application descriptor from the raw data
+  // 3. Resolve the application descriptor from the complete raw data
   const auto result = resolver.Resolve(rawData);
 
   if (!result.Success()) {
@@ -67,32 +182,27 @@ int main(int argc, char** argv) {
     return 1;
   }
 
-  using namespace datalint::layout;
-
-  // 3. Build expected layout patches
-
-  const LayoutPatch layoutPatch1("patch1", datalint::VersionRange::All(),
-                                 std::vector<LayoutPatchOperation>{
-                                     AddField{"key1", ExpectedField{1, std::nullopt}},
-                                     AddField{"key2", ExpectedField{1, std::nullopt}},
-                                     AddField{"key10", ExpectedField{1, std::nullopt}},
-                                     AddField{"ApplicationName", ExpectedField{1, std::nullopt}},
-                                     AddField{"ApplicationVersion", ExpectedField{1, std::nullopt}},
-                                 });
-
-  std::vector<LayoutPatch> layoutPatches = {layoutPatch1};
-  LayoutSpecificationBuilder layoutSpecificationBuilder;
+  // 4. Use the bundled or prefetched specifications, unless the prefix resolved to another
+  // descriptor
   const auto descriptor = result.Descriptor.value();
-  // 4. Build layout specification for the resolved application descriptor version
-  LayoutSpecification layoutSpec =
-      layoutSpecificationBuilder.Build(descriptor.Version(), layoutPatches);
-  layoutSpec.AddOrderingConstraint(FieldOrderingConstraint{
-      "ApplicationName",
-      "ApplicationVersion"});  // ApplicationName must come before ApplicationVersion
+  auto [layoutSpec, ruleSpec] = [&]() -> datalint::CompiledSpecification {
+    if (bundle) {
+      return bundle->Find(descriptor.Version());
+    }
+    if (prefetchedSpecs.valid() && sniffed.Descriptor == descriptor) {
+      return prefetchedSpecs.get();
+    }
+    return BuildSpecifications(descriptor.Version());
+  }();
 
-  // 5. Validate the layout specification against the raw data
-  LayoutSpecificationValidator layoutSpecValidator{UnexpectedFieldStrictness::Permissive};
-  const bool isValid = layoutSpecValidator.Validate(layoutSpec, rawData, errorCollector);
+  using namespace datalint::layout;
+  using namespace datalint::rules;
+
+  // 5. Validate the raw data against the compiled layout
+  const CompiledLayout compiledLayout(layoutSpec);
+  CompiledLayout::Workspace workspace;
+  const bool isValid = compiledLayout.Validate(rawData, UnexpectedFieldStrictness::Permissive,
+                                               workspace, errorCollector);
 
   if (!isValid) {
     std::cerr << "Validation failed:\n";
@@ -100,31 +210,12 @@ int main(int argc, char** argv) {
     return 1;
   }
 
-  // 6. Build the rule specification
-  using namespace datalint::rules;
-
-  FieldRule key10Rule{"key10", std::make_unique<IntegerInRangeRule>(0, 10),
-                      std::make_unique<ValueAtIndexSelector>(0)};
-
-  auto addKey1Operation = std::make_unique<AddFieldRulePatchOperation>(std::move(key10Rule));
-
-  std::vector<std::unique_ptr<IRulePatchOperation>> ops;
-  ops.push_back(std::move(addKey1Operation));
-
-  RulePatch patch("example-rule-patch", datalint::VersionRange::All(), std::move(ops));
-
-  std::vector<RulePatch> rulePatches;
-  rulePatches.push_back(std::move(patch));
-
-  RuleSpecificationBuilder ruleSpecBuilder;
-  RuleSpecification ruleSpec = ruleSpecBuilder.Build(descriptor.Version(), rulePatches);
-
   using namespace datalint::fieldparser;
-  // 7. Parse the raw data
+  // 6. Parse the raw data
   std::unique_ptr<CsvFieldParser> csvFieldParser = std::make_unique<CsvFieldParser>();
   ParsedDataBuilder parsedDataBuilder(std::move(csvFieldParser));
   const ParsedData parsedData = parsedDataBuilder.Build(rawData);
-  // 8. Validate the built rule specification
+  // 7. Validate the built rule specification
   RuleValidator ruleValidator;
   if (!ruleValidator.Validate(ruleSpec, parsedData, errorCollector)) {
     // output errors to file
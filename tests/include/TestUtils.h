@@ -1,7 +1,14 @@
 #pragma once
 
+#include <datalint/FieldParser/ParsedField.h>
+#include <datalint/FieldParser/RawValue.h>
+
 #include <atomic>
+#include <cstddef>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace datalint::test {
 
@@ -13,4 +20,28 @@ inline std::string MakeTempCsvFilename(std::string_view testName) {
   return std::string(testName) + "_" + std::to_string(counter++) + ".csv";
 }
 
+/// @brief Builds a field with the values "0" to "count - 1".
+/// @param count The number of values of the field.
+/// @return A field keyed "TestKey" whose i-th value is on line i + 1.
+inline fieldparser::ParsedField MakeField(std::size_t count) {
+  fieldparser::ParsedField field;
+  field.Key = "TestKey";
+  for (std::size_t i = 0; i < count; ++i) {
+    field.Values.push_back(fieldparser::RawValue{
+        std::pmr::string(std::to_string(i)), {"file.txt", static_cast<int>(i + 1)}});
+  }
+  return field;
+}
+
+/// @brief Returns the text of selected values.
+/// @param values The values returned by a selector.
+/// @return The text of each value, in order.
+inline std::vector<std::string> Texts(const std::vector<const fieldparser::RawValue*>& values) {
+  std::vector<std::string> texts;
+  for (const auto* value : values) {
+    texts.emplace_back(value->Value);
+  }
+  return texts;
+}
+
 }  // namespace datalint::test
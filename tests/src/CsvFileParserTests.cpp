@@ -25,19 +25,19 @@ TEST(CsvFileParserTest, CanInitializeWithFields) {
   // Order of occurrence and key to value relationship should both be preserved
   EXPECT_EQ(fields[0].Key, "key1");
   EXPECT_EQ(fields[0].Value, "value1,Simple two-column row");
-  EXPECT_EQ(fields[0].Location.Filename, tempCsvFile);
+  EXPECT_EQ(std::string_view(fields[0].Location.Filename), tempCsvFile);
   EXPECT_EQ(fields[0].Location.Line, 1);
   EXPECT_EQ(fields[1].Key, "key2");
   EXPECT_EQ(fields[1].Value, "value2,Leading and trailing spaces (unquoted)");
-  EXPECT_EQ(fields[1].Location.Filename, tempCsvFile);
+  EXPECT_EQ(std::string_view(fields[1].Location.Filename), tempCsvFile);
   EXPECT_EQ(fields[1].Location.Line, 2);
   EXPECT_EQ(fields[2].Key, "\"k,ey3\"");
   EXPECT_EQ(fields[2].Value, "\"val,ue3\",\"Embedded commas inside quoted fields\"");
-  EXPECT_EQ(fields[2].Location.Filename, tempCsvFile);
+  EXPECT_EQ(std::string_view(fields[2].Location.Filename), tempCsvFile);
   EXPECT_EQ(fields[2].Location.Line, 3);
   EXPECT_EQ(fields[3].Key, "\"key\"4\"");
   EXPECT_EQ(fields[3].Value, "\"value\"4\",\"Embedded double quotes (escaped by doubling)\"");
-  EXPECT_EQ(fields[3].Location.Filename, tempCsvFile);
+  EXPECT_EQ(std::string_view(fields[3].Location.Filename), tempCsvFile);
   EXPECT_EQ(fields[3].Location.Line, 4);
 
   int result = std::remove(tempCsvFile.c_str());
@@ -146,3 +146,64 @@ TEST(CsvFileParserTest, HandlesEmptyValuesBetweenCommas) {
   int result = std::remove(tempCsvFile.c_str());
   ASSERT_EQ(result, 0);  // optional check that deletion of temporary file succeeded
 }
+
+/// @brief Tests that parsing a prefix keeps only the lines completely within the byte limit.
+TEST(CsvFileParserTest, ParsePrefixDropsLineCutOffByByteLimit) {
+  const std::string tempCsvFile =
+      datalint::test::MakeTempCsvFilename("ParsePrefixDropsLineCutOffByByteLimit");
+  {
+    std::ofstream outFile(tempCsvFile);
+    outFile << "key1,value1\n";  // 12 bytes
+    outFile << "key2,value2\n";  // 24 bytes
+    outFile << "key3,value3\n";  // 36 bytes
+  }
+  datalint::input::CsvFileParser parser;
+
+  const datalint::RawData prefix = parser.ParsePrefix(tempCsvFile, 30);
+  ASSERT_EQ(prefix.Fields().size(), 2);
+  EXPECT_EQ(prefix.Fields()[0].Key, "key1");
+  EXPECT_EQ(prefix.Fields()[1].Key, "key2");
+  EXPECT_EQ(prefix.Fields()[1].Value, "value2");
+  EXPECT_EQ(prefix.Fields()[1].Location.Line, 2);
+
+  // A limit beyond the end of the file returns the whole file, including an unterminated last line
+  {
+    std::ofstream outFile(tempCsvFile, std::ios::app);
+    outFile << "key4,value4";
+  }
+  const datalint::RawData whole = parser.ParsePrefix(tempCsvFile, 1024);
+  ASSERT_EQ(whole.Fields().size(), 4);
+  EXPECT_EQ(whole.Fields()[3].Value, "value4");
+
+  int removeResult = std::remove(tempCsvFile.c_str());
+  ASSERT_EQ(removeResult, 0);
+}
+
+/// @brief Tests that scanning the keys of a file visits the same keys as parsing it, in order
+TEST(CsvFileParserTest, ScanKeysVisitsKeysOfEachRow) {
+  const std::string tempCsvFile =
+      datalint::test::MakeTempCsvFilename("ScanKeysVisitsKeysOfEachRow");
+  {
+    std::ofstream outFile(tempCsvFile);
+    outFile << "key1,value1,more\n";
+    outFile << "\n";
+    outFile << " key2 ,value2\n";
+    outFile << "key1\n";
+  }
+  datalint::input::CsvFileParser parser;
+
+  std::vector<std::string> keys;
+  const std::size_t keyCount =
+      parser.ScanKeys(tempCsvFile, [&keys](std::string_view key) { keys.emplace_back(key); });
+
+  const datalint::RawData rawData = parser.Parse(tempCsvFile);
+  ASSERT_EQ(keyCount, rawData.Fields().size());
+  ASSERT_EQ(keys.size(), keyCount);
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(rawData.Fields()[i].Key, keys[i]);
+  }
+  EXPECT_THROW(parser.ScanKeys("does_not_exist.csv", [](std::string_view) {}), std::runtime_error);
+
+  int removeResult = std::remove(tempCsvFile.c_str());
+  ASSERT_EQ(removeResult, 0);
+}
@@ -142,3 +142,54 @@ TEST(DefaultCsvApplicationDescriptorResolverTest, ReturnsValidDescriptorWhenData
   int removeResult = std::remove(tempCsvFile.c_str());
   ASSERT_EQ(removeResult, 0);  // optional check that deletion of temporary file succeeded
 }
+
+/// @brief Tests that the descriptor is resolved from the start of a file whose descriptor fields
+/// precede a large body.
+TEST(DefaultCsvApplicationDescriptorResolverTest, ResolvesFromFilePrefix) {
+  const std::string tempCsvFile = datalint::test::MakeTempCsvFilename("ResolvesFromFilePrefix");
+  {
+    std::ofstream outFile(tempCsvFile);
+    outFile << "ApplicationName,Example Application\n";
+    outFile << "ApplicationVersion,1.2.3\n";
+    for (int i = 0; i < 10000; ++i) {
+      outFile << "key" << i << ",value" << i << "\n";
+    }
+  }
+  auto resolver = datalint::DefaultCsvApplicationDescriptorResolver();
+  const auto result = resolver.ResolveFromPrefix(tempCsvFile);
+
+  ASSERT_TRUE(result.Success());
+  EXPECT_EQ(result.Descriptor->Name(), "Example Application");
+  EXPECT_EQ(result.Descriptor->Version(), datalint::Version(1, 2, 3));
+
+  int removeResult = std::remove(tempCsvFile.c_str());
+  ASSERT_EQ(removeResult, 0);
+}
+
+/// @brief Tests that a descriptor field beyond the byte limit is reported as missing.
+TEST(DefaultCsvApplicationDescriptorResolverTest, ResolveFromPrefixReportsFieldBeyondByteLimit) {
+  const std::string tempCsvFile =
+      datalint::test::MakeTempCsvFilename("ResolveFromPrefixReportsFieldBeyondByteLimit");
+  {
+    std::ofstream outFile(tempCsvFile);
+    outFile << "ApplicationName,Example Application\n";
+    for (int i = 0; i < 100; ++i) {
+      outFile << "key" << i << ",value" << i << "\n";
+    }
+    outFile << "ApplicationVersion,1.2.3\n";
+  }
+  auto resolver = datalint::DefaultCsvApplicationDescriptorResolver();
+
+  const auto limited = resolver.ResolveFromPrefix(tempCsvFile, 256);
+  ASSERT_FALSE(limited.Success());
+  ASSERT_EQ(limited.Errors.size(), 1);
+  EXPECT_EQ(limited.Errors[0].Code, datalint::ResolveErrorCode::MissingRequiredField);
+  EXPECT_EQ(limited.Errors[0].Field, "ApplicationVersion");
+
+  const auto unlimited = resolver.ResolveFromPrefix(tempCsvFile);
+  ASSERT_TRUE(unlimited.Success());
+  EXPECT_EQ(unlimited.Descriptor->Version(), datalint::Version(1, 2, 3));
+
+  int removeResult = std::remove(tempCsvFile.c_str());
+  ASSERT_EQ(removeResult, 0);
+}
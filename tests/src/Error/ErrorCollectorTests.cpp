@@ -2,6 +2,8 @@
 #include <datalint/Error/ErrorLog.h>
 #include <gtest/gtest.h>
 
+#include <memory_resource>
+
 /// @brief Tests that the error collector initializes with zero errors.
 TEST(ErrorCollectorTest, CanInitializeWithZeroErrors) {
   // Create an error collector
@@ -61,3 +63,15 @@ TEST(ErrorCollectorTest, ErrorCountWorksCorrectly) {
   // Now, there should be errors
   EXPECT_EQ(errorCollector.ErrorCount(), 2);
 }
+
+/// @brief Tests that the error collector collects its error logs into the given memory resource.
+TEST(ErrorCollectorTest, CollectsIntoMemoryResource) {
+  std::pmr::monotonic_buffer_resource arena;
+  // Create an error collector backed by the arena
+  datalint::error::ErrorCollector errorCollector{&arena};
+  errorCollector.AddErrorLog(datalint::error::ErrorLog("Error Subject", "Error body."));
+  // The collected logs live in the arena
+  EXPECT_EQ(errorCollector.GetErrorLogs().get_allocator().resource(), &arena);
+  ASSERT_EQ(errorCollector.ErrorCount(), 1);
+  EXPECT_EQ(errorCollector.GetErrorLogs()[0].Subject(), "Error Subject");
+}
@@ -4,6 +4,9 @@
 #include <datalint/RawField.h>
 #include <gtest/gtest.h>
 
+#include <memory_resource>
+#include <vector>
+
 /// @brief Test that we're able to build a ParsedData from RawData
 TEST(ParserDataBuilderTest, CanBuildParsedDataFromRawData) {
   datalint::RawField rawField;
@@ -26,3 +29,22 @@ TEST(ParserDataBuilderTest, CanBuildParsedDataFromRawData) {
   EXPECT_EQ(parsedField.Values[1].Value, "Value2");
   EXPECT_EQ(parsedField.Values[2].Value, "Value3");
 }
+
+/// @brief Test that the built ParsedData is allocated from the same memory resource as the RawData
+TEST(ParserDataBuilderTest, BuildsParsedDataInRawDataMemoryResource) {
+  std::pmr::monotonic_buffer_resource arena;
+  const std::vector<datalint::RawField> rawFields{{"TestKey", "Value1,Value2"}};
+  datalint::RawData rawData(rawFields, &arena);
+
+  datalint::fieldparser::ParsedDataBuilder builder(
+      std::make_unique<datalint::fieldparser::CsvFieldParser>());
+
+  datalint::fieldparser::ParsedData parsedData = builder.Build(rawData);
+
+  EXPECT_EQ(parsedData.Resource(), &arena);
+  ASSERT_EQ(parsedData.Fields().size(), 1);
+  const datalint::fieldparser::ParsedField& parsedField = parsedData.Fields()[0];
+  ASSERT_EQ(parsedField.Values.size(), 2);
+  EXPECT_EQ(parsedField.Values[1].Value, "Value2");
+  EXPECT_EQ(parsedField.Values[1].Value.get_allocator().resource(), &arena);
+}
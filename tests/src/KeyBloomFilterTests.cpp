@@ -0,0 +1,41 @@
+#include <datalint/KeyBloomFilter.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+/// @brief Tests that an empty filter rejects every key
+TEST(KeyBloomFilterTest, EmptyFilterRejectsKeys) {
+  const datalint::KeyBloomFilter filter(0);
+
+  EXPECT_EQ(filter.BlockCount(), 1);
+  EXPECT_FALSE(filter.MayContain("key1"));
+  EXPECT_FALSE(filter.MayContain(""));
+}
+
+/// @brief Tests that every inserted key is reported as possibly present
+TEST(KeyBloomFilterTest, HasNoFalseNegatives) {
+  datalint::KeyBloomFilter filter(10000);
+  for (int i = 0; i < 10000; ++i) {
+    filter.Insert("sensor." + std::to_string(i) + ".temp");
+  }
+
+  for (int i = 0; i < 10000; ++i) {
+    EXPECT_TRUE(filter.MayContain("sensor." + std::to_string(i) + ".temp"));
+  }
+}
+
+/// @brief Tests that most keys that were never inserted are rejected
+TEST(KeyBloomFilterTest, RejectsMostAbsentKeys) {
+  datalint::KeyBloomFilter filter(10000);
+  for (int i = 0; i < 10000; ++i) {
+    filter.Insert("sensor." + std::to_string(i) + ".temp");
+  }
+
+  int falsePositives = 0;
+  for (int i = 0; i < 10000; ++i) {
+    if (filter.MayContain("sensor." + std::to_string(i) + ".humidity")) {
+      ++falsePositives;
+    }
+  }
+  EXPECT_LT(falsePositives, 100);
+}
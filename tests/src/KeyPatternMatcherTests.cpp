@@ -0,0 +1,64 @@
+#include <datalint/KeyPatternMatcher.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace {
+/// @brief The positions of the patterns matching a key
+std::vector<std::uint32_t> Matches(const datalint::KeyPatternMatcher& matcher,
+                                   std::string_view key) {
+  const auto matches = matcher.Match(key);
+  return std::vector<std::uint32_t>(matches.begin(), matches.end());
+}
+}  // namespace
+
+/// @brief Tests that wildcards, classes, repetitions and escapes match whole keys only
+TEST(KeyPatternMatcherTest, MatchesWholeKeys) {
+  const std::vector<std::string_view> patterns{"sensor_*", "channel_[0-9]+", "x?z",
+                                               "id_[!0-9]", "a\\*b"};
+  const datalint::KeyPatternMatcher matcher(patterns);
+
+  ASSERT_EQ(matcher.Size(), 5);
+  EXPECT_EQ(Matches(matcher, "sensor_"), std::vector<std::uint32_t>{0});
+  EXPECT_EQ(Matches(matcher, "sensor_temperature"), std::vector<std::uint32_t>{0});
+  EXPECT_TRUE(Matches(matcher, "sensor").empty());
+  EXPECT_EQ(Matches(matcher, "channel_7"), std::vector<std::uint32_t>{1});
+  EXPECT_EQ(Matches(matcher, "channel_042"), std::vector<std::uint32_t>{1});
+  EXPECT_TRUE(Matches(matcher, "channel_").empty());
+  EXPECT_TRUE(Matches(matcher, "channel_4a").empty());
+  EXPECT_EQ(Matches(matcher, "xyz"), std::vector<std::uint32_t>{2});
+  EXPECT_TRUE(Matches(matcher, "xz").empty());
+  EXPECT_EQ(Matches(matcher, "id_a"), std::vector<std::uint32_t>{3});
+  EXPECT_TRUE(Matches(matcher, "id_1").empty());
+  EXPECT_EQ(Matches(matcher, "a*b"), std::vector<std::uint32_t>{4});
+  EXPECT_TRUE(Matches(matcher, "axb").empty());
+}
+
+/// @brief Tests that a key matching several patterns gets all of them, in increasing order
+TEST(KeyPatternMatcherTest, ReturnsEveryMatchingPattern) {
+  const std::vector<std::string_view> patterns{"*_max", "sensor_*", "*", "sensor_[a-z]+_max"};
+  const datalint::KeyPatternMatcher matcher(patterns);
+
+  EXPECT_EQ(Matches(matcher, "sensor_speed_max"), (std::vector<std::uint32_t>{0, 1, 2, 3}));
+  EXPECT_EQ(Matches(matcher, "sensor_1_max"), (std::vector<std::uint32_t>{0, 1, 2}));
+  EXPECT_EQ(Matches(matcher, "other"), std::vector<std::uint32_t>{2});
+  EXPECT_EQ(Matches(matcher, ""), std::vector<std::uint32_t>{2});
+}
+
+/// @brief Tests that malformed patterns are rejected and the empty matcher matches nothing
+TEST(KeyPatternMatcherTest, RejectsMalformedPatterns) {
+  for (const std::string_view pattern : {"+a", "a*+", "a\\", "[abc", "[z-a]"}) {
+    EXPECT_THROW(datalint::KeyPatternMatcher::CheckSyntax(pattern), std::invalid_argument)
+        << pattern;
+    const std::vector<std::string_view> patterns{pattern};
+    EXPECT_THROW(datalint::KeyPatternMatcher{patterns}, std::invalid_argument) << pattern;
+  }
+  EXPECT_NO_THROW(datalint::KeyPatternMatcher::CheckSyntax("[]a]+"));
+
+  const datalint::KeyPatternMatcher empty;
+  EXPECT_EQ(empty.Size(), 0);
+  EXPECT_TRUE(empty.Match("anything").empty());
+}
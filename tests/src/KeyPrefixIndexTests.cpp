@@ -0,0 +1,82 @@
+#include <datalint/KeyPrefixIndex.h>
+#include <datalint/RawData.h>
+#include <datalint/RawField.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+/// @brief Raw data with dotted, hierarchical keys
+datalint::RawData MakeSensorData() {
+  return datalint::RawData(std::vector<datalint::RawField>{
+      {"sensor.1.temp", "20"},
+      {"sensor.1.humidity", "40"},
+      {"sensor.2.temp", "21"},
+      {"sensor.1.temp", "22"},
+      {"sensorCount", "2"},
+      {"station", "north"},
+  });
+}
+}  // namespace
+
+/// @brief Tests that prefix existence matches the keys present
+TEST(KeyPrefixIndexTest, FindsExistingPrefixes) {
+  const auto rawData = MakeSensorData();
+  const datalint::KeyPrefixIndex index(rawData.Columns());
+
+  EXPECT_TRUE(index.HasPrefix("sensor."));
+  EXPECT_TRUE(index.HasPrefix("sensor.1.temp"));
+  EXPECT_TRUE(index.HasPrefix("st"));
+  EXPECT_TRUE(index.HasPrefix(""));
+  EXPECT_FALSE(index.HasPrefix("sensor.3."));
+  EXPECT_FALSE(index.HasPrefix("sensor.1.temperature"));
+  EXPECT_FALSE(index.HasPrefix("z"));
+}
+
+/// @brief Tests that distinct keys and field occurrences are counted per prefix
+TEST(KeyPrefixIndexTest, CountsKeysAndFieldsUnderPrefix) {
+  const auto rawData = MakeSensorData();
+  const datalint::KeyPrefixIndex index(rawData.Columns());
+
+  EXPECT_EQ(index.CountKeys("sensor."), 3);
+  EXPECT_EQ(index.CountFields("sensor."), 4);
+  EXPECT_EQ(index.CountKeys("sensor.1."), 2);
+  EXPECT_EQ(index.CountFields("sensor.1."), 3);
+  EXPECT_EQ(index.CountKeys("sensor"), 4);
+  EXPECT_EQ(index.CountFields(""), 6);
+  EXPECT_EQ(index.CountFields("missing"), 0);
+}
+
+/// @brief Tests that the keys under a prefix are enumerated in sorted order
+TEST(KeyPrefixIndexTest, EnumeratesKeysUnderPrefix) {
+  const auto rawData = MakeSensorData();
+  const datalint::KeyPrefixIndex index(rawData.Columns());
+  const auto& keys = rawData.Columns().Keys();
+
+  std::vector<std::string> matches;
+  for (const auto id : index.KeysWithPrefix("sensor.")) {
+    matches.emplace_back(keys.Key(id));
+  }
+
+  EXPECT_EQ(matches,
+            (std::vector<std::string>{"sensor.1.humidity", "sensor.1.temp", "sensor.2.temp"}));
+  EXPECT_TRUE(index.KeysWithPrefix("sensor.9").empty());
+}
+
+/// @brief Tests that the index keeps answering queries after the raw data is moved and destroyed
+TEST(KeyPrefixIndexTest, OutlivesMovedRawData) {
+  auto rawData = MakeSensorData();
+  const datalint::KeyPrefixIndex index(rawData.Columns());
+  const std::string firstKey(rawData.Columns().Keys().Key(index.KeysWithPrefix("sensor.")[0]));
+  {
+    const auto moved = std::move(rawData);
+    EXPECT_EQ(moved.Columns().Keys().Key(index.KeysWithPrefix("sensor.")[0]), firstKey);
+  }
+
+  EXPECT_TRUE(index.HasPrefix("sensor.1."));
+  EXPECT_EQ(index.CountKeys("sensor."), 3);
+  EXPECT_EQ(index.CountFields("sensor.1."), 3);
+  EXPECT_FALSE(index.HasPrefix("sensor.3."));
+}
@@ -0,0 +1,43 @@
+#include <datalint/KeyTable.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+/// @brief Tests that keys are assigned dense ids in order of first appearance
+TEST(KeyTableTest, AssignsDenseIdsInOrderOfAppearance) {
+  datalint::KeyTable table;
+
+  EXPECT_EQ(table.Intern("key1"), 0);
+  EXPECT_EQ(table.Intern("key2"), 1);
+  EXPECT_EQ(table.Intern("key1"), 0);
+  EXPECT_EQ(table.Intern("key3"), 2);
+
+  ASSERT_EQ(table.Size(), 3);
+  EXPECT_EQ(table.Key(0), "key1");
+  EXPECT_EQ(table.Key(1), "key2");
+  EXPECT_EQ(table.Key(2), "key3");
+}
+
+/// @brief Tests that finding a key returns its id, or nothing for a key never interned
+TEST(KeyTableTest, FindsInternedKeys) {
+  datalint::KeyTable table;
+  table.Intern("key1");
+  table.Intern("key2");
+
+  EXPECT_EQ(table.Find("key2"), 1);
+  EXPECT_FALSE(table.Find("key3").has_value());
+  EXPECT_FALSE(table.Find("").has_value());
+}
+
+/// @brief Tests that the table keeps all keys reachable as it grows
+TEST(KeyTableTest, KeepsKeysReachableWhenGrowing) {
+  datalint::KeyTable table;
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(table.Intern("key" + std::to_string(i)), static_cast<datalint::KeyId>(i));
+  }
+
+  ASSERT_EQ(table.Size(), 1000);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(table.Find("key" + std::to_string(i)), static_cast<datalint::KeyId>(i));
+  }
+}
@@ -0,0 +1,244 @@
+#include <datalint/Error/ErrorCollector.h>
+#include <datalint/LayoutSpecification/CompiledLayout.h>
+#include <datalint/LayoutSpecification/ExpectedField.h>
+#include <datalint/LayoutSpecification/FieldOrderingConstraint.h>
+#include <datalint/LayoutSpecification/LayoutSpecification.h>
+#include <datalint/LayoutSpecification/LayoutSpecificationValidator.h>
+#include <datalint/LayoutSpecification/UnexpectedFieldStrictness.h>
+#include <datalint/RawData.h>
+#include <datalint/RawField.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace datalint;
+using namespace datalint::layout;
+
+namespace {
+/// @brief Helper building a specification with counts, an ordering and a constraint-only key
+LayoutSpecification MakeSpecification() {
+  LayoutSpecification specification;
+  specification.AddExpectedField("Before", ExpectedField{1, 1});
+  specification.AddExpectedField("After", ExpectedField{1, std::nullopt});
+  specification.AddExpectedField("Missing", ExpectedField{1});
+  specification.AddOrderingConstraint(FieldOrderingConstraint{"Before", "After"});
+  specification.AddOrderingConstraint(FieldOrderingConstraint{"After", "Trailer"});
+  return specification;
+}
+}  // namespace
+
+/// @brief Tests that fields get dense ids in key order, followed by constraint-only keys
+TEST(CompiledLayoutTest, AssignsDenseIds) {
+  const CompiledLayout layout(MakeSpecification());
+
+  ASSERT_EQ(layout.FieldCount(), 3);
+  ASSERT_EQ(layout.KeyCount(), 4);
+  EXPECT_EQ(layout.Key(0), "After");
+  EXPECT_EQ(layout.Key(1), "Before");
+  EXPECT_EQ(layout.Key(2), "Missing");
+  EXPECT_EQ(layout.Key(3), "Trailer");
+  for (CompiledLayout::Id id = 0; id < layout.KeyCount(); ++id) {
+    EXPECT_EQ(layout.FindKey(layout.Key(id)), id);
+  }
+  EXPECT_FALSE(layout.FindKey("Unknown").has_value());
+  EXPECT_EQ(layout.MinCount(1), 1);
+  EXPECT_EQ(layout.MaxCount(1), 1);
+  EXPECT_EQ(layout.MaxCount(0), CompiledLayout::kUnlimited);
+
+  ASSERT_EQ(layout.OrderingConstraints().size(), 2);
+  EXPECT_EQ(layout.OrderingConstraints()[0].Before, 1);
+  EXPECT_EQ(layout.OrderingConstraints()[0].After, 0);
+  EXPECT_EQ(layout.OrderingConstraints()[1].After, 3);
+
+  EXPECT_FALSE(CompiledLayout(LayoutSpecification()).FindKey("After").has_value());
+}
+
+/// @brief Tests that validation reports the same errors as LayoutSpecificationValidator, in both
+/// strictness modes, with one workspace reused across validations
+TEST(CompiledLayoutTest, MatchesLayoutSpecificationValidator) {
+  const LayoutSpecification specification = MakeSpecification();
+  const CompiledLayout layout(specification);
+  CompiledLayout::Workspace workspace;
+
+  const std::vector<std::vector<RawField>> inputs{
+      {RawField{"Before", "1"}, RawField{"After", "1"}, RawField{"Missing", "1"}},
+      {RawField{"Extra1", "x"}, RawField{"After", "1"}, RawField{"Trailer", "x"},
+       RawField{"Before", "1"}, RawField{"Before", "2"}, RawField{"Extra1", "y"}},
+      {RawField{"Trailer", "x"}, RawField{"After", "1"}},
+      {},
+  };
+  for (const auto strictness :
+       {UnexpectedFieldStrictness::Strict, UnexpectedFieldStrictness::Permissive}) {
+    for (const auto& fields : inputs) {
+      const RawData rawData(fields);
+      error::ErrorCollector expected;
+      error::ErrorCollector actual;
+      const bool expectedValid =
+          LayoutSpecificationValidator(strictness).Validate(specification, rawData, expected);
+
+      EXPECT_EQ(layout.Validate(rawData, strictness, workspace, actual), expectedValid);
+      const auto expectedLogs = expected.GetErrorLogs();
+      const auto actualLogs = actual.GetErrorLogs();
+      ASSERT_EQ(actualLogs.size(), expectedLogs.size());
+      for (std::size_t i = 0; i < actualLogs.size(); ++i) {
+        EXPECT_EQ(actualLogs[i].Subject(), expectedLogs[i].Subject());
+        EXPECT_EQ(actualLogs[i].Body(), expectedLogs[i].Body());
+      }
+    }
+  }
+}
+
+/// @brief Tests that ordering constraints implied by others are reported like the validator does,
+/// including when the key implying them is absent
+TEST(CompiledLayoutTest, ChecksImpliedOrderingConstraints) {
+  LayoutSpecification specification;
+  specification.AddOrderingConstraint(FieldOrderingConstraint{"A", "B"});
+  specification.AddOrderingConstraint(FieldOrderingConstraint{"B", "C"});
+  specification.AddOrderingConstraint(FieldOrderingConstraint{"A", "C"});
+  specification.AddOrderingConstraint(FieldOrderingConstraint{"X", "B"});
+  const CompiledLayout layout(specification);
+  CompiledLayout::Workspace workspace;
+
+  EXPECT_EQ(layout.Ordering().EdgeCount(), 3);
+
+  const std::vector<std::vector<RawField>> inputs{
+      {RawField{"A", "1"}, RawField{"B", "1"}, RawField{"C", "1"}},
+      {RawField{"C", "1"}, RawField{"A", "1"}},
+      {RawField{"C", "1"}, RawField{"X", "1"}},
+      {RawField{"X", "1"}, RawField{"C", "1"}, RawField{"A", "1"}, RawField{"B", "1"}},
+  };
+  for (const auto& fields : inputs) {
+    const RawData rawData(fields);
+    error::ErrorCollector expected;
+    error::ErrorCollector actual;
+    const bool expectedValid =
+        LayoutSpecificationValidator(UnexpectedFieldStrictness::Permissive)
+            .Validate(specification, rawData, expected);
+
+    EXPECT_EQ(layout.Validate(rawData, UnexpectedFieldStrictness::Permissive, workspace, actual),
+              expectedValid);
+    const auto expectedLogs = expected.GetErrorLogs();
+    const auto actualLogs = actual.GetErrorLogs();
+    ASSERT_EQ(actualLogs.size(), expectedLogs.size());
+    for (std::size_t i = 0; i < actualLogs.size(); ++i) {
+      EXPECT_EQ(actualLogs[i].Body(), expectedLogs[i].Body());
+    }
+  }
+}
+
+/// @brief Tests that field patterns are validated like LayoutSpecificationValidator does,
+/// including keys both the layout and a pattern expect
+TEST(CompiledLayoutTest, MatchesValidatorWithFieldPatterns) {
+  LayoutSpecification specification = MakeSpecification();
+  specification.AddExpectedFieldPattern("sensor_*", ExpectedField{1, 2});
+  specification.AddExpectedFieldPattern("*er", ExpectedField{0, 1});
+  const CompiledLayout layout(specification);
+  CompiledLayout::Workspace workspace;
+
+  EXPECT_EQ(layout.PatternCount(), 2);
+  const std::vector<std::vector<RawField>> inputs{
+      {RawField{"Before", "1"}, RawField{"After", "1"}, RawField{"sensor_a", "1"}},
+      {RawField{"sensor_a", "x"}, RawField{"sensor_b", "1"}, RawField{"sensor_a", "1"},
+       RawField{"Trailer", "x"}, RawField{"Other", "1"}, RawField{"Missing", "1"}},
+      {RawField{"Extra", "x"}},
+  };
+  for (const auto strictness :
+       {UnexpectedFieldStrictness::Strict, UnexpectedFieldStrictness::Permissive}) {
+    for (const auto& fields : inputs) {
+      const RawData rawData(fields);
+      error::ErrorCollector expected;
+      error::ErrorCollector actual;
+      const bool expectedValid =
+          LayoutSpecificationValidator(strictness).Validate(specification, rawData, expected);
+
+      EXPECT_EQ(layout.Validate(rawData, strictness, workspace, actual), expectedValid);
+      const auto expectedLogs = expected.GetErrorLogs();
+      const auto actualLogs = actual.GetErrorLogs();
+      ASSERT_EQ(actualLogs.size(), expectedLogs.size());
+      for (std::size_t i = 0; i < actualLogs.size(); ++i) {
+        EXPECT_EQ(actualLogs[i].Subject(), expectedLogs[i].Subject());
+        EXPECT_EQ(actualLogs[i].Body(), expectedLogs[i].Body());
+      }
+    }
+  }
+}
+
+/// @brief Tests that scanning keys one at a time and reporting through the validator gives the
+/// same errors as validating raw data with these keys, with one workspace reused across scans
+TEST(CompiledLayoutTest, ScanMatchesValidate) {
+  LayoutSpecification specification = MakeSpecification();
+  specification.AddExpectedFieldPattern("sensor_*", ExpectedField{0, 1});
+  const CompiledLayout layout(specification);
+  CompiledLayout::Workspace workspace;
+  CompiledLayout::Workspace scan;
+
+  const std::vector<std::vector<RawField>> inputs{
+      {RawField{"Before", "1"}, RawField{"After", "1"}, RawField{"Missing", "1"}},
+      {RawField{"Extra1", "x"}, RawField{"After", "1"}, RawField{"Trailer", "x"},
+       RawField{"Before", "1"}, RawField{"sensor_a", "1"}, RawField{"Extra1", "y"},
+       RawField{"sensor_b", "1"}},
+      {},
+  };
+  for (const auto strictness :
+       {UnexpectedFieldStrictness::Strict, UnexpectedFieldStrictness::Permissive}) {
+    for (const auto& fields : inputs) {
+      const RawData rawData(fields);
+      error::ErrorCollector expected;
+      error::ErrorCollector actual;
+      const bool expectedValid = layout.Validate(rawData, strictness, workspace, expected);
+
+      layout.BeginScan(strictness, scan);
+      for (const auto& field : fields) {
+        layout.ScanKey(field.Key.View(), scan);
+      }
+      EXPECT_EQ(LayoutSpecificationValidator(strictness).Validate(layout, scan, actual),
+                expectedValid);
+      const auto expectedLogs = expected.GetErrorLogs();
+      const auto actualLogs = actual.GetErrorLogs();
+      ASSERT_EQ(actualLogs.size(), expectedLogs.size());
+      for (std::size_t i = 0; i < actualLogs.size(); ++i) {
+        EXPECT_EQ(actualLogs[i].Subject(), expectedLogs[i].Subject());
+        EXPECT_EQ(actualLogs[i].Body(), expectedLogs[i].Body());
+      }
+    }
+  }
+}
+
+/// @brief Tests that compiling ordering constraints that form a cycle throws
+TEST(CompiledLayoutTest, ThrowsOnOrderingCycle) {
+  LayoutSpecification specification;
+  specification.AddOrderingConstraint(FieldOrderingConstraint{"A", "B"});
+  specification.AddOrderingConstraint(FieldOrderingConstraint{"B", "A"});
+
+  EXPECT_EQ(specification.FindOrderingCycle().size(), 3);
+  EXPECT_THROW(CompiledLayout layout(specification), std::logic_error);
+}
+
+/// @brief Tests that a permissive scan keeps no unexpected key, however many it sees, while a
+/// strict scan keeps each distinct one, and that a permissive scan cannot be reported strictly
+TEST(CompiledLayoutTest, PermissiveScanKeepsNoUnexpectedKeys) {
+  const CompiledLayout layout(MakeSpecification());
+  CompiledLayout::Workspace scan;
+
+  layout.BeginScan(UnexpectedFieldStrictness::Permissive, scan);
+  for (int i = 0; i < 10000; ++i) {
+    layout.ScanKey("Unknown" + std::to_string(i), scan);
+  }
+  EXPECT_EQ(scan.UnexpectedKeyCount(), 0);
+  error::ErrorCollector permissive;
+  layout.ReportScan(UnexpectedFieldStrictness::Permissive, scan, permissive);
+  for (const auto& log : permissive.GetErrorLogs()) {
+    EXPECT_NE(log.Subject(), "Unexpected Field");
+  }
+  error::ErrorCollector strict;
+  EXPECT_THROW(layout.ReportScan(UnexpectedFieldStrictness::Strict, scan, strict),
+               std::invalid_argument);
+
+  layout.BeginScan(UnexpectedFieldStrictness::Strict, scan);
+  for (int i = 0; i < 10; ++i) {
+    layout.ScanKey("Unknown" + std::to_string(i % 3), scan);
+  }
+  EXPECT_EQ(scan.UnexpectedKeyCount(), 3);
+}
@@ -0,0 +1,130 @@
+#include <datalint/Error/ErrorCollector.h>
+#include <datalint/LayoutSpecification/LayoutAutomaton.h>
+#include <datalint/LayoutSpecification/LayoutGrammar.h>
+#include <datalint/RawData.h>
+#include <datalint/RawField.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace datalint;
+using namespace datalint::layout;
+
+namespace {
+/// @brief Helper validating the given keys against an automaton
+bool Fits(const LayoutAutomaton& automaton, const std::vector<std::string>& keys) {
+  std::vector<RawField> fields;
+  for (const auto& key : keys) {
+    fields.push_back(RawField{key, "x"});
+  }
+  const RawData rawData(fields);
+  LayoutAutomaton::Workspace workspace;
+  error::ErrorCollector errorCollector;
+  const bool valid = automaton.Validate(rawData, workspace, errorCollector);
+  EXPECT_EQ(errorCollector.ErrorCount(), valid ? 0 : 1);
+  return valid;
+}
+}  // namespace
+
+/// @brief Tests that a sequence requires its keys immediately after each other
+TEST(LayoutAutomatonTest, SequenceRequiresImmediateSuccession) {
+  const LayoutAutomaton automaton(
+      LayoutGrammar::Sequence({LayoutGrammar::Key("Header"), LayoutGrammar::Key("Version"),
+                               LayoutGrammar::Repeat(LayoutGrammar::AnyKey(), 0, std::nullopt)}));
+
+  EXPECT_TRUE(Fits(automaton, {"Header", "Version"}));
+  EXPECT_TRUE(Fits(automaton, {"Header", "Version", "Other", "Header"}));
+  EXPECT_FALSE(Fits(automaton, {"Header", "Other", "Version"}));
+  EXPECT_FALSE(Fits(automaton, {"Version", "Header"}));
+  EXPECT_FALSE(Fits(automaton, {"Header"}));
+  EXPECT_EQ(automaton.KeyCount(), 2);
+}
+
+/// @brief Tests that a block requires all occurrences of its key to be contiguous
+TEST(LayoutAutomatonTest, BlockRequiresContiguousOccurrences) {
+  const LayoutGrammar others = LayoutGrammar::Repeat(
+      LayoutGrammar::Choice({LayoutGrammar::Key("Name"), LayoutGrammar::Key("Date")}), 0,
+      std::nullopt);
+  const LayoutAutomaton automaton(
+      LayoutGrammar::Sequence({others, LayoutGrammar::Block("Point"), others}));
+
+  EXPECT_TRUE(Fits(automaton, {"Name", "Point", "Point", "Point", "Date"}));
+  EXPECT_TRUE(Fits(automaton, {"Point"}));
+  EXPECT_FALSE(Fits(automaton, {"Point", "Name", "Point"}));
+  EXPECT_FALSE(Fits(automaton, {"Name", "Date"}));
+}
+
+/// @brief Tests that a section accepts its keys in any order, and only them
+TEST(LayoutAutomatonTest, SectionAcceptsKeysInAnyOrder) {
+  const LayoutAutomaton automaton(LayoutGrammar::Sequence(
+      {LayoutGrammar::Key("Begin"), LayoutGrammar::AnyOrder({"A", "B", "C"}),
+       LayoutGrammar::Key("End")}));
+
+  EXPECT_TRUE(Fits(automaton, {"Begin", "C", "A", "B", "A", "End"}));
+  EXPECT_TRUE(Fits(automaton, {"Begin", "End"}));
+  EXPECT_FALSE(Fits(automaton, {"Begin", "A", "D", "End"}));
+  EXPECT_FALSE(Fits(automaton, {"Begin", "A", "End", "B"}));
+}
+
+/// @brief Tests that a repeating group is accepted only whole, and within its repetition bounds
+TEST(LayoutAutomatonTest, RepeatingGroupsHonourBounds) {
+  const LayoutAutomaton automaton(LayoutGrammar::Repeat(
+      LayoutGrammar::Sequence({LayoutGrammar::Key("X"), LayoutGrammar::Optional(
+                                                            LayoutGrammar::Key("Y"))}),
+      2, 3));
+
+  EXPECT_TRUE(Fits(automaton, {"X", "X"}));
+  EXPECT_TRUE(Fits(automaton, {"X", "Y", "X", "X", "Y"}));
+  EXPECT_FALSE(Fits(automaton, {"X"}));
+  EXPECT_FALSE(Fits(automaton, {"X", "X", "X", "X"}));
+  EXPECT_FALSE(Fits(automaton, {"X", "Y", "Y", "X"}));
+}
+
+/// @brief Tests that the error names the offending field and what was expected instead
+TEST(LayoutAutomatonTest, ReportsFirstOffendingField) {
+  const LayoutAutomaton automaton(LayoutGrammar::Sequence(
+      {LayoutGrammar::Key("A"), LayoutGrammar::Choice({LayoutGrammar::Key("B"),
+                                                       LayoutGrammar::Key("C")})}));
+  LayoutAutomaton::Workspace workspace;
+
+  const std::vector<RawField> wrong{RawField{"A", "1"}, RawField{"D", "2"}, RawField{"E", "3"}};
+  error::ErrorCollector errorCollector;
+  EXPECT_FALSE(automaton.Validate(RawData(wrong), workspace, errorCollector));
+  ASSERT_EQ(errorCollector.ErrorCount(), 1);
+  EXPECT_EQ(errorCollector.GetErrorLogs()[0].Subject(), "Layout Grammar Violation");
+  EXPECT_NE(errorCollector.GetErrorLogs()[0].Body().find("Field 'D'"), std::string::npos);
+  EXPECT_NE(errorCollector.GetErrorLogs()[0].Body().find("one of: 'B', 'C'"), std::string::npos);
+
+  const std::vector<RawField> shorter{RawField{"A", "1"}};
+  error::ErrorCollector endCollector;
+  EXPECT_FALSE(automaton.Validate(RawData(shorter), workspace, endCollector));
+  ASSERT_EQ(endCollector.ErrorCount(), 1);
+  EXPECT_NE(endCollector.GetErrorLogs()[0].Body().find("ends before"), std::string::npos);
+}
+
+/// @brief Tests that a grammar needing too many states is rejected
+TEST(LayoutAutomatonTest, ThrowsOnTooManyStates) {
+  // "An A, then exactly 16 keys" must remember which of the last 17 keys were As
+  const LayoutGrammar anyKeys = LayoutGrammar::Repeat(LayoutGrammar::AnyKey(), 0, std::nullopt);
+  const LayoutGrammar grammar = LayoutGrammar::Sequence(
+      {anyKeys, LayoutGrammar::Key("A"), LayoutGrammar::Repeat(LayoutGrammar::AnyKey(), 16, 16)});
+
+  EXPECT_THROW(LayoutAutomaton automaton(grammar), std::invalid_argument);
+}
+
+/// @brief Tests that a huge bounded repetition is rejected before its copies are built
+TEST(LayoutAutomatonTest, ThrowsOnHugeBoundedRepeat) {
+  const LayoutGrammar grammar = LayoutGrammar::Repeat(LayoutGrammar::Key("A"), 0, 1'000'000'000);
+
+  EXPECT_THROW(LayoutAutomaton automaton(grammar), std::invalid_argument);
+}
+
+/// @brief Tests that nested repetitions whose copies multiply past the bound are rejected
+TEST(LayoutAutomatonTest, ThrowsOnNestedRepeatsTooLarge) {
+  const LayoutGrammar inner = LayoutGrammar::Repeat(LayoutGrammar::Key("A"), 1000, 1000);
+  const LayoutGrammar grammar = LayoutGrammar::Repeat(inner, 1000, 1000);
+
+  EXPECT_THROW(LayoutAutomaton automaton(grammar), std::invalid_argument);
+}
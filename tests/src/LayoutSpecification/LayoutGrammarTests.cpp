@@ -0,0 +1,33 @@
+#include <datalint/LayoutSpecification/LayoutGrammar.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+using namespace datalint::layout;
+
+/// @brief Tests that the convenience factories build the repetitions they stand for
+TEST(LayoutGrammarTest, FactoriesBuildRepetitions) {
+  const LayoutGrammar block = LayoutGrammar::Block("A");
+  EXPECT_EQ(block.GetKind(), LayoutGrammar::Kind::Repeat);
+  EXPECT_EQ(block.MinCount(), 1);
+  EXPECT_FALSE(block.MaxCount().has_value());
+  ASSERT_EQ(block.Items().size(), 1);
+  EXPECT_EQ(block.Items()[0].GetKind(), LayoutGrammar::Kind::Key);
+  EXPECT_EQ(block.Items()[0].MatchedKey(), "A");
+
+  const LayoutGrammar section = LayoutGrammar::AnyOrder({"A", "B"});
+  EXPECT_EQ(section.MinCount(), 0);
+  EXPECT_EQ(section.Items()[0].GetKind(), LayoutGrammar::Kind::Choice);
+  EXPECT_EQ(section.Items()[0].Items().size(), 2);
+
+  const LayoutGrammar optional = LayoutGrammar::Optional(LayoutGrammar::AnyKey());
+  EXPECT_EQ(optional.MinCount(), 0);
+  EXPECT_EQ(optional.MaxCount(), 1);
+}
+
+/// @brief Tests that invalid grammars are rejected
+TEST(LayoutGrammarTest, ThrowsOnInvalidGrammars) {
+  EXPECT_THROW(LayoutGrammar::Choice({}), std::invalid_argument);
+  EXPECT_THROW(LayoutGrammar::AnyOrder({}), std::invalid_argument);
+  EXPECT_THROW(LayoutGrammar::Repeat(LayoutGrammar::Key("A"), 3, 2), std::invalid_argument);
+}
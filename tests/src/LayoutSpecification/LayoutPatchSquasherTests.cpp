@@ -0,0 +1,199 @@
+#include <datalint/LayoutSpecification/ExpectedField.h>
+#include <datalint/LayoutSpecification/LayoutPatch.h>
+#include <datalint/LayoutSpecification/LayoutPatchSquasher.h>
+#include <datalint/LayoutSpecification/LayoutSpecification.h>
+#include <datalint/LayoutSpecification/LayoutSpecificationBuilder.h>
+#include <datalint/Version/Version.h>
+#include <datalint/Version/VersionRange.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace datalint;
+using namespace datalint::layout;
+
+namespace {
+/// @brief Helper applying patches in order to a copy of the base specification
+LayoutSpecification ApplyAll(LayoutSpecification base, const std::vector<LayoutPatch>& patches) {
+  LayoutSpecificationBuilder builder;
+  for (const auto& patch : patches) {
+    builder.ApplyPatch(base, patch);
+  }
+  return base;
+}
+}  // namespace
+
+/// @brief Tests that an add, modify, remove, add-back history squashes to the final field
+TEST(LayoutPatchSquasherTest, CollapsesFieldHistory) {
+  const std::vector<LayoutPatch> patches{
+      LayoutPatch("1", VersionRange::All(), {AddField{"a", ExpectedField{1}}}),
+      LayoutPatch("2", VersionRange::All(),
+                  {ModifyField{"a", [](ExpectedField& field) { field.SetMaxCount(5); }}}),
+      LayoutPatch("3", VersionRange::All(), {RemoveField{"a"}, AddField{"a", ExpectedField{2}}}),
+      LayoutPatch("4", VersionRange::All(),
+                  {ModifyField{"a", [](ExpectedField& field) { field.SetMaxCount(3); }},
+                   AddField{"b", ExpectedField{0}}, RemoveField{"b"}}),
+  };
+
+  const auto squashed = LayoutPatchSquasher().Squash("squashed", VersionRange::All(), patches);
+
+  ASSERT_EQ(squashed.Operations().size(), 1);
+  const auto* add = std::get_if<AddField>(&squashed.Operations()[0]);
+  ASSERT_NE(add, nullptr);
+  EXPECT_EQ(add->Key, "a");
+  EXPECT_EQ(add->Field.MinCount(), 2);
+  EXPECT_EQ(add->Field.MaxCount(), 3);
+}
+
+/// @brief Tests that the squashed patch has the same effect on a base specification as the
+/// original patches, including removals, chained modifications and constraint order
+TEST(LayoutPatchSquasherTest, MatchesSequentialApplicationOnBase) {
+  LayoutSpecification base;
+  base.AddExpectedField("kept", ExpectedField{1});
+  base.AddExpectedField("removed", ExpectedField{1});
+  base.AddExpectedField("replaced", ExpectedField{1});
+  base.AddOrderingConstraint(FieldOrderingConstraint{"x", "y"});
+  base.AddOrderingConstraint(FieldOrderingConstraint{"y", "z"});
+
+  const std::vector<LayoutPatch> patches{
+      LayoutPatch("1", VersionRange::All(),
+                  {ModifyField{"kept", [](ExpectedField& field) { field.SetMaxCount(4); }},
+                   RemoveField{"removed"}, RemoveFieldOrdering{"x", "y"},
+                   AddFieldOrdering{"a", "b"}}),
+      LayoutPatch("2", VersionRange::All(),
+                  {ModifyField{"kept", [](ExpectedField& field) { field.SetMinCount(2); }},
+                   RemoveField{"replaced"}, AddField{"replaced", ExpectedField{0, 1}},
+                   AddFieldOrdering{"x", "y"}, RemoveFieldOrdering{"a", "b"},
+                   AddFieldOrdering{"a", "b"}}),
+  };
+
+  const auto squashed = LayoutPatchSquasher().Squash("squashed", VersionRange::All(), patches);
+  const auto expected = ApplyAll(base, patches);
+  const auto actual = ApplyAll(base, {squashed});
+
+  ASSERT_EQ(actual.Fields().size(), expected.Fields().size());
+  for (const auto& [key, field] : expected.Fields()) {
+    const auto match = actual.GetField(key);
+    ASSERT_TRUE(match.has_value()) << key;
+    EXPECT_EQ(match->MinCount(), field.MinCount()) << key;
+    EXPECT_EQ(match->MaxCount(), field.MaxCount()) << key;
+  }
+  const std::vector<FieldOrderingConstraint> expectedConstraints(
+      expected.OrderingConstraints().begin(), expected.OrderingConstraints().end());
+  const std::vector<FieldOrderingConstraint> actualConstraints(
+      actual.OrderingConstraints().begin(), actual.OrderingConstraints().end());
+  EXPECT_EQ(actualConstraints, expectedConstraints);
+}
+
+/// @brief Tests that the modifications of a base field fold into one operation that still throws
+/// where the original ones would
+TEST(LayoutPatchSquasherTest, FoldsBaseFieldModificationsIntoOneOperation) {
+  const std::vector<LayoutPatch> patches{
+      LayoutPatch("1", VersionRange::All(), {SetFieldMaxCount{"a", 4}}),
+      LayoutPatch("2", VersionRange::All(), {SetFieldCountBounds{"a", 2, 3}}),
+  };
+
+  const auto squashed = LayoutPatchSquasher().Squash("squashed", VersionRange::All(), patches);
+
+  ASSERT_EQ(squashed.Operations().size(), 1);
+  EXPECT_TRUE(std::holds_alternative<ModifyField>(squashed.Operations()[0]));
+
+  LayoutSpecification base;
+  base.AddExpectedField("a", ExpectedField{1});
+  EXPECT_EQ(ApplyAll(base, {squashed}).ContentHash(), ApplyAll(base, patches).ContentHash());
+
+  // SetFieldMaxCount{4} fails on a field with at least 5 occurrences
+  LayoutSpecification invalidBase;
+  invalidBase.AddExpectedField("a", ExpectedField{5});
+  EXPECT_THROW(ApplyAll(invalidBase, patches), std::invalid_argument);
+  EXPECT_THROW(ApplyAll(invalidBase, {squashed}), std::invalid_argument);
+}
+
+/// @brief Tests that a long history of declarative modifications of a base field squashes to a
+/// single declarative operation once the bounds are set
+TEST(LayoutPatchSquasherTest, FoldsDeclarativeHistoryIntoBounds) {
+  std::vector<LayoutPatch> patches{
+      LayoutPatch("bounds", VersionRange::All(), {SetFieldCountBounds{"a", 0, 10}})};
+  for (std::size_t i = 0; i < 100; ++i) {
+    patches.emplace_back(std::to_string(i), VersionRange::All(),
+                         std::vector<LayoutPatchOperation>{SetFieldMinCount{"a", i % 5},
+                                                           SetFieldMaxCount{"a", 5 + i % 5}});
+  }
+
+  const auto squashed = LayoutPatchSquasher().Squash("squashed", VersionRange::All(), patches);
+
+  ASSERT_EQ(squashed.Operations().size(), 1);
+  const auto& bounds = std::get<SetFieldCountBounds>(squashed.Operations()[0]);
+  EXPECT_EQ(bounds.MinCount, 4);
+  EXPECT_EQ(bounds.MaxCount, 9);
+
+  LayoutSpecification base;
+  base.AddExpectedField("a", ExpectedField{1});
+  EXPECT_EQ(ApplyAll(base, {squashed}).ContentHash(), ApplyAll(base, patches).ContentHash());
+}
+
+/// @brief Tests that a single declarative modification of a base field stays as it is
+TEST(LayoutPatchSquasherTest, KeepsSingleDeclarativeModification) {
+  const std::vector<LayoutPatch> patches{
+      LayoutPatch("1", VersionRange::All(), {SetFieldMinCount{"a", 2}}),
+  };
+
+  const auto squashed = LayoutPatchSquasher().Squash("squashed", VersionRange::All(), patches);
+
+  ASSERT_EQ(squashed.Operations().size(), 1);
+  EXPECT_EQ(std::get<SetFieldMinCount>(squashed.Operations()[0]).MinCount, 2);
+}
+
+/// @brief Tests that the history of field patterns squashes to their final state, with the same
+/// effect on a base specification
+TEST(LayoutPatchSquasherTest, CollapsesFieldPatternHistory) {
+  const std::vector<LayoutPatch> patches{
+      LayoutPatch("1", VersionRange::All(),
+                  {AddFieldPattern{"tmp_*", ExpectedField{0}}, RemoveFieldPattern{"base_*"}}),
+      LayoutPatch("2", VersionRange::All(),
+                  {RemoveFieldPattern{"tmp_*"}, AddFieldPattern{"base_*", ExpectedField{2, 3}}}),
+  };
+
+  const auto squashed = LayoutPatchSquasher().Squash("squashed", VersionRange::All(), patches);
+
+  ASSERT_EQ(squashed.Operations().size(), 2);
+  EXPECT_EQ(std::get<RemoveFieldPattern>(squashed.Operations()[0]).Pattern, "base_*");
+  EXPECT_EQ(std::get<AddFieldPattern>(squashed.Operations()[1]).Field.MinCount(), 2);
+
+  LayoutSpecification base;
+  base.AddExpectedFieldPattern("base_*", ExpectedField{1});
+  EXPECT_EQ(ApplyAll(base, {squashed}).ContentHash(), ApplyAll(base, patches).ContentHash());
+}
+
+/// @brief Tests that only the patches applying to the interval are squashed, and that a patch
+/// straddling the interval is rejected
+TEST(LayoutPatchSquasherTest, SquashesPatchesOfInterval) {
+  const auto interval = VersionRange::Between(Version{2, 0, 0}, Version{2, 9, 9});
+  const std::vector<LayoutPatch> patches{
+      LayoutPatch("old", VersionRange::Until(Version{1, 9, 9}),
+                  {AddField{"old", ExpectedField{1}}}),
+      LayoutPatch("new", VersionRange::From(Version{2, 0, 0}), {AddField{"new", ExpectedField{1}}}),
+  };
+
+  const auto squashed = LayoutPatchSquasher().Squash("2.x", interval, patches);
+  EXPECT_EQ(squashed.AppliesTo(), interval);
+  ASSERT_EQ(squashed.Operations().size(), 1);
+  EXPECT_EQ(std::get<AddField>(squashed.Operations()[0]).Key, "new");
+
+  EXPECT_THROW(LayoutPatchSquasher().Squash("all", VersionRange::All(), patches),
+               std::invalid_argument);
+}
+
+/// @brief Tests that conflicts within the patches are reported when squashing
+TEST(LayoutPatchSquasherTest, ThrowsForConflictingPatches) {
+  const std::vector<LayoutPatch> patches{
+      LayoutPatch("1", VersionRange::All(), {AddField{"a", ExpectedField{1}}, RemoveField{"a"}}),
+      LayoutPatch("2", VersionRange::All(), {RemoveField{"a"}}),
+  };
+
+  EXPECT_THROW(LayoutPatchSquasher().Squash("squashed", VersionRange::All(), patches),
+               std::logic_error);
+}
@@ -77,6 +77,33 @@ TEST(LayoutSpecificationBuilderTest, CanAddAndModifyFieldUsingPatches) {
   ASSERT_EQ(fieldOpt->MinCount(), 2);  // the modified min count
 }
 
+/// @brief Tests that the declarative set-min, set-max and set-bounds operations modify a field
+TEST(LayoutSpecificationBuilderTest, AppliesDeclarativeFieldModifications) {
+  const datalint::layout::LayoutPatch patch(
+      "patch", datalint::VersionRange::All(),
+      {datalint::layout::AddField{.Key = "Field1", .Field = datalint::layout::ExpectedField{1, 2}},
+       datalint::layout::AddField{.Key = "Field2", .Field = datalint::layout::ExpectedField{1, 2}},
+       datalint::layout::SetFieldMaxCount{.Key = "Field1", .MaxCount = std::nullopt},
+       datalint::layout::SetFieldMinCount{.Key = "Field1", .MinCount = 3},
+       datalint::layout::SetFieldCountBounds{.Key = "Field2", .MinCount = 5, .MaxCount = 6}});
+
+  datalint::layout::LayoutSpecificationBuilder builder;
+  const auto spec = builder.Build(datalint::Version{1, 0, 0}, std::span(&patch, 1));
+
+  EXPECT_EQ(spec.GetField("Field1")->MinCount(), 3);
+  EXPECT_FALSE(spec.GetField("Field1")->MaxCount().has_value());
+  EXPECT_EQ(spec.GetField("Field2")->MinCount(), 5);
+  EXPECT_EQ(spec.GetField("Field2")->MaxCount(), 6);
+
+  // Setting the min past the current max is rejected, as with the functional modification
+  const datalint::layout::LayoutPatch invalid(
+      "invalid", datalint::VersionRange::All(),
+      {datalint::layout::AddField{.Key = "Field1", .Field = datalint::layout::ExpectedField{1, 2}},
+       datalint::layout::SetFieldMinCount{.Key = "Field1", .MinCount = 3}});
+  EXPECT_THROW(builder.Build(datalint::Version{1, 0, 0}, std::span(&invalid, 1)),
+               std::invalid_argument);
+}
+
 /// @brief Tests that the layout specification builder applies patches only within the version range
 TEST(LayoutSpecificationBuilderTest, AppliesPatchesOnlyWithinVersionRange) {
   // Initialize the layout patch
@@ -179,3 +206,64 @@ TEST(LayoutSpecificationBuilderTest, ThrowsWhenRemovingNonExistingConstraint) {
   EXPECT_THROW(
       { builder.Build(datalint::Version{1, 0, 0}, std::span(&patch, 1)); }, std::logic_error);
 }
+
+/// @brief Tests that the layout specification builder throws when the ordering constraints form a
+/// cycle, which no data holding all their fields can satisfy
+TEST(LayoutSpecificationBuilderTest, ThrowsWhenConstraintsFormCycle) {
+  // Initialize the layout patch
+  const datalint::layout::LayoutPatch patch(
+      "patch1", datalint::VersionRange::All(),
+      {datalint::layout::AddFieldOrdering{.BeforeKey = "FieldA", .AfterKey = "FieldB"},
+       datalint::layout::AddFieldOrdering{.BeforeKey = "FieldB", .AfterKey = "FieldC"},
+       datalint::layout::AddFieldOrdering{.BeforeKey = "FieldC", .AfterKey = "FieldA"}});
+
+  datalint::layout::LayoutSpecificationBuilder builder;
+
+  EXPECT_THROW(
+      { builder.Build(datalint::Version{1, 0, 0}, std::span(&patch, 1)); }, std::logic_error);
+}
+
+/// @brief Tests that building with a version range index gives the same specification as testing
+/// every patch
+TEST(LayoutSpecificationBuilderTest, BuildWithIndexMatchesLinearBuild) {
+  const std::array<datalint::layout::LayoutPatch, 3> patches{
+      datalint::layout::LayoutPatch(
+          "all", datalint::VersionRange::All(),
+          {datalint::layout::AddField{"Field1", datalint::layout::ExpectedField{1}}}),
+      datalint::layout::LayoutPatch(
+          "old", datalint::VersionRange::Until(datalint::Version{1, 0, 0}),
+          {datalint::layout::AddField{"Field2", datalint::layout::ExpectedField{1}}}),
+      datalint::layout::LayoutPatch(
+          "new", datalint::VersionRange::From(datalint::Version{2, 0, 0}),
+          {datalint::layout::RemoveField{"Field1"}}),
+  };
+  const auto index = datalint::VersionRangeIndex::ForPatches(patches);
+  datalint::layout::LayoutSpecificationBuilder builder;
+
+  for (const auto& version : {datalint::Version{0, 5, 0}, datalint::Version{1, 5, 0},
+                              datalint::Version{2, 0, 0}}) {
+    const auto linear = builder.Build(version, patches);
+    const auto indexed = builder.Build(version, patches, index);
+    EXPECT_EQ(indexed.Fields().size(), linear.Fields().size());
+    EXPECT_EQ(indexed.HasField("Field1"), linear.HasField("Field1"));
+    EXPECT_EQ(indexed.HasField("Field2"), linear.HasField("Field2"));
+  }
+}
+
+/// @brief Tests that building with a version range index built over other patches throws, rather
+/// than applying the wrong patches or reading past the end of the patches
+TEST(LayoutSpecificationBuilderTest, BuildWithIndexThrowsForMismatchedIndex) {
+  const std::array<datalint::layout::LayoutPatch, 2> patches{
+      datalint::layout::LayoutPatch(
+          "first", datalint::VersionRange::All(),
+          {datalint::layout::AddField{"Field1", datalint::layout::ExpectedField{1}}}),
+      datalint::layout::LayoutPatch(
+          "second", datalint::VersionRange::All(),
+          {datalint::layout::AddField{"Field2", datalint::layout::ExpectedField{1}}}),
+  };
+  const auto index = datalint::VersionRangeIndex::ForPatches(patches);
+  datalint::layout::LayoutSpecificationBuilder builder;
+
+  EXPECT_THROW(builder.Build(datalint::Version{1, 0, 0}, std::span(patches).first(1), index),
+               std::invalid_argument);
+}
@@ -3,8 +3,11 @@
 #include <datalint/LayoutSpecification/LayoutSpecification.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <map>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 /// @brief Tests that the layout specification can initialize with valid fields
 TEST(LayoutSpecificationTest, CanInitializeWithValidFields) {
@@ -61,6 +64,48 @@ TEST(LayoutSpecificationTest, ThrowsLogicErrorWhenAddingDuplicateExpectedFields)
   EXPECT_THROW(layoutSpecification.AddExpectedField("Field1", field), std::logic_error);
 }
 
+/// @brief Tests that field patterns can be added and removed, and that duplicate, malformed or
+/// non-existent patterns are rejected
+TEST(LayoutSpecificationTest, AddsAndRemovesFieldPatterns) {
+  datalint::layout::LayoutSpecification layoutSpecification;
+  layoutSpecification.AddExpectedFieldPattern("sensor_*", datalint::layout::ExpectedField{1});
+  layoutSpecification.AddExpectedFieldPattern("channel_[0-9]+",
+                                              datalint::layout::ExpectedField{0, 4});
+
+  EXPECT_THROW(
+      layoutSpecification.AddExpectedFieldPattern("sensor_*", datalint::layout::ExpectedField{1}),
+      std::logic_error);
+  EXPECT_THROW(
+      layoutSpecification.AddExpectedFieldPattern("[abc", datalint::layout::ExpectedField{1}),
+      std::invalid_argument);
+  ASSERT_EQ(layoutSpecification.FieldPatterns().size(), 2);
+  EXPECT_FALSE(layoutSpecification.HasField("sensor_*"));
+  EXPECT_EQ(layoutSpecification.FieldPatternMatcher().Match("sensor_speed").size(), 1);
+
+  layoutSpecification.RemoveExpectedFieldPattern("sensor_*");
+  EXPECT_EQ(layoutSpecification.FieldPatterns().size(), 1);
+  EXPECT_TRUE(layoutSpecification.FieldPatternMatcher().Match("sensor_speed").empty());
+  EXPECT_EQ(layoutSpecification.FieldPatternMatcher().Match("channel_3").size(), 1);
+  EXPECT_THROW(layoutSpecification.RemoveExpectedFieldPattern("sensor_*"), std::logic_error);
+}
+
+/// @brief Tests that a pattern whose matcher would exceed the state limit is rejected when it is
+/// added, leaving the specification and its matcher unchanged
+TEST(LayoutSpecificationTest, RejectsFieldPatternsBeyondStateLimit) {
+  datalint::layout::LayoutSpecification layoutSpecification;
+  layoutSpecification.AddExpectedFieldPattern("sensor_*", datalint::layout::ExpectedField{1});
+
+  // The matcher must remember which of the last 16 characters were an 'a': 2^16 states
+  const std::string pattern = "*a" + std::string(15, '?');
+  EXPECT_THROW(
+      layoutSpecification.AddExpectedFieldPattern(pattern, datalint::layout::ExpectedField{0}),
+      std::invalid_argument);
+
+  ASSERT_EQ(layoutSpecification.FieldPatterns().size(), 1);
+  EXPECT_EQ(layoutSpecification.FieldPatternMatcher().Size(), 1);
+  EXPECT_EQ(layoutSpecification.FieldPatternMatcher().Match("sensor_speed").size(), 1);
+}
+
 /// @brief Tests that the layout specification throws logic error when removing non-existent
 /// expected fields
 TEST(LayoutSpecificationTest, ThrowsLogicErrorWhenRemovingNonExistentExpectedFields) {
@@ -106,3 +151,84 @@ TEST(LayoutSpecificationTest, ThrowsLogicErrorWhenRemovingNonExistentOrderingCon
   // Removing the non-existent constraint should throw a logic error
   EXPECT_THROW(layoutSpecification.RemoveOrderingConstraint("FieldA", "FieldB"), std::logic_error);
 }
+
+/// @brief Tests that a copied layout specification can be modified without affecting the original
+TEST(LayoutSpecificationTest, CopyIsIndependentOfOriginal) {
+  datalint::layout::LayoutSpecification original;
+  original.AddExpectedField("FieldA", datalint::layout::ExpectedField{1, std::nullopt});
+  original.AddOrderingConstraint(datalint::layout::FieldOrderingConstraint{"FieldA", "FieldB"});
+
+  datalint::layout::LayoutSpecification copy = original;
+  EXPECT_TRUE(copy.Fields().SharesRootWith(original.Fields()));
+  copy.ModifyExpectedField("FieldA", [](auto& field) { field.SetMinCount(2); });
+  copy.AddExpectedField("FieldB", datalint::layout::ExpectedField{1, std::nullopt});
+  copy.RemoveOrderingConstraint("FieldA", "FieldB");
+
+  EXPECT_EQ(original.GetField("FieldA")->MinCount(), 1);
+  EXPECT_FALSE(original.HasField("FieldB"));
+  EXPECT_EQ(original.OrderingConstraints().size(), 1);
+  EXPECT_EQ(copy.GetField("FieldA")->MinCount(), 2);
+  EXPECT_TRUE(copy.HasField("FieldB"));
+  EXPECT_TRUE(copy.OrderingConstraints().empty());
+}
+
+/// @brief Tests that the content hash depends on the fields and constraints only, not on how the
+/// specification was built
+TEST(LayoutSpecificationTest, ContentHashReflectsContent) {
+  datalint::layout::LayoutSpecification first;
+  first.AddExpectedField("FieldB", datalint::layout::ExpectedField{0, 1});
+  first.AddExpectedField("FieldA", datalint::layout::ExpectedField{1, std::nullopt});
+  first.AddOrderingConstraint(datalint::layout::FieldOrderingConstraint{"FieldA", "FieldB"});
+
+  datalint::layout::LayoutSpecification second;
+  second.AddExpectedField("FieldA", datalint::layout::ExpectedField{3, std::nullopt});
+  second.AddExpectedField("FieldB", datalint::layout::ExpectedField{0, 1});
+  second.ModifyExpectedField("FieldA", [](auto& field) { field.SetMinCount(1); });
+  second.AddOrderingConstraint(datalint::layout::FieldOrderingConstraint{"FieldA", "FieldB"});
+  EXPECT_EQ(first.ContentHash(), second.ContentHash());
+
+  second.ModifyExpectedField("FieldB", [](auto& field) { field.SetMaxCount(std::nullopt); });
+  EXPECT_NE(first.ContentHash(), second.ContentHash());
+
+  datalint::layout::LayoutSpecification reversed;
+  reversed.AddExpectedField("FieldA", datalint::layout::ExpectedField{1, std::nullopt});
+  reversed.AddExpectedField("FieldB", datalint::layout::ExpectedField{0, 1});
+  reversed.AddOrderingConstraint(datalint::layout::FieldOrderingConstraint{"FieldB", "FieldA"});
+  EXPECT_NE(first.ContentHash(), reversed.ContentHash());
+}
+
+/// @brief Tests that fields are found without copying, by string view, and that lookups follow
+/// modifications while unmodified copies keep their fields
+TEST(LayoutSpecificationTest, FindsFieldsWithoutCopying) {
+  const std::string longKey = "a field key longer than the inline capacity of small keys";
+  datalint::layout::LayoutSpecification original;
+  for (int i = 0; i < 50; ++i) {
+    original.AddExpectedField("Field" + std::to_string(i), datalint::layout::ExpectedField{1, 5});
+  }
+  original.AddExpectedField(longKey, datalint::layout::ExpectedField{0, 1});
+
+  const datalint::layout::ExpectedField* field = original.FindField(std::string_view("Field7"));
+  ASSERT_NE(field, nullptr);
+  EXPECT_EQ(field, original.FindField("Field7"));
+  EXPECT_EQ(field->MaxCount(), 5);
+  ASSERT_NE(original.FindField(longKey), nullptr);
+  EXPECT_EQ(original.FindField(longKey)->MinCount(), 0);
+  EXPECT_EQ(original.FindField("Field50"), nullptr);
+  EXPECT_EQ(original.FindField(""), nullptr);
+
+  datalint::layout::LayoutSpecification copy = original;
+  copy.RemoveExpectedField("Field7");
+  copy.ModifyExpectedField("Field8", [](auto& expected) { expected.SetMaxCount(9); });
+
+  EXPECT_EQ(copy.FindField("Field7"), nullptr);
+  EXPECT_EQ(copy.FindField("Field8")->MaxCount(), 9);
+  EXPECT_EQ(original.FindField("Field7"), field);
+  EXPECT_EQ(original.FindField("Field8")->MaxCount(), 5);
+
+  // Iteration stays in key order
+  std::vector<std::string> keys;
+  for (const auto& [key, expected] : copy.Fields()) {
+    keys.emplace_back(key);
+  }
+  EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+}
@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 
 #include <map>
+#include <stdexcept>
 #include <string>
 
 /// @brief Tests that the layout specification validator can initialize with strictness
@@ -245,3 +246,123 @@ TEST(LayoutSpecificationValidatorTest, DetectsMultipleOrderingViolations) {
   ASSERT_NE(errorLogs[0].Body().find("Field1"), std::string::npos);
   ASSERT_NE(errorLogs[0].Body().find("Field2"), std::string::npos);
 }
+
+/// @brief Tests that all kinds of errors are reported together, grouped by kind: field counts in
+/// key order, then unexpected fields in order of occurrence, then ordering violations
+TEST(LayoutSpecificationValidatorTest, ReportsAllErrorKindsInOrder) {
+  datalint::error::ErrorCollector errorCollector;
+  datalint::layout::LayoutSpecificationValidator validator{
+      datalint::layout::UnexpectedFieldStrictness::Strict};
+
+  const datalint::RawData rawData({
+      datalint::RawField{"Extra1", "x"},
+      datalint::RawField{"After", "1"},
+      datalint::RawField{"Extra2", "x"},
+      datalint::RawField{"Before", "1"},
+      datalint::RawField{"Before", "2"},
+      datalint::RawField{"Extra1", "y"},
+  });
+
+  datalint::layout::LayoutSpecification layoutSpecification;
+  layoutSpecification.AddExpectedField("Before", datalint::layout::ExpectedField{1, 1});
+  layoutSpecification.AddExpectedField("After", datalint::layout::ExpectedField{1, std::nullopt});
+  layoutSpecification.AddExpectedField("Missing", datalint::layout::ExpectedField{1});
+  layoutSpecification.AddOrderingConstraint(
+      datalint::layout::FieldOrderingConstraint{"Before", "After"});
+  layoutSpecification.AddOrderingConstraint(
+      datalint::layout::FieldOrderingConstraint{"Missing", "After"});
+
+  ASSERT_FALSE(validator.Validate(layoutSpecification, rawData, errorCollector));
+  const auto errorLogs = errorCollector.GetErrorLogs();
+  ASSERT_EQ(errorLogs.size(), 6);
+  EXPECT_EQ(errorLogs[0].Subject(), "Duplicate Field");
+  EXPECT_NE(errorLogs[0].Body().find("Before"), std::string::npos);
+  EXPECT_EQ(errorLogs[1].Subject(), "Missing Required Field");
+  EXPECT_EQ(errorLogs[2].Subject(), "Unexpected Field");
+  EXPECT_NE(errorLogs[2].Body().find("Extra1"), std::string::npos);
+  EXPECT_NE(errorLogs[3].Body().find("Extra2"), std::string::npos);
+  EXPECT_NE(errorLogs[4].Body().find("Extra1"), std::string::npos);
+  EXPECT_EQ(errorLogs[5].Subject(), "Field Ordering Violation");
+}
+
+/// @brief Tests that field patterns count the occurrences of every key they match, and that keys
+/// matching a pattern are not unexpected in strict mode
+TEST(LayoutSpecificationValidatorTest, ValidatesFieldPatterns) {
+  datalint::layout::LayoutSpecification layoutSpecification;
+  layoutSpecification.AddExpectedField("Field1", datalint::layout::ExpectedField{1, 1});
+  layoutSpecification.AddExpectedFieldPattern("sensor_*", datalint::layout::ExpectedField{1, 2});
+  layoutSpecification.AddExpectedFieldPattern("channel_[0-9]+",
+                                              datalint::layout::ExpectedField{1, std::nullopt});
+  datalint::layout::LayoutSpecificationValidator validator{
+      datalint::layout::UnexpectedFieldStrictness::Strict};
+
+  datalint::error::ErrorCollector validCollector;
+  EXPECT_TRUE(validator.Validate(layoutSpecification,
+                                 datalint::RawData({
+                                     datalint::RawField{"Field1", "1"},
+                                     datalint::RawField{"sensor_a", "1"},
+                                     datalint::RawField{"channel_1", "1"},
+                                     datalint::RawField{"channel_22", "1"},
+                                 }),
+                                 validCollector));
+
+  datalint::error::ErrorCollector errorCollector;
+  EXPECT_FALSE(validator.Validate(layoutSpecification,
+                                  datalint::RawData({
+                                      datalint::RawField{"Field1", "1"},
+                                      datalint::RawField{"sensor_a", "1"},
+                                      datalint::RawField{"sensor_b", "1"},
+                                      datalint::RawField{"sensor_a", "2"},
+                                      datalint::RawField{"channel_x", "1"},
+                                  }),
+                                  errorCollector));
+  const auto errorLogs = errorCollector.GetErrorLogs();
+  ASSERT_EQ(errorLogs.size(), 3);
+  EXPECT_EQ(errorLogs[0].Subject(), "Missing Required Field");
+  EXPECT_NE(errorLogs[0].Body().find("channel_[0-9]+"), std::string::npos);
+  EXPECT_EQ(errorLogs[1].Subject(), "Duplicate Field");
+  EXPECT_NE(errorLogs[1].Body().find("sensor_*"), std::string::npos);
+  EXPECT_EQ(errorLogs[2].Subject(), "Unexpected Field");
+  EXPECT_NE(errorLogs[2].Body().find("channel_x"), std::string::npos);
+}
+
+/// @brief Tests that a validator validating a modified specification sees the modification
+TEST(LayoutSpecificationValidatorTest, RevalidatesModifiedSpecification) {
+  datalint::layout::LayoutSpecificationValidator validator{
+      datalint::layout::UnexpectedFieldStrictness::Strict};
+  const datalint::RawData rawData({datalint::RawField{"Field1", "1"}});
+  datalint::layout::LayoutSpecification layoutSpecification;
+  layoutSpecification.AddExpectedField("Field1", datalint::layout::ExpectedField{1});
+
+  datalint::error::ErrorCollector validCollector;
+  EXPECT_TRUE(validator.Validate(layoutSpecification, rawData, validCollector));
+  EXPECT_TRUE(validator.Validate(layoutSpecification, rawData, validCollector));
+
+  layoutSpecification.AddExpectedField("Field2", datalint::layout::ExpectedField{1});
+  datalint::error::ErrorCollector errorCollector;
+  EXPECT_FALSE(validator.Validate(layoutSpecification, rawData, errorCollector));
+  ASSERT_EQ(errorCollector.ErrorCount(), 1);
+  EXPECT_EQ(errorCollector.GetErrorLogs()[0].Subject(), "Missing Required Field");
+}
+
+/// @brief Tests that a specification built by hand with an ordering cycle is rejected rather than
+/// validated
+TEST(LayoutSpecificationValidatorTest, ThrowsForOrderingCycle) {
+  datalint::layout::LayoutSpecificationValidator validator{
+      datalint::layout::UnexpectedFieldStrictness::Strict};
+  datalint::layout::LayoutSpecification layoutSpecification;
+  layoutSpecification.AddExpectedField("Field1", datalint::layout::ExpectedField{1});
+  layoutSpecification.AddExpectedField("Field2", datalint::layout::ExpectedField{1});
+  layoutSpecification.AddOrderingConstraint(
+      datalint::layout::FieldOrderingConstraint{"Field1", "Field2"});
+  layoutSpecification.AddOrderingConstraint(
+      datalint::layout::FieldOrderingConstraint{"Field2", "Field1"});
+  const datalint::RawData rawData({
+      datalint::RawField{"Field2", "1"},
+      datalint::RawField{"Field1", "1"},
+  });
+
+  datalint::error::ErrorCollector errorCollector;
+  EXPECT_THROW(validator.Validate(layoutSpecification, rawData, errorCollector), std::logic_error);
+  EXPECT_EQ(errorCollector.ErrorCount(), 0);
+}
@@ -0,0 +1,60 @@
+#include <datalint/LayoutSpecification/OrderingGraph.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace datalint::layout;
+
+/// @brief Tests that edges implied by other paths are dropped, and that ranks follow the longest
+/// chain of edges
+TEST(OrderingGraphTest, ReducesTransitiveEdgesAndRanksNodes) {
+  // Every pair of the chain 3 -> 0 -> 2, a duplicate, and 1 -> 2
+  const std::vector<OrderingGraph::Edge> edges{{3, 0}, {3, 2}, {0, 2}, {3, 2}, {1, 2}};
+  const OrderingGraph graph(5, edges);
+
+  EXPECT_EQ(graph.NodeCount(), 5);
+  EXPECT_EQ(graph.EdgeCount(), 3);
+  EXPECT_EQ(graph.Successors(3).size(), 1);
+  EXPECT_EQ(graph.Successors(3)[0], 0);
+  EXPECT_EQ(graph.Successors(0)[0], 2);
+  EXPECT_EQ(graph.Successors(1)[0], 2);
+  EXPECT_TRUE(graph.Successors(2).empty());
+  EXPECT_TRUE(graph.Successors(4).empty());
+
+  EXPECT_EQ(graph.Rank(3), 0);
+  EXPECT_EQ(graph.Rank(0), 1);
+  EXPECT_EQ(graph.Rank(1), 0);
+  EXPECT_EQ(graph.Rank(2), 2);
+  EXPECT_EQ(graph.Order().size(), 5);
+  EXPECT_EQ(std::vector(graph.Order().begin(), graph.Order().end()),
+            (std::vector<OrderingGraph::Id>{1, 3, 4, 0, 2}));
+}
+
+/// @brief Tests that a complete order over many keys reduces to a chain
+TEST(OrderingGraphTest, ReducesCompleteOrderToChain) {
+  constexpr OrderingGraph::Id kCount = 200;
+  std::vector<OrderingGraph::Edge> edges;
+  for (OrderingGraph::Id before = 0; before < kCount; ++before) {
+    for (OrderingGraph::Id after = before + 1; after < kCount; ++after) {
+      edges.push_back(OrderingGraph::Edge{before, after});
+    }
+  }
+  const OrderingGraph graph(kCount, edges);
+
+  EXPECT_EQ(graph.EdgeCount(), kCount - 1);
+  for (OrderingGraph::Id id = 0; id < kCount; ++id) {
+    EXPECT_EQ(graph.Rank(id), id);
+  }
+}
+
+/// @brief Tests that cycles are found and rejected
+TEST(OrderingGraphTest, RejectsCycles) {
+  const std::vector<OrderingGraph::Edge> edges{{0, 1}, {1, 2}, {2, 3}, {3, 1}};
+
+  EXPECT_EQ(OrderingGraph::FindCycle(4, edges), (std::vector<OrderingGraph::Id>{1, 2, 3, 1}));
+  EXPECT_THROW(OrderingGraph(4, edges), std::invalid_argument);
+  EXPECT_TRUE(OrderingGraph::FindCycle(4, std::span(edges).first(3)).empty());
+  EXPECT_EQ(OrderingGraph::FindCycle(1, std::vector<OrderingGraph::Edge>{{0, 0}}),
+            (std::vector<OrderingGraph::Id>{0, 0}));
+}
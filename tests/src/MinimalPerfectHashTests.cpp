@@ -0,0 +1,60 @@
+#include <datalint/MinimalPerfectHash.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// @brief Tests that every key maps to its own index, for sets of many sizes, small sets with one
+/// slot per key
+TEST(MinimalPerfectHashTest, MapsEachKeyToItsIndex) {
+  for (const std::size_t size : {1u, 2u, 3u, 10u, 257u, 2000u}) {
+    std::vector<std::string> storage;
+    for (std::size_t i = 0; i < size; ++i) {
+      storage.push_back("key" + std::to_string(i * 7919));
+    }
+    const std::vector<std::string_view> keys(storage.begin(), storage.end());
+
+    const datalint::MinimalPerfectHash hash(keys);
+
+    ASSERT_EQ(hash.Size(), size);
+    EXPECT_EQ(hash.SlotCount(), size);
+    for (std::uint32_t i = 0; i < size; ++i) {
+      EXPECT_EQ(hash.Index(keys[i]), i) << keys[i];
+    }
+    EXPECT_LT(hash.Index("not a key"), size);
+  }
+}
+
+/// @brief Tests that an empty set is allowed and duplicate keys are rejected
+TEST(MinimalPerfectHashTest, RejectsDuplicateKeys) {
+  EXPECT_EQ(datalint::MinimalPerfectHash().Size(), 0);
+  EXPECT_EQ(datalint::MinimalPerfectHash(std::vector<std::string_view>{}).Size(), 0);
+
+  const std::vector<std::string_view> keys{"a", "b", "a"};
+  EXPECT_THROW(datalint::MinimalPerfectHash{keys}, std::invalid_argument);
+}
+
+/// @brief Tests that a set too large to be placed with one slot per key still gets a perfect hash,
+/// over a slightly larger table
+TEST(MinimalPerfectHashTest, GrowsTableForLargeSets) {
+  constexpr std::size_t kSize = 300000;
+  std::vector<std::string> storage;
+  storage.reserve(kSize);
+  for (std::size_t i = 0; i < kSize; ++i) {
+    storage.push_back("key" + std::to_string(i));
+  }
+  const std::vector<std::string_view> keys(storage.begin(), storage.end());
+
+  const datalint::MinimalPerfectHash hash(keys);
+
+  ASSERT_EQ(hash.Size(), kSize);
+  EXPECT_GT(hash.SlotCount(), kSize);
+  for (std::uint32_t i = 0; i < kSize; ++i) {
+    ASSERT_EQ(hash.Index(keys[i]), i) << keys[i];
+  }
+  for (const std::string_view foreign : {"not a key", "key", "key300000"}) {
+    EXPECT_LT(hash.Index(foreign), kSize);
+  }
+}
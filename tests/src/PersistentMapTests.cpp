@@ -0,0 +1,80 @@
+#include <datalint/PersistentMap.h>
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+
+/// @brief Tests that entries can be inserted, found, replaced and removed
+TEST(PersistentMapTest, InsertFindAndErase) {
+  datalint::PersistentMap<std::string, int> map;
+  EXPECT_TRUE(map.empty());
+
+  EXPECT_TRUE(map.insert("b", 2));
+  EXPECT_TRUE(map.insert("a", 1));
+  EXPECT_FALSE(map.insert("a", 10));
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.find(std::string_view("a"))->second, 1);
+  EXPECT_TRUE(map.contains("b"));
+  EXPECT_FALSE(map.contains("c"));
+
+  map.insert_or_assign("a", 10);
+  EXPECT_EQ(map.find("a")->second, 10);
+
+  EXPECT_EQ(map.erase("a"), 1);
+  EXPECT_EQ(map.erase("a"), 0);
+  EXPECT_EQ(map.size(), 1);
+  EXPECT_EQ(map.find("a"), map.end());
+}
+
+/// @brief Tests that modifying a copy leaves the original unchanged, and that an unmodified copy
+/// shares the original's tree
+TEST(PersistentMapTest, CopiesAreIndependentButShared) {
+  datalint::PersistentMap<std::string, int> original;
+  original.insert("a", 1);
+  original.insert("b", 2);
+
+  datalint::PersistentMap<std::string, int> copy = original;
+  EXPECT_TRUE(copy.SharesRootWith(original));
+
+  copy.insert("c", 3);
+  copy.insert_or_assign("a", 10);
+  copy.erase("b");
+  EXPECT_FALSE(copy.SharesRootWith(original));
+
+  EXPECT_EQ(original.size(), 2);
+  EXPECT_EQ(original.find("a")->second, 1);
+  EXPECT_TRUE(original.contains("b"));
+  EXPECT_FALSE(original.contains("c"));
+  EXPECT_EQ(copy.size(), 2);
+  EXPECT_EQ(copy.find("a")->second, 10);
+}
+
+/// @brief Tests that iteration visits the entries in key order, matching a std::map under random
+/// insertions and removals
+TEST(PersistentMapTest, MatchesStdMapUnderRandomOperations) {
+  datalint::PersistentMap<int, int> map;
+  std::map<int, int> expected;
+  std::mt19937 random(42);
+
+  for (int i = 0; i < 2000; ++i) {
+    const int key = static_cast<int>(random() % 300);
+    if (random() % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    } else {
+      map.insert_or_assign(key, i);
+      expected[key] = i;
+    }
+  }
+
+  ASSERT_EQ(map.size(), expected.size());
+  auto it = map.begin();
+  for (const auto& [key, value] : expected) {
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, value);
+    ++it;
+  }
+  EXPECT_EQ(it, map.end());
+}
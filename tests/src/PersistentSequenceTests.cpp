@@ -0,0 +1,38 @@
+#include <datalint/PersistentSequence.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+/// @brief Tests that elements are kept in insertion order, including after a removal
+TEST(PersistentSequenceTest, KeepsInsertionOrder) {
+  datalint::PersistentSequence<std::string> sequence;
+  sequence.push_back("first");
+  sequence.push_back("second");
+  sequence.push_back("third");
+
+  auto second = sequence.begin();
+  ++second;
+  sequence.erase(second);
+  sequence.push_back("fourth");
+
+  const std::vector<std::string> elements(sequence.begin(), sequence.end());
+  EXPECT_EQ(elements, (std::vector<std::string>{"first", "third", "fourth"}));
+  EXPECT_EQ(sequence.size(), 3);
+}
+
+/// @brief Tests that modifying a copy leaves the original unchanged
+TEST(PersistentSequenceTest, CopiesAreIndependent) {
+  datalint::PersistentSequence<int> original;
+  original.push_back(1);
+
+  datalint::PersistentSequence<int> copy = original;
+  EXPECT_TRUE(copy.SharesRootWith(original));
+  copy.push_back(2);
+  copy.erase(copy.begin());
+
+  EXPECT_EQ(original.size(), 1);
+  EXPECT_EQ(*original.begin(), 1);
+  EXPECT_EQ(copy.size(), 1);
+  EXPECT_EQ(*copy.begin(), 2);
+}
@@ -0,0 +1,59 @@
+#include <datalint/RawDataColumns.h>
+#include <datalint/RawField.h>
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <vector>
+
+/// @brief Tests that the columns hold every field's key id, value and location
+TEST(RawDataColumnsTest, SplitsFieldsIntoColumns) {
+  const auto fields = std::vector<datalint::RawField>{
+      {"key1", "value1", {"file.csv", 1}},
+      {"key2", "", {"file.csv", 2}},
+      {"key1", "value3", {"other.csv", 7}},
+  };
+
+  const datalint::RawDataColumns columns(fields);
+
+  ASSERT_EQ(columns.Size(), 3);
+  ASSERT_EQ(columns.Keys().Size(), 2);
+
+  const auto keyIds = columns.KeyIds();
+  EXPECT_EQ(keyIds[0], keyIds[2]);
+  EXPECT_NE(keyIds[0], keyIds[1]);
+
+  EXPECT_EQ(columns.Key(0), "key1");
+  EXPECT_EQ(columns.Key(1), "key2");
+  EXPECT_EQ(columns.Value(0), "value1");
+  EXPECT_EQ(columns.Value(1), "");
+  EXPECT_EQ(columns.Value(2), "value3");
+  EXPECT_EQ(columns.Filename(0), "file.csv");
+  EXPECT_EQ(columns.Filename(2), "other.csv");
+  EXPECT_EQ(columns.Line(1), 2);
+  EXPECT_EQ(columns.Line(2), 7);
+}
+
+/// @brief Tests that empty input produces empty columns
+TEST(RawDataColumnsTest, HandlesNoFields) {
+  const datalint::RawDataColumns columns(std::vector<datalint::RawField>{});
+
+  EXPECT_EQ(columns.Size(), 0);
+  EXPECT_EQ(columns.Keys().Size(), 0);
+  EXPECT_TRUE(columns.KeyIds().empty());
+}
+
+/// @brief Tests that the key-only policy builds the key columns without copying values
+TEST(RawDataColumnsTest, BuildsKeyColumnsOnly) {
+  const auto fields = std::vector<datalint::RawField>{
+      {"key1", "value1", {"file.csv", 1}},
+      {"key1", "value2", {"file.csv", 2}},
+  };
+
+  const datalint::RawDataColumns columns(fields, std::pmr::get_default_resource(),
+                                         datalint::ColumnPolicy::KeysOnly);
+
+  EXPECT_EQ(columns.Size(), 2);
+  EXPECT_EQ(columns.Keys().Size(), 1);
+  EXPECT_EQ(columns.Key(1), "key1");
+  EXPECT_FALSE(columns.HasValues());
+}
@@ -2,6 +2,7 @@
 #include <datalint/RawField.h>
 #include <gtest/gtest.h>
 
+#include <memory_resource>
 #include <vector>
 
 /// @brief Tests that RawData can be initialized with a vector of RawField objects.
@@ -51,3 +52,115 @@ TEST(RawDataTest, CanReturnAllValuesByKey) {
   EXPECT_EQ(key1Fields[0]->Value, "value1");
   EXPECT_EQ(key1Fields[1]->Value, "value3");
 }
+
+/// @brief Tests that RawData copies its fields into the given memory resource.
+TEST(RawDataTest, CopiesFieldsIntoMemoryResource) {
+  const auto fields = std::vector<datalint::RawField>{
+      {"key1", "value1"},
+      {"key2", "value2"},
+  };
+  std::pmr::monotonic_buffer_resource arena;
+
+  const datalint::RawData rawData(fields, &arena);
+
+  EXPECT_EQ(rawData.Resource(), &arena);
+  ASSERT_EQ(rawData.Fields().size(), fields.size());
+  for (const auto& field : rawData.Fields()) {
+    EXPECT_EQ(field.Location.Filename.get_allocator().resource(), &arena);
+    EXPECT_EQ(field.Value.get_allocator().resource(), &arena);
+  }
+  EXPECT_EQ(rawData.Fields()[1].Value, "value2");
+}
+
+/// @brief Tests that RawData exposes its fields as columns over interned keys.
+TEST(RawDataTest, ExposesColumns) {
+  const auto fields = std::vector<datalint::RawField>{
+      {"key1", "value1"},
+      {"key2", "value2"},
+      {"key1", "value3"},
+  };
+
+  const datalint::RawData rawData(fields);
+
+  const auto& columns = rawData.Columns();
+  ASSERT_EQ(columns.Size(), fields.size());
+  EXPECT_EQ(columns.Keys().Size(), 2);
+  EXPECT_FALSE(columns.HasValues());
+  EXPECT_FALSE(rawData.HasKey("key3"));
+  EXPECT_TRUE(rawData.GetFieldsByKey("key3").empty());
+}
+
+/// @brief Tests that RawData copies values and locations into the columns only on request.
+TEST(RawDataTest, BuildsValueColumnsOnRequest) {
+  const auto fields = std::vector<datalint::RawField>{
+      {"key1", "value1", {"file.csv", 1}},
+      {"key2", "value2", {"file.csv", 2}},
+  };
+
+  const datalint::RawData rawData(fields, std::pmr::get_default_resource(),
+                                  datalint::KeyFilterPolicy::None, datalint::ColumnPolicy::All);
+
+  const auto& columns = rawData.Columns();
+  ASSERT_TRUE(columns.HasValues());
+  EXPECT_EQ(columns.Value(1), "value2");
+  EXPECT_EQ(columns.Line(1), 2);
+  EXPECT_EQ(columns.Filename(0), "file.csv");
+}
+
+/// @brief Tests that RawData builds a key filter on request, and that lookups stay correct.
+TEST(RawDataTest, BuildsKeyFilterOnRequest) {
+  const auto fields = std::vector<datalint::RawField>{
+      {"key1", "value1"},
+      {"key2", "value2"},
+      {"key1", "value3"},
+  };
+
+  const datalint::RawData unfiltered(fields);
+  const datalint::RawData filtered(fields, std::pmr::get_default_resource(),
+                                   datalint::KeyFilterPolicy::BloomFilter);
+
+  EXPECT_FALSE(unfiltered.KeyFilter().has_value());
+  ASSERT_TRUE(filtered.KeyFilter().has_value());
+  EXPECT_TRUE(filtered.KeyFilter()->MayContain("key1"));
+
+  EXPECT_TRUE(filtered.HasKey("key1"));
+  EXPECT_TRUE(filtered.HasKey("key2"));
+  EXPECT_FALSE(filtered.HasKey("key3"));
+  EXPECT_EQ(filtered.GetFieldsByKey("key1").size(), 2);
+  EXPECT_TRUE(filtered.GetFieldsByKey("key3").empty());
+}
+
+/// @brief Tests that looking several keys up at once returns the count, first and last index and
+/// fields of each key, in the order of the requested keys.
+TEST(RawDataTest, FindKeysReturnsOccurrencesPerKey) {
+  const auto fields = std::vector<datalint::RawField>{
+      {"key1", "value1"},
+      {"key2", "value2"},
+      {"key1", "value3"},
+      {"key3", "value4"},
+  };
+  const datalint::RawData rawData(fields);
+
+  const std::vector<datalint::SmallKey> keys{"key1", "missing", "key3", "key1"};
+  const auto occurrences = rawData.FindKeys(keys);
+
+  ASSERT_EQ(occurrences.size(), keys.size());
+  EXPECT_EQ(occurrences[0].Count, 2);
+  EXPECT_EQ(occurrences[0].FirstIndex, 0);
+  EXPECT_EQ(occurrences[0].LastIndex, 2);
+  ASSERT_EQ(occurrences[0].Fields.size(), 2);
+  EXPECT_EQ(occurrences[0].Fields[1]->Value, "value3");
+
+  EXPECT_EQ(occurrences[1].Count, 0);
+  EXPECT_FALSE(occurrences[1].FirstIndex.has_value());
+  EXPECT_FALSE(occurrences[1].LastIndex.has_value());
+  EXPECT_TRUE(occurrences[1].Fields.empty());
+
+  EXPECT_EQ(occurrences[2].Count, 1);
+  EXPECT_EQ(occurrences[2].FirstIndex, 3);
+  EXPECT_EQ(occurrences[2].LastIndex, 3);
+
+  // A repeated key gets the same occurrences
+  EXPECT_EQ(occurrences[3].Count, 2);
+  EXPECT_EQ(occurrences[3].Fields, occurrences[0].Fields);
+}
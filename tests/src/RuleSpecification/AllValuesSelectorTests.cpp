@@ -27,3 +27,21 @@ TEST(AllValuesSelectorTest, CanSelectAllValues) {
   EXPECT_EQ(selectedValues[2]->Location.Filename, "file.txt");
   EXPECT_EQ(selectedValues[2]->Location.Line, 3);
 }
+
+/// @brief Tests that selecting into scratch space appends every value after its contents
+TEST(AllValuesSelectorTest, SelectsIntoScratchSpace) {
+  datalint::fieldparser::ParsedField parsedField;
+  parsedField.Key = "TestKey";
+  parsedField.Values = {
+      {"Value1", {"file.txt", 1}},
+      {"Value2", {"file.txt", 2}},
+  };
+  datalint::rules::AllValuesSelector selector;
+  std::vector<const datalint::fieldparser::RawValue*> selected{nullptr};
+  selector.SelectInto(parsedField, selected);
+
+  ASSERT_EQ(selected.size(), 3u);
+  EXPECT_EQ(selected[0], nullptr);
+  EXPECT_EQ(selected[1], &parsedField.Values[0]);
+  EXPECT_EQ(selected[2], &parsedField.Values[1]);
+}
@@ -3,6 +3,8 @@
 #include <datalint/RuleSpecification/RuleContext.h>
 #include <gtest/gtest.h>
 
+#include <vector>
+
 using namespace datalint::rules;
 
 /// @brief Fixture for the integer in range rule tests
@@ -102,3 +104,33 @@ TEST_F(IntegerInRangeRuleTests, AcceptsBoundaryValues) {
   rule.Evaluate(MakeContext("20"), errorCollector);
   EXPECT_FALSE(errorCollector.HasErrors()) << "Max boundary (20) should be accepted";
 }
+
+/// @brief Tests that evaluating a batch of values reports the same errors, in the same order, as
+/// evaluating each value in turn
+TEST_F(IntegerInRangeRuleTests, BatchMatchesEvaluateOnEachValue) {
+  IntegerInRangeRule rule(1, 10);
+  field.Key = "TestKey";
+  std::vector<datalint::fieldparser::RawValue> values;
+  for (const char* text : {"5", "abc", "0", "10", "11", "", "-3"}) {
+    values.push_back(datalint::fieldparser::RawValue{text, {"file.txt", 1}});
+  }
+  std::vector<const datalint::fieldparser::RawValue*> valuePointers;
+  std::vector<const datalint::fieldparser::ParsedField*> fieldPointers;
+  datalint::error::ErrorCollector expected;
+  for (const auto& rawValue : values) {
+    valuePointers.push_back(&rawValue);
+    fieldPointers.push_back(&field);
+    rule.Evaluate(RuleContext{field, rawValue}, expected);
+  }
+
+  rule.EvaluateBatch(valuePointers, fieldPointers, errorCollector);
+
+  const auto expectedLogs = expected.GetErrorLogs();
+  const auto actualLogs = errorCollector.GetErrorLogs();
+  ASSERT_EQ(actualLogs.size(), 5);
+  ASSERT_EQ(actualLogs.size(), expectedLogs.size());
+  for (std::size_t i = 0; i < actualLogs.size(); ++i) {
+    EXPECT_EQ(actualLogs[i].Subject(), expectedLogs[i].Subject());
+    EXPECT_EQ(actualLogs[i].Body(), expectedLogs[i].Body());
+  }
+}
@@ -0,0 +1,28 @@
+#include <TestUtils.h>
+#include <datalint/RuleSpecification/LastValuesSelector.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using datalint::test::MakeField;
+using datalint::test::Texts;
+
+/// @brief Tests that the last values are selected in order, all of them for a shorter field
+TEST(LastValuesSelectorTest, SelectsLastValues) {
+  const auto field = MakeField(4);
+
+  EXPECT_EQ(Texts(datalint::rules::LastValuesSelector(2).Select(field)),
+            (std::vector<std::string>{"2", "3"}));
+  EXPECT_EQ(Texts(datalint::rules::LastValuesSelector(9).Select(field)),
+            (std::vector<std::string>{"0", "1", "2", "3"}));
+  EXPECT_TRUE(datalint::rules::LastValuesSelector(0).Select(field).empty());
+  EXPECT_TRUE(datalint::rules::LastValuesSelector(3).Select(MakeField(0)).empty());
+
+  std::vector<const datalint::fieldparser::RawValue*> selected;
+  datalint::rules::LastValuesSelector(1).SelectInto(field, selected);
+  ASSERT_EQ(selected.size(), 1);
+  EXPECT_EQ(selected[0], &field.Values[3]);
+  EXPECT_NE(datalint::rules::LastValuesSelector(1).ContentHash(),
+            datalint::rules::LastValuesSelector(2).ContentHash());
+}
@@ -0,0 +1,84 @@
+#include <datalint/RuleSpecification/AddFieldRulePatchOperation.h>
+#include <datalint/RuleSpecification/AllValuesSelector.h>
+#include <datalint/RuleSpecification/IntegerInRangeRule.h>
+#include <datalint/RuleSpecification/RemoveFieldRulePatchOperation.h>
+#include <datalint/RuleSpecification/RulePatch.h>
+#include <datalint/RuleSpecification/RulePatchSquasher.h>
+#include <datalint/Version/VersionRange.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace datalint;
+using namespace datalint::rules;
+
+namespace {
+/// @brief Helper creating an operation adding an integer rule on the given key
+std::unique_ptr<IRulePatchOperation> AddRule(std::string key) {
+  return std::make_unique<AddFieldRulePatchOperation>(
+      FieldRule{std::move(key), std::make_unique<IntegerInRangeRule>(0, 10),
+                std::make_unique<AllValuesSelector>()});
+}
+
+/// @brief Helper creating an operation removing the rules on the given key
+std::unique_ptr<IRulePatchOperation> RemoveRule(std::string key) {
+  return std::make_unique<RemoveFieldRulePatchOperation>(
+      [key](const FieldRule& rule) { return rule.FieldKey == key; });
+}
+
+/// @brief Helper creating a patch applying to all versions from two operations
+RulePatch MakePatch(std::unique_ptr<IRulePatchOperation> first,
+                    std::unique_ptr<IRulePatchOperation> second) {
+  std::vector<std::unique_ptr<IRulePatchOperation>> ops;
+  ops.push_back(std::move(first));
+  ops.push_back(std::move(second));
+  return RulePatch("patch", VersionRange::All(), std::move(ops));
+}
+
+/// @brief Helper returning the keys of the rules left after applying the patches to a base
+std::vector<std::string> KeysAfter(const std::vector<RulePatch>& patches) {
+  std::vector<FieldRule> rules;
+  AddRule("base1")->Apply(rules);
+  AddRule("base2")->Apply(rules);
+  for (const auto& patch : patches) {
+    patch.Apply(rules);
+  }
+  std::vector<std::string> keys;
+  for (const auto& rule : rules) {
+    keys.emplace_back(rule.FieldKey);
+  }
+  return keys;
+}
+}  // namespace
+
+/// @brief Tests that the squashed patch removes and adds the same rules as the original patches,
+/// with one removal operation and one addition per surviving rule
+TEST(RulePatchSquasherTest, MatchesSequentialApplication) {
+  std::vector<RulePatch> patches;
+  patches.push_back(MakePatch(AddRule("a"), AddRule("b")));
+  patches.push_back(MakePatch(RemoveRule("a"), RemoveRule("base1")));
+  patches.push_back(MakePatch(AddRule("a"), RemoveRule("b")));
+
+  std::vector<RulePatch> squashed;
+  squashed.push_back(RulePatchSquasher().Squash("squashed", VersionRange::All(), patches));
+
+  EXPECT_EQ(KeysAfter(squashed), KeysAfter(patches));
+  EXPECT_EQ(KeysAfter(squashed), (std::vector<std::string>{"base2", "a"}));
+  EXPECT_EQ(squashed.front().Operations().size(), 2);
+}
+
+/// @brief Tests that operations of unknown type are rejected
+TEST(RulePatchSquasherTest, ThrowsForUnknownOperation) {
+  class CustomOperation final : public IRulePatchOperation {
+   public:
+    void Apply(std::vector<FieldRule>&) const override {}
+  };
+  std::vector<RulePatch> patches;
+  patches.push_back(MakePatch(AddRule("a"), std::make_unique<CustomOperation>()));
+
+  EXPECT_THROW(RulePatchSquasher().Squash("squashed", VersionRange::All(), patches),
+               std::invalid_argument);
+}
@@ -127,3 +127,40 @@ TEST(RuleSpecificationBuilderTests, NoPatchesProducesEmptySpecification) {
 
   EXPECT_TRUE(spec.Rules().empty());
 }
+
+/// @brief Tests that building with a version range index applies only the matching patches, in
+/// order
+TEST(RuleSpecificationBuilderTests, BuildWithIndexAppliesMatchingPatchesInOrder) {
+  std::vector<RulePatch> patches;
+  for (const auto& [key, range] : {std::pair{"first", VersionRange::All()},
+                                   std::pair{"skipped", VersionRange::From({3, 0, 0})},
+                                   std::pair{"second", VersionRange::Until({2, 0, 0})}}) {
+    std::vector<std::unique_ptr<IRulePatchOperation>> ops;
+    ops.push_back(std::make_unique<TestAddRuleOperation>(key));
+    patches.push_back(MakePatch(key, range, std::move(ops)));
+  }
+  const auto index = VersionRangeIndex::ForPatches(patches);
+
+  RuleSpecificationBuilder builder;
+  const auto spec = builder.Build(Version{1, 0, 0}, patches, index);
+
+  ASSERT_EQ(spec.Rules().size(), 2);
+  EXPECT_EQ(spec.Rules()[0].FieldKey, "first");
+  EXPECT_EQ(spec.Rules()[1].FieldKey, "second");
+}
+
+/// @brief Tests that building with a version range index built over other patches throws, rather
+/// than reading past the end of the patches
+TEST(RuleSpecificationBuilderTests, BuildWithIndexThrowsForMismatchedIndex) {
+  std::vector<RulePatch> patches;
+  for (const auto* key : {"first", "second"}) {
+    std::vector<std::unique_ptr<IRulePatchOperation>> ops;
+    ops.push_back(std::make_unique<TestAddRuleOperation>(key));
+    patches.push_back(MakePatch(key, VersionRange::All(), std::move(ops)));
+  }
+  const auto index = VersionRangeIndex::ForPatches(patches);
+
+  RuleSpecificationBuilder builder;
+  EXPECT_THROW(builder.Build(Version{1, 0, 0}, std::span(patches).first(1), index),
+               std::invalid_argument);
+}
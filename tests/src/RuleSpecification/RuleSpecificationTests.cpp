@@ -2,6 +2,7 @@
 #include <datalint/RuleSpecification/FieldRule.h>
 #include <datalint/RuleSpecification/IntegerInRangeRule.h>
 #include <datalint/RuleSpecification/RuleSpecification.h>
+#include <datalint/RuleSpecification/ValueAtIndexSelector.h>
 #include <gtest/gtest.h>
 
 using namespace datalint::rules;
@@ -49,3 +50,54 @@ TEST(RuleSpecificationTests, TakesOwnershipOfRules) {
   ASSERT_EQ(spec.Rules().size(), 1);
   EXPECT_EQ(spec.Rules()[0].FieldKey, "key");
 }
+
+/// @brief Test that the distinct keys of the rules get ids in order of first rule, shared by the
+/// rules on the same key
+TEST(RuleSpecificationTests, AssignsKeyIds) {
+  std::vector<FieldRule> rules;
+  rules.push_back(MakeFieldRule("key2"));
+  rules.push_back(MakeFieldRule("key1"));
+  rules.push_back(MakeFieldRule("key2"));
+
+  const RuleSpecification spec(std::move(rules));
+
+  ASSERT_EQ(spec.KeyCount(), 2);
+  EXPECT_EQ(spec.FindKey("key2"), 0);
+  EXPECT_EQ(spec.FindKey("key1"), 1);
+  EXPECT_FALSE(spec.FindKey("key3").has_value());
+  EXPECT_EQ(spec.RuleKey(0), 0);
+  EXPECT_EQ(spec.RuleKey(1), 1);
+  EXPECT_EQ(spec.RuleKey(2), 0);
+  EXPECT_FALSE(RuleSpecification({}).FindKey("key1").has_value());
+}
+
+/// @brief Test that the content hash covers the keys, rule parameters and selectors, and is absent
+/// when a rule cannot be hashed
+TEST(RuleSpecificationTests, ContentHashReflectsRules) {
+  std::vector<FieldRule> rules;
+  rules.push_back(MakeFieldRule("key1"));
+  const RuleSpecification spec(std::move(rules));
+
+  std::vector<FieldRule> sameRules;
+  sameRules.push_back(MakeFieldRule("key1"));
+  const RuleSpecification same(std::move(sameRules));
+
+  std::vector<FieldRule> otherRange;
+  otherRange.push_back(FieldRule{"key1", std::make_unique<IntegerInRangeRule>(0, 11),
+                                 std::make_unique<AllValuesSelector>()});
+  const RuleSpecification differentRange(std::move(otherRange));
+
+  std::vector<FieldRule> otherSelector;
+  otherSelector.push_back(FieldRule{"key1", std::make_unique<IntegerInRangeRule>(0, 10),
+                                    std::make_unique<ValueAtIndexSelector>(0)});
+  const RuleSpecification differentSelector(std::move(otherSelector));
+
+  ASSERT_TRUE(spec.ContentHash().has_value());
+  EXPECT_EQ(spec.ContentHash(), same.ContentHash());
+  EXPECT_NE(spec.ContentHash(), differentRange.ContentHash());
+  EXPECT_NE(spec.ContentHash(), differentSelector.ContentHash());
+
+  std::vector<FieldRule> missingRule;
+  missingRule.push_back(FieldRule{"key1", nullptr, std::make_unique<AllValuesSelector>()});
+  EXPECT_FALSE(RuleSpecification(std::move(missingRule)).ContentHash().has_value());
+}
@@ -2,6 +2,7 @@
 #include <datalint/FieldParser/ParsedData.h>
 #include <datalint/FieldParser/ParsedField.h>
 #include <datalint/FieldParser/RawValue.h>
+#include <datalint/RuleSpecification/AllValuesSelector.h>
 #include <datalint/RuleSpecification/FieldRule.h>
 #include <datalint/RuleSpecification/IntegerInRangeRule.h>
 #include <datalint/RuleSpecification/RuleSpecification.h>
@@ -10,12 +11,34 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <string>
 #include <vector>
 
 using namespace datalint::rules;
 using namespace datalint::fieldparser;
 using namespace datalint::error;
 
+namespace {
+/// @brief Rule recording the values it is given, without overriding the batch evaluation
+class RecordingRule final : public IValueRule {
+ public:
+  /// @brief Constructor
+  /// @param seen where to record the value and field key of each evaluation
+  explicit RecordingRule(std::vector<std::string>& seen) : Seen_(seen) {}
+
+  void Evaluate(const RuleContext& ctx, ErrorCollector&) const override {
+    Seen_.push_back(std::string(ctx.Field.Key) + "=" + std::string(ctx.Value.Value));
+  }
+  std::unique_ptr<IValueRule> Clone() const override {
+    return std::make_unique<RecordingRule>(Seen_);
+  }
+
+ private:
+  /// @brief The recorded evaluations
+  std::vector<std::string>& Seen_;
+};
+}  // namespace
+
 /// @brief Fixture to test Rule Validator
 class RuleValidatorTest : public ::testing::Test {
  protected:
@@ -134,3 +157,57 @@ TEST_F(RuleValidatorTest, MultipleRulesOneFails) {
   EXPECT_FALSE(validator_.Validate(spec, data, collector));
   EXPECT_EQ(collector.GetErrorLogs().size(), 1);  // Only one error for key11
 }
+
+/// @brief Tests that errors come rule by rule, each rule's in order of its fields, whatever the
+/// order of the fields of the different keys in the data
+TEST_F(RuleValidatorTest, ReportsErrorsInRuleOrder) {
+  ParsedData data({
+      ParsedField{"key11", {RawValue{"21", {}}}},
+      ParsedField{"other", {RawValue{"99", {}}}},
+      ParsedField{"key10", {RawValue{"30", {}}}},
+      ParsedField{"key11", {RawValue{"22", {}}}},
+  });
+
+  std::vector<FieldRule> rules;
+  rules.push_back(FieldRule{"key10", std::make_unique<IntegerInRangeRule>(0, 10),
+                            std::make_unique<ValueAtIndexSelector>(0)});
+  rules.push_back(FieldRule{"missing", std::make_unique<IntegerInRangeRule>(0, 10),
+                            std::make_unique<ValueAtIndexSelector>(0)});
+  rules.push_back(FieldRule{"key11", std::make_unique<IntegerInRangeRule>(0, 20),
+                            std::make_unique<ValueAtIndexSelector>(0)});
+  rules.push_back(FieldRule{"key10", std::make_unique<IntegerInRangeRule>(0, 25),
+                            std::make_unique<ValueAtIndexSelector>(0)});
+  RuleSpecification spec(std::move(rules));
+
+  ErrorCollector collector;
+
+  EXPECT_FALSE(validator_.Validate(spec, data, collector));
+  const auto logs = collector.GetErrorLogs();
+  ASSERT_EQ(logs.size(), 5);
+  EXPECT_EQ(logs[0].Body(), "Value must be between 0 and 10");
+  EXPECT_EQ(logs[1].Subject(), "Missing required field");
+  EXPECT_EQ(logs[1].Body(), "missing");
+  EXPECT_EQ(logs[2].Body(), "Value must be between 0 and 20");
+  EXPECT_EQ(logs[3].Body(), "Value must be between 0 and 20");
+  EXPECT_EQ(logs[4].Body(), "Value must be between 0 and 25");
+}
+
+/// @brief Tests that the default batch evaluation gives every selected value of every field of the
+/// rule to Evaluate, in order, with its own field
+TEST_F(RuleValidatorTest, DefaultBatchEvaluatesEachValue) {
+  ParsedData data({
+      ParsedField{"key", {RawValue{"1", {}}, RawValue{"2", {}}}},
+      ParsedField{"other", {RawValue{"9", {}}}},
+      ParsedField{"key", {RawValue{"3", {}}}},
+  });
+  std::vector<std::string> seen;
+  std::vector<FieldRule> rules;
+  rules.push_back(FieldRule{"key", std::make_unique<RecordingRule>(seen),
+                            std::make_unique<AllValuesSelector>()});
+  RuleSpecification spec(std::move(rules));
+
+  ErrorCollector collector;
+
+  EXPECT_TRUE(validator_.Validate(spec, data, collector));
+  EXPECT_EQ(seen, (std::vector<std::string>{"key=1", "key=2", "key=3"}));
+}
@@ -0,0 +1,42 @@
+#include <TestUtils.h>
+#include <datalint/RuleSpecification/SliceSelector.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using datalint::test::MakeField;
+using datalint::test::Texts;
+
+/// @brief Tests that a slice selects the values of its range that the field has
+TEST(SliceSelectorTest, SelectsValuesOfRange) {
+  const auto field = MakeField(5);
+
+  EXPECT_EQ(Texts(datalint::rules::SliceSelector(1, 3).Select(field)),
+            (std::vector<std::string>{"1", "2"}));
+  EXPECT_EQ(Texts(datalint::rules::SliceSelector(3).Select(field)),
+            (std::vector<std::string>{"3", "4"}));
+  EXPECT_EQ(Texts(datalint::rules::SliceSelector(4, 10).Select(field)),
+            (std::vector<std::string>{"4"}));
+  EXPECT_TRUE(datalint::rules::SliceSelector(7, 9).Select(field).empty());
+  EXPECT_TRUE(datalint::rules::SliceSelector(2, 2).Select(field).empty());
+  EXPECT_THROW(datalint::rules::SliceSelector(3, 2), std::invalid_argument);
+}
+
+/// @brief Tests that selecting into scratch space appends to its contents, and that the content
+/// hash tells slices apart
+TEST(SliceSelectorTest, SelectsIntoScratchSpace) {
+  const auto field = MakeField(4);
+  std::vector<const datalint::fieldparser::RawValue*> selected;
+
+  datalint::rules::SliceSelector(0, 1).SelectInto(field, selected);
+  datalint::rules::SliceSelector(2).SelectInto(field, selected);
+
+  EXPECT_EQ(Texts(selected), (std::vector<std::string>{"0", "2", "3"}));
+  EXPECT_EQ(selected[1], &field.Values[2]);
+  EXPECT_EQ(datalint::rules::SliceSelector(1, 2).ContentHash(),
+            datalint::rules::SliceSelector(1, 2).Clone()->ContentHash());
+  EXPECT_NE(datalint::rules::SliceSelector(1, 2).ContentHash(),
+            datalint::rules::SliceSelector(1).ContentHash());
+}
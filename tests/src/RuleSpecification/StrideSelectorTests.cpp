@@ -0,0 +1,32 @@
+#include <TestUtils.h>
+#include <datalint/RuleSpecification/StrideSelector.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using datalint::test::MakeField;
+using datalint::test::Texts;
+
+/// @brief Tests that every step-th value from the start is selected, including with a step too
+/// large to add to an index
+TEST(StrideSelectorTest, SelectsEveryStepthValue) {
+  const auto field = MakeField(7);
+
+  EXPECT_EQ(Texts(datalint::rules::StrideSelector(1, 3).Select(field)),
+            (std::vector<std::string>{"1", "4"}));
+  EXPECT_EQ(Texts(datalint::rules::StrideSelector(0, 2).Select(field)),
+            (std::vector<std::string>{"0", "2", "4", "6"}));
+  const datalint::rules::StrideSelector hugeStep(2, std::numeric_limits<std::size_t>::max());
+  EXPECT_EQ(Texts(hugeStep.Select(field)), (std::vector<std::string>{"2"}));
+  EXPECT_TRUE(datalint::rules::StrideSelector(7, 1).Select(field).empty());
+  EXPECT_THROW(datalint::rules::StrideSelector(0, 0), std::invalid_argument);
+
+  std::vector<const datalint::fieldparser::RawValue*> selected;
+  datalint::rules::StrideSelector(5, 1).SelectInto(field, selected);
+  EXPECT_EQ(Texts(selected), (std::vector<std::string>{"5", "6"}));
+  EXPECT_NE(datalint::rules::StrideSelector(0, 2).ContentHash(),
+            datalint::rules::StrideSelector(2, 2).Clone()->ContentHash());
+}
@@ -33,3 +33,19 @@ TEST(ValueAtIndexSelectorTests, ReturnsEmptyVectorWhenOutOfRange) {
 
   ASSERT_EQ(selectedValues.size(), 0);
 }
+
+/// @brief Tests that selecting into scratch space appends the value at the index, if any
+TEST(ValueAtIndexSelectorTests, SelectsIntoScratchSpace) {
+  datalint::fieldparser::ParsedField parsedField;
+  parsedField.Key = "TestKey";
+  parsedField.Values = {
+      {"Value1", {"file.txt", 1}},
+      {"Value2", {"file.txt", 2}},
+  };
+  std::vector<const datalint::fieldparser::RawValue*> selected;
+  datalint::rules::ValueAtIndexSelector(1).SelectInto(parsedField, selected);
+  datalint::rules::ValueAtIndexSelector(2).SelectInto(parsedField, selected);
+
+  ASSERT_EQ(selected.size(), 1u);
+  EXPECT_EQ(selected[0], &parsedField.Values[1]);
+}
@@ -0,0 +1,106 @@
+#include <datalint/SmallKey.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <utility>
+
+/// @brief Tests that short keys are stored inline and long keys on the heap
+TEST(SmallKeyTest, StoresShortKeysInline) {
+  const datalint::SmallKey empty;
+  const datalint::SmallKey shortKey("ApplicationVersion");
+  const datalint::SmallKey longestInline(std::string(datalint::SmallKey::kInlineCapacity, 'a'));
+  const datalint::SmallKey longKey(std::string(datalint::SmallKey::kInlineCapacity + 1, 'a'));
+
+  EXPECT_TRUE(empty.IsInline());
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_TRUE(shortKey.IsInline());
+  EXPECT_EQ(shortKey.View(), "ApplicationVersion");
+  EXPECT_TRUE(longestInline.IsInline());
+  EXPECT_EQ(longestInline.Size(), datalint::SmallKey::kInlineCapacity);
+  EXPECT_FALSE(longKey.IsInline());
+  EXPECT_EQ(longKey.View(), std::string(datalint::SmallKey::kInlineCapacity + 1, 'a'));
+}
+
+/// @brief Tests equality between keys, and between keys and other string types
+TEST(SmallKeyTest, ComparesForEquality) {
+  const std::string longText(40, 'x');
+
+  EXPECT_EQ(datalint::SmallKey("key1"), datalint::SmallKey("key1"));
+  EXPECT_NE(datalint::SmallKey("key1"), datalint::SmallKey("key2"));
+  EXPECT_NE(datalint::SmallKey("key"), datalint::SmallKey("key1"));
+  EXPECT_NE(datalint::SmallKey(""), datalint::SmallKey("key1"));
+  EXPECT_EQ(datalint::SmallKey(longText), datalint::SmallKey(longText));
+  EXPECT_NE(datalint::SmallKey(longText), datalint::SmallKey(longText + "y"));
+
+  EXPECT_EQ(datalint::SmallKey("key1"), "key1");
+  EXPECT_EQ(datalint::SmallKey("key1"), std::string("key1"));
+  EXPECT_EQ(datalint::SmallKey(longText), longText);
+  EXPECT_NE(datalint::SmallKey("key1"), "key2");
+}
+
+/// @brief Tests that keys order lexicographically, like strings
+TEST(SmallKeyTest, OrdersLexicographically) {
+  EXPECT_LT(datalint::SmallKey("a"), datalint::SmallKey("b"));
+  EXPECT_LT(datalint::SmallKey("a"), datalint::SmallKey("aa"));
+  EXPECT_LT(datalint::SmallKey("a"), std::string(40, 'b'));
+  EXPECT_GT(datalint::SmallKey("b"), "a");
+}
+
+/// @brief Tests that equal keys hash equally, including through string view lookups
+TEST(SmallKeyTest, HashIsConsistentWithEquality) {
+  const std::string longText(40, 'x');
+  const datalint::SmallKeyHash hash;
+
+  EXPECT_EQ(datalint::SmallKey("key1").Hash(), datalint::SmallKey(std::string("key1")).Hash());
+  EXPECT_EQ(datalint::SmallKey(longText).Hash(), datalint::SmallKey(longText).Hash());
+  EXPECT_EQ(hash(datalint::SmallKey("key1")), hash(std::string_view("key1")));
+  EXPECT_EQ(hash(datalint::SmallKey(longText)), hash(std::string_view(longText)));
+  EXPECT_EQ(datalint::SmallKey().Hash(), datalint::SmallKey::Hash(std::string_view()));
+}
+
+/// @brief Tests that copying and moving keeps the text, for both inline and heap keys
+TEST(SmallKeyTest, CopiesAndMoves) {
+  const std::string longText(40, 'x');
+  datalint::SmallKey shortKey("key1");
+  datalint::SmallKey longKey(longText);
+
+  datalint::SmallKey shortCopy = shortKey;
+  datalint::SmallKey longCopy = longKey;
+  EXPECT_EQ(shortCopy, "key1");
+  EXPECT_EQ(longCopy, longText);
+
+  datalint::SmallKey moved = std::move(longKey);
+  EXPECT_EQ(moved, longText);
+
+  shortCopy = longCopy;
+  EXPECT_EQ(shortCopy, longText);
+  longCopy = datalint::SmallKey("key2");
+  EXPECT_EQ(longCopy, "key2");
+}
+
+/// @brief Tests that a long key is allocated from the given memory resource, and that a copy
+/// allocates from its own resource
+TEST(SmallKeyTest, AllocatesLongKeysFromResource) {
+  const std::string longText(40, 'x');
+  std::array<std::byte, 256> buffer;
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+                                            std::pmr::null_memory_resource());
+  const auto inBuffer = [&buffer](const datalint::SmallKey& key) {
+    const auto* data = reinterpret_cast<const std::byte*>(key.View().data());
+    return data >= buffer.data() && data < buffer.data() + buffer.size();
+  };
+
+  datalint::SmallKey key(longText, &arena);
+  EXPECT_EQ(key, longText);
+  EXPECT_TRUE(inBuffer(key));
+
+  const datalint::SmallKey copy = key;
+  EXPECT_EQ(copy, longText);
+  EXPECT_FALSE(inBuffer(copy));
+
+  const datalint::SmallKey moved = std::move(key);
+  EXPECT_TRUE(inBuffer(moved));
+}
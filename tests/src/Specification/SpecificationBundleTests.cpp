@@ -0,0 +1,176 @@
+#include <datalint/LayoutSpecification/ExpectedField.h>
+#include <datalint/LayoutSpecification/LayoutPatch.h>
+#include <datalint/LayoutSpecification/LayoutPatchOperations.h>
+#include <datalint/RuleSpecification/AddFieldRulePatchOperation.h>
+#include <datalint/RuleSpecification/AllValuesSelector.h>
+#include <datalint/RuleSpecification/IntegerInRangeRule.h>
+#include <datalint/RuleSpecification/RulePatch.h>
+#include <datalint/RuleSpecification/ValueAtIndexSelector.h>
+#include <datalint/Specification/SpecificationBundle.h>
+#include <datalint/Specification/VersionedSpecifications.h>
+#include <datalint/Version/Version.h>
+#include <datalint/Version/VersionRange.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace datalint;
+
+namespace {
+/// @brief Helper creating a rule patch adding an integer rule on the given key
+rules::RulePatch MakeRulePatch(std::string key, std::unique_ptr<rules::IValueSelector> selector,
+                               VersionRange range) {
+  std::vector<std::unique_ptr<rules::IRulePatchOperation>> ops;
+  ops.push_back(std::make_unique<rules::AddFieldRulePatchOperation>(rules::FieldRule{
+      std::move(key), std::make_unique<rules::IntegerInRangeRule>(-5, 10), std::move(selector)}));
+  return rules::RulePatch("rules", range, std::move(ops));
+}
+
+/// @brief Value rule a bundle cannot hold
+class OpaqueRule final : public rules::IValueRule {
+ public:
+  void Evaluate(const rules::RuleContext&, error::ErrorCollector&) const override {}
+  std::unique_ptr<rules::IValueRule> Clone() const override {
+    return std::make_unique<OpaqueRule>();
+  }
+};
+}  // namespace
+
+/// @brief Tests that a loaded bundle gives every version the same specifications as compiling the
+/// patches
+TEST(SpecificationBundleTest, RoundTripsSpecificationsOfEachInterval) {
+  const std::vector<layout::LayoutPatch> layoutPatches{
+      layout::LayoutPatch("base", VersionRange::All(),
+                          {layout::AddField{"a", layout::ExpectedField{1, std::nullopt}},
+                           layout::AddField{"a key longer than the inline capacity of keys",
+                                            layout::ExpectedField{0, 3}},
+                           layout::AddFieldPattern{"sensor_[0-9]+", layout::ExpectedField{1, 2}},
+                           layout::AddFieldOrdering{"a", "b"}}),
+      layout::LayoutPatch("v2", VersionRange::From(Version{2, 0, 0}),
+                          {layout::AddField{"b", layout::ExpectedField{2, 2}},
+                           layout::SetFieldMaxCount{"a", 4}}),
+      layout::LayoutPatch("v3", VersionRange::Between(Version{3, 0, 0}, Version{3, 1, 5}),
+                          {layout::RemoveField{"a"}}),
+  };
+  std::vector<rules::RulePatch> rulePatches;
+  rulePatches.push_back(MakeRulePatch("a", std::make_unique<rules::AllValuesSelector>(),
+                                      VersionRange::All()));
+  rulePatches.push_back(MakeRulePatch("b", std::make_unique<rules::ValueAtIndexSelector>(2),
+                                      VersionRange::From(Version{2, 0, 0})));
+  const VersionedSpecifications specifications(layoutPatches, rulePatches);
+
+  const std::string path = "RoundTripsSpecificationsOfEachInterval.dlspec";
+  SpecificationBundle::Write(specifications, path);
+  const auto bundle = SpecificationBundle::Load(path);
+
+  EXPECT_EQ(bundle.IntervalCount(), specifications.IntervalCount());
+  EXPECT_EQ(bundle.SpecificationCount(), specifications.SpecificationCount());
+  for (const Version version : {Version{0, 0, 0}, Version{1, 9, 9}, Version{2, 0, 0},
+                                Version{3, 1, 5}, Version{3, 1, 6}, Version{9, 0, 0}}) {
+    const auto& expected = specifications.Find(version);
+    const auto actual = bundle.Find(version);
+    EXPECT_EQ(actual.Layout.ContentHash(), expected->Layout.ContentHash());
+    ASSERT_TRUE(actual.Rules.ContentHash().has_value());
+    EXPECT_EQ(actual.Rules.ContentHash(), expected->Rules.ContentHash());
+  }
+  EXPECT_EQ(bundle.Find(Version{2, 5, 0}).Layout.GetField("a")->MaxCount(), 4);
+  EXPECT_EQ(bundle.Find(Version{2, 5, 0}).Layout.FieldPatterns().size(), 1);
+
+  std::remove(path.c_str());
+}
+
+/// @brief Tests that a file that is not a bundle, or a truncated bundle, is rejected on load
+TEST(SpecificationBundleTest, RejectsInvalidFiles) {
+  const std::string path = "RejectsInvalidFiles.dlspec";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << std::string(256, 'x');
+  }
+  EXPECT_THROW(SpecificationBundle::Load(path), std::runtime_error);
+
+  const VersionedSpecifications specifications(
+      std::vector<layout::LayoutPatch>{layout::LayoutPatch(
+          "base", VersionRange::All(), {layout::AddField{"a", layout::ExpectedField{1}}})},
+      std::vector<rules::RulePatch>{});
+  SpecificationBundle::Write(specifications, path);
+  std::string content;
+  {
+    std::ifstream file(path, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(content.data(), static_cast<std::streamsize>(content.size() - 8));
+  }
+  EXPECT_THROW(SpecificationBundle::Load(path), std::runtime_error);
+  EXPECT_THROW(SpecificationBundle::Load("MissingBundle.dlspec"), std::runtime_error);
+
+  std::remove(path.c_str());
+}
+
+/// @brief Tests that a bundle whose specification records a built specification cannot hold is
+/// rejected on load rather than on lookup
+TEST(SpecificationBundleTest, RejectsCorruptedSpecificationRecords) {
+  const VersionedSpecifications specifications(
+      std::vector<layout::LayoutPatch>{layout::LayoutPatch(
+          "base", VersionRange::All(),
+          {layout::AddField{"a", layout::ExpectedField{1}},
+           layout::AddField{"b", layout::ExpectedField{1}},
+           layout::AddField{"c", layout::ExpectedField{1}}, layout::AddFieldOrdering{"a", "b"},
+           layout::AddFieldOrdering{"b", "c"}})},
+      std::vector<rules::RulePatch>{});
+  const std::string path = "RejectsCorruptedSpecificationRecords.dlspec";
+  SpecificationBundle::Write(specifications, path);
+  std::string content;
+  {
+    std::ifstream file(path, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  ASSERT_NO_THROW(SpecificationBundle::Load(path));
+
+  // Keys a, b and c are interned in this order, so the constraints are the key index pairs (0, 1)
+  // and (1, 2), in native byte order
+  auto indices = [](std::vector<std::uint32_t> values) {
+    return std::string(reinterpret_cast<const char*>(values.data()),
+                       values.size() * sizeof(std::uint32_t));
+  };
+  const std::string constraints = indices({0, 1, 1, 2});
+  ASSERT_EQ(content.find(constraints), content.rfind(constraints));
+  auto loadCorrupted = [&](const std::string& from, const std::string& to) {
+    std::string corrupted = content;
+    corrupted.replace(corrupted.find(from), from.size(), to);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(corrupted.data(), static_cast<std::streamsize>(corrupted.size()));
+    file.close();
+    return SpecificationBundle::Load(path);
+  };
+
+  // Two keys with the same text make duplicate fields
+  EXPECT_THROW(loadCorrupted("abc", "aac"), std::runtime_error);
+  // Duplicate ordering constraints
+  EXPECT_THROW(loadCorrupted(constraints, indices({0, 1, 0, 1})), std::runtime_error);
+  // Ordering constraints a -> b -> a
+  EXPECT_THROW(loadCorrupted(constraints, indices({0, 1, 1, 0})), std::runtime_error);
+
+  std::remove(path.c_str());
+}
+
+/// @brief Tests that writing a rule whose parameters a bundle cannot hold is rejected
+TEST(SpecificationBundleTest, RejectsUnsupportedRules) {
+  std::vector<std::unique_ptr<rules::IRulePatchOperation>> ops;
+  ops.push_back(std::make_unique<rules::AddFieldRulePatchOperation>(rules::FieldRule{
+      "a", std::make_unique<OpaqueRule>(), std::make_unique<rules::AllValuesSelector>()}));
+  std::vector<rules::RulePatch> rulePatches;
+  rulePatches.push_back(rules::RulePatch("rules", VersionRange::All(), std::move(ops)));
+  const VersionedSpecifications specifications({}, rulePatches);
+
+  EXPECT_THROW(SpecificationBundle::Write(specifications, "RejectsUnsupportedRules.dlspec"),
+               std::invalid_argument);
+  std::remove("RejectsUnsupportedRules.dlspec");
+}
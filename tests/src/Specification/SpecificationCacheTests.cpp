@@ -0,0 +1,118 @@
+#include <datalint/ApplicationDescriptor/ApplicationDescriptor.h>
+#include <datalint/LayoutSpecification/ExpectedField.h>
+#include <datalint/Specification/CompiledSpecification.h>
+#include <datalint/Specification/SpecificationCache.h>
+#include <datalint/Version/Version.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+/// @brief Build a specification with one expected field, counting the builds
+datalint::CompiledSpecification BuildCounted(const datalint::ApplicationDescriptor& descriptor,
+                                             std::atomic<int>& builds) {
+  ++builds;
+  datalint::CompiledSpecification specification{{}, datalint::rules::RuleSpecification({})};
+  specification.Layout.AddExpectedField(descriptor.Name(),
+                                        datalint::layout::ExpectedField{1, std::nullopt});
+  return specification;
+}
+}  // namespace
+
+/// @brief Tests that a version is built once and then served from the cache
+TEST(SpecificationCacheTest, BuildsEachVersionOnce) {
+  datalint::SpecificationCache cache(1 << 20);
+  std::atomic<int> builds = 0;
+  const auto build = [&builds](const auto& descriptor) { return BuildCounted(descriptor, builds); };
+  const datalint::ApplicationDescriptor app1{"app", datalint::Version{1, 0, 0}};
+  const datalint::ApplicationDescriptor app2{"app", datalint::Version{2, 0, 0}};
+
+  EXPECT_EQ(cache.Find(app1), nullptr);
+  const auto first = cache.GetOrBuild(app1, build);
+  const auto second = cache.GetOrBuild(app1, build);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(cache.Find(app1), first);
+  EXPECT_EQ(builds, 1);
+
+  cache.GetOrBuild(app2, build);
+  EXPECT_EQ(builds, 2);
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_GT(cache.MemoryUsage(), 0);
+
+  cache.Clear();
+  EXPECT_EQ(cache.Size(), 0);
+  EXPECT_EQ(cache.MemoryUsage(), 0);
+  // Specifications handed out before survive the clear
+  EXPECT_TRUE(first->Layout.HasField("app"));
+}
+
+/// @brief Tests that the least recently used version is evicted once over the memory budget
+TEST(SpecificationCacheTest, EvictsLeastRecentlyUsedOverBudget) {
+  std::atomic<int> builds = 0;
+  const auto build = [&builds](const auto& descriptor) { return BuildCounted(descriptor, builds); };
+  const datalint::ApplicationDescriptor app1{"app", datalint::Version{1, 0, 0}};
+  const datalint::ApplicationDescriptor app2{"app", datalint::Version{2, 0, 0}};
+  const datalint::ApplicationDescriptor app3{"app", datalint::Version{3, 0, 0}};
+
+  // Room for exactly two specifications
+  const std::size_t bytes = BuildCounted(app1, builds).ApproximateMemoryUsage();
+  datalint::SpecificationCache cache(2 * bytes);
+
+  cache.GetOrBuild(app1, build);
+  cache.GetOrBuild(app2, build);
+  cache.GetOrBuild(app1, build);  // app2 is now the least recently used
+  cache.GetOrBuild(app3, build);
+
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_LE(cache.MemoryUsage(), cache.MaxBytes());
+  EXPECT_NE(cache.Find(app1), nullptr);
+  EXPECT_EQ(cache.Find(app2), nullptr);
+  EXPECT_NE(cache.Find(app3), nullptr);
+}
+
+/// @brief Tests that concurrent requests for the same version share a single build
+TEST(SpecificationCacheTest, ConcurrentMissesBuildOnce) {
+  datalint::SpecificationCache cache(1 << 20);
+  std::atomic<int> builds = 0;
+  const auto build = [&builds](const auto& descriptor) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return BuildCounted(descriptor, builds);
+  };
+  const datalint::ApplicationDescriptor app{"app", datalint::Version{1, 0, 0}};
+
+  std::vector<std::shared_ptr<const datalint::CompiledSpecification>> results(8);
+  std::vector<std::thread> threads;
+  for (auto& result : results) {
+    threads.emplace_back(
+        [&cache, &app, &build, &result]() { result = cache.GetOrBuild(app, build); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(builds, 1);
+  for (const auto& result : results) {
+    EXPECT_EQ(result, results.front());
+  }
+}
+
+/// @brief Tests that a failing build is reported to the caller and not cached
+TEST(SpecificationCacheTest, FailedBuildIsNotCached) {
+  datalint::SpecificationCache cache(1 << 20);
+  const datalint::ApplicationDescriptor app{"app", datalint::Version{1, 0, 0}};
+  const auto failing = [](const auto&) -> datalint::CompiledSpecification {
+    throw std::runtime_error("build failed");
+  };
+
+  EXPECT_THROW(cache.GetOrBuild(app, failing), std::runtime_error);
+  EXPECT_EQ(cache.Size(), 0);
+
+  std::atomic<int> builds = 0;
+  cache.GetOrBuild(app,
+                   [&builds](const auto& descriptor) { return BuildCounted(descriptor, builds); });
+  EXPECT_EQ(builds, 1);
+}
@@ -0,0 +1,131 @@
+#include <datalint/LayoutSpecification/ExpectedField.h>
+#include <datalint/LayoutSpecification/LayoutPatch.h>
+#include <datalint/LayoutSpecification/LayoutPatchOperations.h>
+#include <datalint/RuleSpecification/AddFieldRulePatchOperation.h>
+#include <datalint/RuleSpecification/AllValuesSelector.h>
+#include <datalint/RuleSpecification/IntegerInRangeRule.h>
+#include <datalint/RuleSpecification/RulePatch.h>
+#include <datalint/Specification/VersionedSpecifications.h>
+#include <datalint/Version/Version.h>
+#include <datalint/Version/VersionRange.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace datalint;
+
+namespace {
+/// @brief Helper creating a rule patch adding an integer rule on the given key
+rules::RulePatch MakeRulePatch(std::string key, VersionRange range) {
+  std::vector<std::unique_ptr<rules::IRulePatchOperation>> ops;
+  ops.push_back(std::make_unique<rules::AddFieldRulePatchOperation>(
+      rules::FieldRule{std::move(key), std::make_unique<rules::IntegerInRangeRule>(0, 10),
+                       std::make_unique<rules::AllValuesSelector>()}));
+  return rules::RulePatch("rules", range, std::move(ops));
+}
+}  // namespace
+
+/// @brief Tests that each version gets the specification built from its applicable patches
+TEST(VersionedSpecificationsTest, FindsSpecificationOfEachVersion) {
+  const std::vector<layout::LayoutPatch> layoutPatches{
+      layout::LayoutPatch("base", VersionRange::All(),
+                          {layout::AddField{"a", layout::ExpectedField{1, std::nullopt}}}),
+      layout::LayoutPatch("v2", VersionRange::From(Version{2, 0, 0}),
+                          {layout::AddField{"b", layout::ExpectedField{1, std::nullopt}}}),
+      layout::LayoutPatch("v3", VersionRange::Between(Version{3, 0, 0}, Version{3, 1, 5}),
+                          {layout::RemoveField{"a"}}),
+  };
+  std::vector<rules::RulePatch> rulePatches;
+  rulePatches.push_back(MakeRulePatch("b", VersionRange::From(Version{2, 0, 0})));
+
+  const VersionedSpecifications specifications(layoutPatches, rulePatches);
+
+  const auto& v1 = specifications.Find(Version{1, 9, 9});
+  EXPECT_TRUE(v1->Layout.HasField("a"));
+  EXPECT_FALSE(v1->Layout.HasField("b"));
+  EXPECT_TRUE(v1->Rules.Rules().empty());
+
+  const auto& v2 = specifications.Find(Version{2, 0, 0});
+  EXPECT_TRUE(v2->Layout.HasField("a"));
+  EXPECT_TRUE(v2->Layout.HasField("b"));
+  ASSERT_EQ(v2->Rules.Rules().size(), 1);
+
+  const auto& v3 = specifications.Find(Version{3, 1, 5});
+  EXPECT_FALSE(v3->Layout.HasField("a"));
+  EXPECT_TRUE(v3->Layout.HasField("b"));
+
+  // The range end is inclusive: 3.1.6 is back to the 2.x specification
+  EXPECT_EQ(specifications.Find(Version{3, 1, 6}), v2);
+  EXPECT_EQ(specifications.Find(Version{0, 0, 0}), v1);
+}
+
+/// @brief Tests that intervals with the same applicable patches share one specification
+TEST(VersionedSpecificationsTest, BuildsEachDistinctSpecificationOnce) {
+  const std::vector<layout::LayoutPatch> layoutPatches{
+      layout::LayoutPatch("base", VersionRange::All(),
+                          {layout::AddField{"a", layout::ExpectedField{1, std::nullopt}}}),
+      layout::LayoutPatch("1.x", VersionRange::Between(Version{1, 0, 0}, Version{1, 9, 9}),
+                          {layout::AddField{"b", layout::ExpectedField{1, std::nullopt}}}),
+      layout::LayoutPatch("1.x too", VersionRange::Between(Version{1, 0, 0}, Version{1, 9, 9}),
+                          {layout::AddField{"c", layout::ExpectedField{1, std::nullopt}}}),
+  };
+
+  const VersionedSpecifications specifications(layoutPatches, {});
+
+  // Before 1.0.0, 1.x, and after 1.x: the first and the last have the same patches
+  EXPECT_EQ(specifications.IntervalCount(), 3);
+  EXPECT_EQ(specifications.SpecificationCount(), 2);
+  EXPECT_EQ(specifications.Find(Version{0, 1, 0}), specifications.Find(Version{2, 0, 0}));
+  EXPECT_EQ(specifications.Find(Version{1, 5, 0})->Layout.Fields().size(), 3);
+}
+
+/// @brief Tests that the layout of an interval resumes from the layout of the previous interval
+TEST(VersionedSpecificationsTest, ReplaysOnlyPatchesPastCommonPrefix) {
+  const std::vector<layout::LayoutPatch> layoutPatches{
+      layout::LayoutPatch("base", VersionRange::All(),
+                          {layout::AddField{"a", layout::ExpectedField{1, std::nullopt}}}),
+      layout::LayoutPatch("1.x", VersionRange::Until(Version{1, 9, 9}),
+                          {layout::AddField{"b", layout::ExpectedField{1, std::nullopt}}}),
+      layout::LayoutPatch("2.x", VersionRange::From(Version{2, 0, 0}),
+                          {layout::ModifyField{"a", [](auto& field) { field.SetMinCount(2); }}}),
+  };
+
+  const VersionedSpecifications specifications(layoutPatches, {});
+
+  const auto& v1 = specifications.Find(Version{1, 0, 0})->Layout;
+  const auto& v2 = specifications.Find(Version{2, 0, 0})->Layout;
+  EXPECT_TRUE(v1.HasField("b"));
+  EXPECT_EQ(v1.GetField("a")->MinCount(), 1);
+  EXPECT_FALSE(v2.HasField("b"));
+  EXPECT_EQ(v2.GetField("a")->MinCount(), 2);
+}
+
+/// @brief Tests that the layout of every version is checked for ordering cycles like Build checks
+/// it, while a cycle an intermediate patch forms and a later patch breaks is allowed
+TEST(VersionedSpecificationsTest, ThrowsWhenSomeLayoutHasOrderingCycle) {
+  const std::vector<layout::LayoutPatch> brokenThenFixed{
+      layout::LayoutPatch("base", VersionRange::All(),
+                          {layout::AddFieldOrdering{.BeforeKey = "a", .AfterKey = "b"}}),
+      layout::LayoutPatch("cycle", VersionRange::All(),
+                          {layout::AddFieldOrdering{.BeforeKey = "b", .AfterKey = "a"}}),
+      layout::LayoutPatch("fix", VersionRange::All(),
+                          {layout::RemoveFieldOrdering{.BeforeKey = "a", .AfterKey = "b"}}),
+  };
+  EXPECT_NO_THROW(VersionedSpecifications(brokenThenFixed, {}));
+
+  const std::vector<layout::LayoutPatch> brokenFrom2{
+      layout::LayoutPatch("base", VersionRange::All(),
+                          {layout::AddFieldOrdering{.BeforeKey = "a", .AfterKey = "b"}}),
+      layout::LayoutPatch("2.x", VersionRange::From(Version{2, 0, 0}),
+                          {layout::AddFieldOrdering{.BeforeKey = "b", .AfterKey = "a"}}),
+  };
+  try {
+    VersionedSpecifications specifications(brokenFrom2, {});
+    FAIL() << "Expected std::logic_error";
+  } catch (const std::logic_error& error) {
+    EXPECT_NE(std::string(error.what()).find("a -> b -> a"), std::string::npos) << error.what();
+  }
+}
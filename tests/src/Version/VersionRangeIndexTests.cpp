@@ -0,0 +1,73 @@
+#include <datalint/Version/Version.h>
+#include <datalint/Version/VersionRange.h>
+#include <datalint/Version/VersionRangeIndex.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+/// @brief Tests that the index returns the positions of the ranges containing a version, in order
+TEST(VersionRangeIndexTest, FindsContainingRangesInOrder) {
+  const std::vector<datalint::VersionRange> ranges{
+      datalint::VersionRange::All(),
+      datalint::VersionRange::From(datalint::Version{2, 0, 0}),
+      datalint::VersionRange::Until(datalint::Version{1, 5, 0}),
+      datalint::VersionRange::Between(datalint::Version{1, 0, 0}, datalint::Version{2, 0, 0}),
+  };
+  const datalint::VersionRangeIndex index(ranges);
+
+  EXPECT_EQ(index.Size(), 4);
+  EXPECT_EQ(index.Find(datalint::Version{0, 1, 0}), (std::vector<std::size_t>{0, 2}));
+  EXPECT_EQ(index.Find(datalint::Version{1, 5, 0}), (std::vector<std::size_t>{0, 2, 3}));
+  EXPECT_EQ(index.Find(datalint::Version{1, 5, 1}), (std::vector<std::size_t>{0, 3}));
+  EXPECT_EQ(index.Find(datalint::Version{2, 0, 0}), (std::vector<std::size_t>{0, 1, 3}));
+  EXPECT_EQ(index.Find(datalint::Version{9, 0, 0}), (std::vector<std::size_t>{0, 1}));
+}
+
+/// @brief Tests that the index agrees with testing every range, for random ranges and versions
+TEST(VersionRangeIndexTest, MatchesLinearScan) {
+  std::mt19937 random(7);
+  const auto randomVersion = [&random]() {
+    return datalint::Version{static_cast<int>(random() % 4), static_cast<int>(random() % 4),
+                             static_cast<int>(random() % 4)};
+  };
+
+  std::vector<datalint::VersionRange> ranges;
+  for (int i = 0; i < 200; ++i) {
+    auto a = randomVersion();
+    auto b = randomVersion();
+    if (b < a) {
+      std::swap(a, b);
+    }
+    switch (random() % 4) {
+      case 0:
+        ranges.push_back(datalint::VersionRange::From(a));
+        break;
+      case 1:
+        ranges.push_back(datalint::VersionRange::Until(b));
+        break;
+      case 2:
+        ranges.push_back(datalint::VersionRange::All());
+        break;
+      default:
+        ranges.push_back(datalint::VersionRange::Between(a, b));
+        break;
+    }
+  }
+  const datalint::VersionRangeIndex index(ranges);
+
+  for (int major = 0; major < 5; ++major) {
+    for (int minor = 0; minor < 5; ++minor) {
+      for (int patch = 0; patch < 5; ++patch) {
+        const datalint::Version version{major, minor, patch};
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < ranges.size(); ++i) {
+          if (ranges[i].Contains(version)) {
+            expected.push_back(i);
+          }
+        }
+        EXPECT_EQ(index.Find(version), expected);
+      }
+    }
+  }
+}
@@ -132,3 +132,63 @@ TEST(VersionTest, ParseThrowsForNegativeComponents) {
   EXPECT_THROW(datalint::Version::Parse("1.-2.3"), std::invalid_argument);
   EXPECT_THROW(datalint::Version::Parse("1.2.-3"), std::invalid_argument);
 }
+
+/// @brief Tests that TryParse returns the version for a valid string and the reason otherwise,
+/// without throwing
+TEST(VersionTest, TryParseReturnsVersionOrError) {
+  const auto parsed = datalint::Version::TryParse("1.2.3");
+  ASSERT_TRUE(parsed.has_value());
+  EXPECT_EQ(*parsed, (datalint::Version{1, 2, 3}));
+
+  EXPECT_EQ(datalint::Version::TryParse("1.2").error(), datalint::VersionParseError::InvalidFormat);
+  EXPECT_EQ(datalint::Version::TryParse("1..3").error(),
+            datalint::VersionParseError::EmptyComponent);
+  EXPECT_EQ(datalint::Version::TryParse("1.2.3.4").error(),
+            datalint::VersionParseError::InvalidComponent);
+  EXPECT_EQ(datalint::Version::TryParse("1.-2.3").error(),
+            datalint::VersionParseError::NegativeComponent);
+  EXPECT_EQ(datalint::Version::TryParse("1.2.99999999999").error(),
+            datalint::VersionParseError::ComponentOutOfRange);
+  EXPECT_THROW(datalint::Version::TryParse("abc").value(), std::invalid_argument);
+}
+
+/// @brief Tests that version literals can be parsed and compared at compile time
+TEST(VersionTest, ParseIsConstexpr) {
+  constexpr datalint::Version v = datalint::Version::Parse("4.5.6");
+  static_assert(v.Major() == 4 && v.Minor() == 5 && v.Patch() == 6);
+  static_assert(datalint::Version::Parse("1.10.0") > datalint::Version::Parse("1.9.99"));
+  static_assert(!datalint::Version::TryParse("1.2.x").has_value());
+  EXPECT_EQ(v, (datalint::Version{4, 5, 6}));
+}
+
+/// @brief Tests that the packed representation round-trips and orders like the versions
+TEST(VersionTest, PackedRepresentationPreservesOrdering) {
+  const datalint::Version max{datalint::Version::kMaxComponent, datalint::Version::kMaxComponent,
+                              datalint::Version::kMaxComponent};
+  EXPECT_EQ(datalint::Version::FromPacked(max.Packed()), max);
+  EXPECT_LT((datalint::Version{1, 9, 9}).Packed(), (datalint::Version{2, 0, 0}).Packed());
+  EXPECT_LT((datalint::Version{1, 2, 3}).Packed(), (datalint::Version{1, 2, 10}).Packed());
+  EXPECT_THROW(datalint::Version(datalint::Version::kMaxComponent + 1, 0, 0),
+               std::invalid_argument);
+}
+
+/// @brief Tests that components are accepted up to kMaxComponent and rejected above it, and that a
+/// negative zero reads as zero
+TEST(VersionTest, ParseAcceptsComponentsUpToMax) {
+  const auto max = std::to_string(datalint::Version::kMaxComponent);
+  const auto aboveMax = std::to_string(datalint::Version::kMaxComponent + 1);
+
+  EXPECT_EQ(datalint::Version::Parse(max + ".0." + max),
+            (datalint::Version{datalint::Version::kMaxComponent, 0,
+                               datalint::Version::kMaxComponent}));
+  EXPECT_EQ(datalint::Version::TryParse(aboveMax + ".0.0").error(),
+            datalint::VersionParseError::ComponentOutOfRange);
+  EXPECT_EQ(datalint::Version::TryParse("1." + aboveMax + ".0").error(),
+            datalint::VersionParseError::ComponentOutOfRange);
+  EXPECT_EQ(datalint::Version::TryParse("20240101.0.0").error(),
+            datalint::VersionParseError::ComponentOutOfRange);
+
+  EXPECT_EQ(datalint::Version::Parse("-0.1.-00"), (datalint::Version{0, 1, 0}));
+  EXPECT_EQ(datalint::Version::TryParse("1.-.0").error(),
+            datalint::VersionParseError::InvalidComponent);
+}